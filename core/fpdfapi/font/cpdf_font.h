@@ -44,6 +44,7 @@ class CPDF_Font : public Retainable, public Observable {
     virtual CFX_FloatRect CalcBoundingBox() const = 0;
     virtual Optional<std::pair<RetainPtr<CFX_DIBitmap>, CFX_Matrix>>
     GetBitmapAndMatrixFromSoleImageOfForm() const = 0;
+    virtual bool IsSoleImageOfFormAnInlineMask() const = 0;
   };
 
   // Callback mechanism for Type3 fonts to get new forms from upper layers.
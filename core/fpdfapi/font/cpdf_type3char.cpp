@@ -8,6 +8,7 @@
 
 #include <utility>
 
+#include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fxcrt/fx_system.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
 #include "core/fxge/dib/fx_dib.h"
@@ -44,6 +45,7 @@ bool CPDF_Type3Char::LoadBitmapFromSoleImageOfForm() {
     return false;
 
   std::tie(m_pBitmap, m_ImageMatrix) = result.value();
+  m_bBitmapIsInlineMask = m_pForm->IsSoleImageOfFormAnInlineMask();
   m_pForm.reset();
   return true;
 }
@@ -82,6 +84,10 @@ void CPDF_Type3Char::SetForm(std::unique_ptr<CPDF_Font::FormIface> pForm) {
   m_pForm = std::move(pForm);
 }
 
+void CPDF_Type3Char::SetCharProc(const CPDF_Stream* pCharProc) {
+  m_pCharProc.Reset(pCharProc);
+}
+
 RetainPtr<CFX_DIBitmap> CPDF_Type3Char::GetBitmap() {
   return m_pBitmap;
 }
@@ -16,6 +16,7 @@
 #include "third_party/base/optional.h"
 
 class CFX_DIBitmap;
+class CPDF_Stream;
 
 class CPDF_Type3Char {
  public:
@@ -41,10 +42,19 @@ class CPDF_Type3Char {
   const CPDF_Font::FormIface* form() const { return m_pForm.get(); }
   void SetForm(std::unique_ptr<CPDF_Font::FormIface> pForm);
 
+  const CPDF_Stream* char_proc() const { return m_pCharProc.Get(); }
+  void SetCharProc(const CPDF_Stream* pCharProc);
+
+  // True if the bitmap comes from an inline image mask, and so depends only
+  // on the CharProc stream, not on the font or its resources.
+  bool bitmap_is_inline_mask() const { return m_bBitmapIsInlineMask; }
+
  private:
   std::unique_ptr<CPDF_Font::FormIface> m_pForm;
   RetainPtr<CFX_DIBitmap> m_pBitmap;
+  RetainPtr<const CPDF_Stream> m_pCharProc;
   bool m_bColored = false;
+  bool m_bBitmapIsInlineMask = false;
   int m_Width = 0;
   CFX_Matrix m_ImageMatrix;
   FX_RECT m_BBox;
@@ -126,6 +126,7 @@ CPDF_Type3Char* CPDF_Type3Font::LoadChar(uint32_t charcode) {
       pStream);
 
   auto pNewChar = std::make_unique<CPDF_Type3Char>();
+  pNewChar->SetCharProc(pStream);
 
   // This can trigger recursion into this method. The content of |m_CacheMap|
   // can change as a result. Thus after it returns, check the cache again for
@@ -228,6 +228,12 @@ class CPDF_ICCBasedCS final : public CPDF_ColorSpace {
                           int image_width,
                           int image_height,
                           bool bTransMask) const override;
+  bool TranslateImage(uint8_t* dest_buf,
+                      uint32_t dest_pitch,
+                      const uint8_t* src_buf,
+                      uint32_t src_pitch,
+                      int image_width,
+                      int image_height) const override;
   bool IsNormal() const override;
   uint32_t v_Load(CPDF_Document* pDoc,
                   const CPDF_Array* pArray,
@@ -236,6 +242,13 @@ class CPDF_ICCBasedCS final : public CPDF_ColorSpace {
  private:
   explicit CPDF_ICCBasedCS(CPDF_Document* pDoc);
 
+  // Returns the number of colors in |m_pCache|, one for each combination of
+  // 52 levels per component.
+  int GetMaxCacheColors() const;
+  // Whether TranslateImageLine() should translate pixels through the ICC
+  // transform itself rather than through |m_pCache|.
+  bool ShouldTranslateDirectly(int image_width, int image_height) const;
+
   // If no valid ICC profile or using sRGB, try looking for an alternate.
   bool FindAlternateProfile(CPDF_Document* pDoc,
                             const CPDF_Dictionary* pDict,
@@ -643,6 +656,15 @@ void CPDF_ColorSpace::TranslateImageLine(uint8_t* dest_buf,
   }
 }
 
+bool CPDF_ColorSpace::TranslateImage(uint8_t* dest_buf,
+                                     uint32_t dest_pitch,
+                                     const uint8_t* src_buf,
+                                     uint32_t src_pitch,
+                                     int image_width,
+                                     int image_height) const {
+  return false;
+}
+
 void CPDF_ColorSpace::EnableStdConversion(bool bEnabled) {
   if (bEnabled)
     m_dwStdConversion++;
@@ -1027,26 +1049,14 @@ void CPDF_ICCBasedCS::TranslateImageLine(uint8_t* pDestBuf,
     return;
   }
 
-  // |nMaxColors| will not overflow since |nComponents| is limited in size.
-  const uint32_t nComponents = CountComponents();
-  DCHECK(IsValidIccComponents(nComponents));
-  int nMaxColors = 1;
-  for (uint32_t i = 0; i < nComponents; i++)
-    nMaxColors *= 52;
-
-  bool bTranslate = nComponents > 3;
-  if (!bTranslate) {
-    FX_SAFE_INT32 nPixelCount = image_width;
-    nPixelCount *= image_height;
-    if (nPixelCount.IsValid())
-      bTranslate = nPixelCount.ValueOrDie() < nMaxColors * 3 / 2;
-  }
-  if (bTranslate) {
+  if (ShouldTranslateDirectly(image_width, image_height)) {
     IccModule::TranslateScanline(m_pProfile->transform(), pDestBuf, pSrcBuf,
                                  pixels);
     return;
   }
 
+  const uint32_t nComponents = CountComponents();
+  const int nMaxColors = GetMaxCacheColors();
   if (m_pCache.empty()) {
     m_pCache =
         fxcrt::Vector2D<uint8_t, FxAllocAllocator<uint8_t>>(nMaxColors, 3);
@@ -1078,6 +1088,25 @@ void CPDF_ICCBasedCS::TranslateImageLine(uint8_t* pDestBuf,
   }
 }
 
+bool CPDF_ICCBasedCS::TranslateImage(uint8_t* dest_buf,
+                                     uint32_t dest_pitch,
+                                     const uint8_t* src_buf,
+                                     uint32_t src_pitch,
+                                     int image_width,
+                                     int image_height) const {
+  // Lab transforms take floating point input, so they cannot read 8-bit
+  // image data.
+  CLcmsCmm* transform = m_pProfile->transform();
+  if (m_pProfile->IsSRGB() || !transform || transform->IsLab() ||
+      !ShouldTranslateDirectly(image_width, image_height)) {
+    return false;
+  }
+
+  IccModule::TranslateImage(transform, dest_buf, dest_pitch, src_buf,
+                            src_pitch, image_width, image_height);
+  return true;
+}
+
 bool CPDF_ICCBasedCS::IsNormal() const {
   if (m_pProfile->IsSRGB())
     return true;
@@ -1111,6 +1140,27 @@ bool CPDF_ICCBasedCS::FindAlternateProfile(
   return true;
 }
 
+int CPDF_ICCBasedCS::GetMaxCacheColors() const {
+  // |nMaxColors| will not overflow since |nComponents| is limited in size.
+  const uint32_t nComponents = CountComponents();
+  DCHECK(IsValidIccComponents(nComponents));
+  int nMaxColors = 1;
+  for (uint32_t i = 0; i < nComponents; i++)
+    nMaxColors *= 52;
+  return nMaxColors;
+}
+
+bool CPDF_ICCBasedCS::ShouldTranslateDirectly(int image_width,
+                                              int image_height) const {
+  if (CountComponents() > 3)
+    return true;
+
+  FX_SAFE_INT32 nPixelCount = image_width;
+  nPixelCount *= image_height;
+  return nPixelCount.IsValid() &&
+         nPixelCount.ValueOrDie() < GetMaxCacheColors() * 3 / 2;
+}
+
 // static
 RetainPtr<CPDF_ColorSpace> CPDF_ICCBasedCS::GetStockAlternateProfile(
     uint32_t nComponents) {
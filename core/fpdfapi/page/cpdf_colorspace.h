@@ -109,6 +109,15 @@ class CPDF_ColorSpace : public Retainable, public Observable {
                                   int image_width,
                                   int image_height,
                                   bool bTransMask) const;
+  // Translates a whole image to BGR in one call. Returns false without
+  // writing anything if the color space has no faster way to do that than
+  // calling TranslateImageLine() for each row.
+  virtual bool TranslateImage(uint8_t* dest_buf,
+                              uint32_t dest_pitch,
+                              const uint8_t* src_buf,
+                              uint32_t src_pitch,
+                              int image_width,
+                              int image_height) const;
   virtual void EnableStdConversion(bool bEnabled);
   virtual bool IsNormal() const;
 
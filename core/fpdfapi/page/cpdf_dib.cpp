@@ -563,13 +563,37 @@ CPDF_DIB::LoadState CPDF_DIB::CreateDecoder() {
   return LoadState::kSuccess;
 }
 
+void CPDF_DIB::SetMinDecodeSize(int width, int height) {
+  m_MinDecodeWidth = width;
+  m_MinDecodeHeight = height;
+}
+
+uint32_t CPDF_DIB::GetDCTScaleDenom() const {
+  if (m_MinDecodeWidth <= 0 || m_MinDecodeHeight <= 0)
+    return 1;
+
+  for (uint32_t scale_denom : {8, 4, 2}) {
+    const int scaled_width = (m_Width + scale_denom - 1) / scale_denom;
+    const int scaled_height = (m_Height + scale_denom - 1) / scale_denom;
+    if (scaled_width >= m_MinDecodeWidth && scaled_height >= m_MinDecodeHeight)
+      return scale_denom;
+  }
+  return 1;
+}
+
 bool CPDF_DIB::CreateDCTDecoder(pdfium::span<const uint8_t> src_span,
                                 const CPDF_Dictionary* pParams) {
-  m_pDecoder = JpegModule::CreateDecoder(
+  const uint32_t scale_denom = GetDCTScaleDenom();
+  m_pDecoder = JpegModule::CreateScaledDecoder(
       src_span, m_Width, m_Height, m_nComponents,
-      !pParams || pParams->GetIntegerFor("ColorTransform", 1));
-  if (m_pDecoder)
+      !pParams || pParams->GetIntegerFor("ColorTransform", 1), scale_denom);
+  if (m_pDecoder) {
+    if (scale_denom != 1) {
+      m_Width = m_pDecoder->GetWidth();
+      m_Height = m_pDecoder->GetHeight();
+    }
     return true;
+  }
 
   Optional<JpegModule::ImageInfo> info_opt = JpegModule::LoadInfo(src_span);
   if (!info_opt.has_value())
@@ -1005,6 +1029,52 @@ void CPDF_DIB::TranslateScanline24bpp(uint8_t* dest_scan,
   }
 }
 
+void CPDF_DIB::TranslateWholeImage() const {
+  if (!m_pColorSpace || m_bImageMask || m_bpc != 8 || m_nComponents < 2 ||
+      !m_bDefaultDecode || TransMask() ||
+      m_nComponents != m_pColorSpace->CountComponents()) {
+    return;
+  }
+
+  const uint32_t src_pitch_value = m_Width * m_nComponents;
+  const uint8_t* src_buf = nullptr;
+  uint32_t src_pitch = 0;
+  if (m_pCachedBitmap) {
+    if (m_pCachedBitmap->GetHeight() < m_Height ||
+        m_pCachedBitmap->GetPitch() < src_pitch_value) {
+      return;
+    }
+    src_buf = m_pCachedBitmap->GetBuffer();
+    src_pitch = m_pCachedBitmap->GetPitch();
+  } else if (!m_pDecoder &&
+             m_pStreamAcc->GetSize() >=
+                 static_cast<uint64_t>(src_pitch_value) * m_Height) {
+    src_buf = m_pStreamAcc->GetData();
+    src_pitch = src_pitch_value;
+  } else {
+    return;
+  }
+
+  const Optional<uint32_t> dest_pitch =
+      fxcodec::CalculatePitch32(24, m_Width);
+  if (!dest_pitch.has_value())
+    return;
+
+  FX_SAFE_SIZE_T dest_size = dest_pitch.value();
+  dest_size *= m_Height;
+  if (!dest_size.IsValid() || dest_size.ValueOrDie() > kHugeImageSize)
+    return;
+
+  m_TranslatedImage.resize(dest_size.ValueOrDie());
+  if (!m_pColorSpace->TranslateImage(m_TranslatedImage.data(),
+                                     dest_pitch.value(), src_buf, src_pitch,
+                                     m_Width, m_Height)) {
+    m_TranslatedImage.clear();
+    return;
+  }
+  m_TranslatedPitch = dest_pitch.value();
+}
+
 bool CPDF_DIB::TranslateScanline24bppDefaultDecode(
     uint8_t* dest_scan,
     const uint8_t* src_scan) const {
@@ -1169,7 +1239,13 @@ const uint8_t* CPDF_DIB::GetScanline(int line) const {
       memset(m_pMaskedLine.get(), 0xFF, m_Pitch);
     }
   }
-  if (m_pColorSpace) {
+  if (!m_bTriedTranslateWholeImage) {
+    m_bTriedTranslateWholeImage = true;
+    TranslateWholeImage();
+  }
+  if (!m_TranslatedImage.empty() && line < m_Height) {
+    pSrcLine = m_TranslatedImage.data() + line * m_TranslatedPitch;
+  } else if (m_pColorSpace) {
     TranslateScanline24bpp(m_pLineBuf.get(), pSrcLine);
     pSrcLine = m_pLineBuf.get();
   }
@@ -63,6 +63,10 @@ class CPDF_DIB final : public CFX_DIBBase {
   LoadState ContinueLoadDIBBase(PauseIndicatorIface* pPause);
   RetainPtr<CPDF_DIB> DetachMask();
 
+  // Lets DCT-encoded images decode at a reduced size, as long as it is at
+  // least |width| x |height|. Must be called before StartLoadDIBBase().
+  void SetMinDecodeSize(int width, int height);
+
   bool IsJBigImage() const;
 
  private:
@@ -90,10 +94,12 @@ class CPDF_DIB final : public CFX_DIBBase {
   LoadState CreateDecoder();
   bool CreateDCTDecoder(pdfium::span<const uint8_t> src_span,
                         const CPDF_Dictionary* pParams);
+  uint32_t GetDCTScaleDenom() const;
   void TranslateScanline24bpp(uint8_t* dest_scan,
                               const uint8_t* src_scan) const;
   bool TranslateScanline24bppDefaultDecode(uint8_t* dest_scan,
                                            const uint8_t* src_scan) const;
+  void TranslateWholeImage() const;
   void ValidateDictParam(const ByteString& filter);
   bool TransMask() const;
   void SetMaskProperties();
@@ -112,6 +118,8 @@ class CPDF_DIB final : public CFX_DIBBase {
   CPDF_ColorSpace::Family m_Family = CPDF_ColorSpace::Family::kUnknown;
   CPDF_ColorSpace::Family m_GroupFamily = CPDF_ColorSpace::Family::kUnknown;
   uint32_t m_MatteColor = 0;
+  int m_MinDecodeWidth = 0;
+  int m_MinDecodeHeight = 0;
   LoadState m_Status = LoadState::kFail;
   bool m_bLoadMask = false;
   bool m_bDefaultDecode = true;
@@ -124,6 +132,13 @@ class CPDF_DIB final : public CFX_DIBBase {
   std::unique_ptr<uint8_t, FxFreeDeleter> m_pLineBuf;
   std::unique_ptr<uint8_t, FxFreeDeleter> m_pMaskedLine;
   RetainPtr<CFX_DIBitmap> m_pCachedBitmap;
+  // The whole image translated to 24bpp BGR when the decoded data is all
+  // available up front and the color space can translate it in one call.
+  // Filled in by the first GetScanline() call, so images that are only
+  // downsampled never pay for it.
+  mutable std::vector<uint8_t, FxAllocAllocator<uint8_t>> m_TranslatedImage;
+  mutable uint32_t m_TranslatedPitch = 0;
+  mutable bool m_bTriedTranslateWholeImage = false;
   // Note: Must not create a cycle between CPDF_DIB instances.
   RetainPtr<CPDF_DIB> m_pMask;
   RetainPtr<CPDF_StreamAcc> m_pGlobalAcc;
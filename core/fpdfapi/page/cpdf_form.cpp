@@ -10,6 +10,7 @@
 #include <memory>
 
 #include "core/fpdfapi/page/cpdf_contentparser.h"
+#include "core/fpdfapi/page/cpdf_image.h"
 #include "core/fpdfapi/page/cpdf_imageobject.h"
 #include "core/fpdfapi/page/cpdf_pageobject.h"
 #include "core/fpdfapi/page/cpdf_pageobjectholder.h"
@@ -117,3 +118,15 @@ CPDF_Form::GetBitmapAndMatrixFromSoleImageOfForm() const {
 
   return {{pImageObject->GetIndependentBitmap(), pImageObject->matrix()}};
 }
+
+bool CPDF_Form::IsSoleImageOfFormAnInlineMask() const {
+  if (GetPageObjectCount() != 1)
+    return false;
+
+  CPDF_ImageObject* pImageObject = (*begin())->AsImage();
+  if (!pImageObject)
+    return false;
+
+  RetainPtr<CPDF_Image> pImage = pImageObject->GetImage();
+  return pImage->IsInline() && pImage->IsMask();
+}
@@ -44,6 +44,7 @@ class CPDF_Form final : public CPDF_PageObjectHolder,
   CFX_FloatRect CalcBoundingBox() const override;
   Optional<std::pair<RetainPtr<CFX_DIBitmap>, CFX_Matrix>>
   GetBitmapAndMatrixFromSoleImageOfForm() const override;
+  bool IsSoleImageOfFormAnInlineMask() const override;
 
   void ParseContent();
   void ParseContent(const CPDF_AllStates* pGraphicStates,
@@ -7,6 +7,7 @@
 #include "core/fpdfapi/page/cpdf_iccprofile.h"
 
 #include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fxcodec/icc/icc_transform_cache.h"
 #include "core/fxcodec/icc/iccmodule.h"
 
 namespace {
@@ -26,7 +27,7 @@ CPDF_IccProfile::CPDF_IccProfile(const CPDF_Stream* pStream,
     return;
   }
 
-  m_Transform = IccModule::CreateTransformSRGB(span);
+  m_Transform = IccTransformCache::GetInstance()->GetTransformSRGB(span);
   if (m_Transform)
     m_nSrcComponents = m_Transform->components();
 }
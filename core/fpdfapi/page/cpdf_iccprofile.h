@@ -37,7 +37,7 @@ class CPDF_IccProfile final : public Retainable, public Observable {
   const bool m_bsRGB;
   uint32_t m_nSrcComponents = 0;
   RetainPtr<const CPDF_Stream> const m_pStream;
-  std::unique_ptr<fxcodec::CLcmsCmm> m_Transform;
+  std::shared_ptr<fxcodec::CLcmsCmm> m_Transform;
 };
 
 #endif  // CORE_FPDFAPI_PAGE_CPDF_ICCPROFILE_H_
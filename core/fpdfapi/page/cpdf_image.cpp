@@ -356,8 +356,10 @@ bool CPDF_Image::StartLoadDIBBase(const CPDF_Dictionary* pFormResource,
                                   const CPDF_Dictionary* pPageResource,
                                   bool bStdCS,
                                   CPDF_ColorSpace::Family GroupFamily,
-                                  bool bLoadMask) {
+                                  bool bLoadMask,
+                                  const CFX_Size& min_decode_size) {
   auto source = pdfium::MakeRetain<CPDF_DIB>();
+  source->SetMinDecodeSize(min_decode_size.width, min_decode_size.height);
   CPDF_DIB::LoadState ret = source->StartLoadDIBBase(
       m_pDocument.Get(), m_pStream.Get(), true, pFormResource, pPageResource,
       bStdCS, GroupFamily, bLoadMask);
@@ -10,6 +10,7 @@
 #include <stdint.h>
 
 #include "core/fpdfapi/page/cpdf_colorspace.h"
+#include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/unowned_ptr.h"
 #include "third_party/base/span.h"
@@ -52,12 +53,14 @@ class CPDF_Image final : public Retainable {
 
   void ResetCache(CPDF_Page* pPage);
 
-  // Returns whether to Continue() or not.
+  // Returns whether to Continue() or not. See CPDF_DIB::SetMinDecodeSize()
+  // for |min_decode_size|, which is ignored when empty.
   bool StartLoadDIBBase(const CPDF_Dictionary* pFormResource,
                         const CPDF_Dictionary* pPageResource,
                         bool bStdCS,
                         CPDF_ColorSpace::Family GroupFamily,
-                        bool bLoadMask);
+                        bool bLoadMask,
+                        const CFX_Size& min_decode_size);
 
   // Returns whether to Continue() or not.
   bool Continue(PauseIndicatorIface* pPause);
@@ -6,6 +6,8 @@
 
 #include "core/fpdfapi/page/cpdf_pageobject.h"
 
+#include "core/fpdfapi/page/cpdf_pageobjectholder.h"
+
 CPDF_PageObject::CPDF_PageObject(int32_t content_stream)
     : m_ContentStream(content_stream) {}
 
@@ -77,6 +79,12 @@ void CPDF_PageObject::CopyData(const CPDF_PageObject* pSrc) {
   m_bDirty = true;
 }
 
+void CPDF_PageObject::SetDirty(bool value) {
+  m_bDirty = value;
+  if (value)
+    NotifyHolder();
+}
+
 void CPDF_PageObject::TransformClipPath(const CFX_Matrix& matrix) {
   if (!m_ClipPath.HasRef())
     return;
@@ -91,6 +99,16 @@ void CPDF_PageObject::TransformGeneralState(const CFX_Matrix& matrix) {
   SetDirty(true);
 }
 
+void CPDF_PageObject::SetRect(const CFX_FloatRect& rect) {
+  m_Rect = rect;
+  NotifyHolder();
+}
+
+void CPDF_PageObject::NotifyHolder() {
+  if (m_pHolder)
+    m_pHolder->OnObjectChanged();
+}
+
 FX_RECT CPDF_PageObject::GetBBox() const {
   return GetRect().GetOuterRect();
 }
@@ -98,3 +116,4 @@ FX_RECT CPDF_PageObject::GetBBox() const {
 FX_RECT CPDF_PageObject::GetTransformedBBox(const CFX_Matrix& matrix) const {
   return matrix.TransformRect(GetRect()).GetOuterRect();
 }
+
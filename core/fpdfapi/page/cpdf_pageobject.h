@@ -12,9 +12,11 @@
 #include "core/fpdfapi/page/cpdf_contentmarks.h"
 #include "core/fpdfapi/page/cpdf_graphicstates.h"
 #include "core/fxcrt/fx_coordinates.h"
+#include "core/fxcrt/unowned_ptr.h"
 
 class CPDF_FormObject;
 class CPDF_ImageObject;
+class CPDF_PageObjectHolder;
 class CPDF_PathObject;
 class CPDF_ShadingObject;
 class CPDF_TextObject;
@@ -54,12 +56,12 @@ class CPDF_PageObject : public CPDF_GraphicStates {
   virtual CPDF_FormObject* AsForm();
   virtual const CPDF_FormObject* AsForm() const;
 
-  void SetDirty(bool value) { m_bDirty = value; }
+  void SetDirty(bool value);
   bool IsDirty() const { return m_bDirty; }
   void TransformClipPath(const CFX_Matrix& matrix);
   void TransformGeneralState(const CFX_Matrix& matrix);
 
-  void SetRect(const CFX_FloatRect& rect) { m_Rect = rect; }
+  void SetRect(const CFX_FloatRect& rect);
   const CFX_FloatRect& GetRect() const { return m_Rect; }
   FX_RECT GetBBox() const;
   FX_RECT GetTransformedBBox(const CFX_Matrix& matrix) const;
@@ -82,6 +84,10 @@ class CPDF_PageObject : public CPDF_GraphicStates {
     m_ContentStream = new_content_stream;
   }
 
+  // The holder the object is in, which SetDirty(true) and SetRect() tell
+  // about the change. See CPDF_PageObjectHolder::GetGeneration().
+  void SetHolder(CPDF_PageObjectHolder* pHolder) { m_pHolder = pHolder; }
+  void NotifyHolder();
 
  protected:
   void CopyData(const CPDF_PageObject* pSrcObject);
@@ -92,6 +98,7 @@ class CPDF_PageObject : public CPDF_GraphicStates {
   CPDF_ContentMarks m_ContentMarks;
   bool m_bDirty = false;
   int32_t m_ContentStream;
+  UnownedPtr<CPDF_PageObjectHolder> m_pHolder;
 };
 
 #endif  // CORE_FPDFAPI_PAGE_CPDF_PAGEOBJECT_H_
@@ -13,6 +13,7 @@
 #include "core/fpdfapi/page/cpdf_allstates.h"
 #include "core/fpdfapi/page/cpdf_contentparser.h"
 #include "core/fpdfapi/page/cpdf_pageobject.h"
+#include "core/fpdfapi/page/cpdf_pageobjectindex.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fxcrt/fx_extension.h"
@@ -20,6 +21,13 @@
 #include "third_party/base/check.h"
 #include "third_party/base/check_op.h"
 
+namespace {
+
+// Below this, testing every object is about as fast as querying an index.
+constexpr size_t kMinObjectsForIndex = 512;
+
+}  // namespace
+
 bool GraphicsData::operator<(const GraphicsData& other) const {
   if (!FXSYS_SafeEQ(fillAlpha, other.fillAlpha))
     return FXSYS_SafeLT(fillAlpha, other.fillAlpha);
@@ -67,6 +75,7 @@ void CPDF_PageObjectHolder::ContinueParse(PauseIndicatorIface* pPause) {
     return;
 
   m_ParseState = ParseState::kParsed;
+  m_ParsedGeneration = m_Generation;
   m_pDocument->IncrementParsedPageCount();
   if (m_pParser->GetCurStates())
     m_LastCTM = m_pParser->GetCurStates()->m_CTM;
@@ -132,9 +141,32 @@ CPDF_PageObject* CPDF_PageObjectHolder::GetPageObjectByIndex(
              : nullptr;
 }
 
+Optional<std::vector<size_t>> CPDF_PageObjectHolder::GetObjectPositionsInRect(
+    const CFX_FloatRect& rect) const {
+  if (m_ParseState != ParseState::kParsed ||
+      m_PageObjectList.size() < kMinObjectsForIndex) {
+    return pdfium::nullopt;
+  }
+
+  if (!m_pObjectIndex || m_ObjectIndexGeneration != m_Generation) {
+    m_pObjectIndex = std::make_unique<CPDF_PageObjectIndex>(m_PageObjectList);
+    m_ObjectIndexGeneration = m_Generation;
+  }
+  return m_pObjectIndex->Query(rect);
+}
+
+void CPDF_PageObjectHolder::OnObjectChanged() {
+  ++m_Generation;
+  if (m_pOwnerObject)
+    m_pOwnerObject->NotifyHolder();
+}
+
 void CPDF_PageObjectHolder::AppendPageObject(
     std::unique_ptr<CPDF_PageObject> pPageObj) {
+  if (pPageObj)
+    pPageObj->SetHolder(this);
   m_PageObjectList.push_back(std::move(pPageObj));
+  OnObjectChanged();
 }
 
 bool CPDF_PageObjectHolder::RemovePageObject(CPDF_PageObject* pPageObj) {
@@ -147,6 +179,8 @@ bool CPDF_PageObjectHolder::RemovePageObject(CPDF_PageObject* pPageObj) {
 
   it->release();
   m_PageObjectList.erase(it);
+  pPageObj->SetHolder(nullptr);
+  OnObjectChanged();
 
   int32_t content_stream = pPageObj->GetContentStream();
   if (content_stream >= 0)
@@ -160,5 +194,6 @@ bool CPDF_PageObjectHolder::ErasePageObjectAtIndex(size_t index) {
     return false;
 
   m_PageObjectList.erase(m_PageObjectList.begin() + index);
+  OnObjectChanged();
   return true;
 }
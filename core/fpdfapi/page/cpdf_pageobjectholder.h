@@ -28,6 +28,7 @@
 class CPDF_ContentParser;
 class CPDF_Document;
 class CPDF_PageObject;
+class CPDF_PageObjectIndex;
 class PauseIndicatorIface;
 
 // These structs are used to keep track of resources that have already been
@@ -78,6 +79,30 @@ class CPDF_PageObjectHolder {
   bool RemovePageObject(CPDF_PageObject* pPageObj);
   bool ErasePageObjectAtIndex(size_t index);
 
+  // Returns the positions of the objects whose rects intersect |rect|, in
+  // ascending order, from an index built on first use. Returns nullopt while
+  // parsing and for holders too small to need an index, in which case the
+  // caller tests every object.
+  Optional<std::vector<size_t>> GetObjectPositionsInRect(
+      const CFX_FloatRect& rect) const;
+
+  // Changes whenever objects are added, removed or changed, including the
+  // objects of the Form XObjects among them, so anything derived from the
+  // objects can tell when it is stale. Unlike the objects' dirty flags, it
+  // is not reset by generating content streams.
+  uint32_t GetGeneration() const { return m_Generation; }
+  void OnObjectChanged();
+
+  // Whether the objects no longer match what parsing produced.
+  bool HasChangedSinceParse() const {
+    return m_ParseState != ParseState::kParsed ||
+           m_Generation != m_ParsedGeneration;
+  }
+
+  // The form object that owns this holder, if any, which gets notified of
+  // changes in turn.
+  void SetOwnerObject(CPDF_PageObject* pObj) { m_pOwnerObject = pObj; }
+
   iterator begin() { return m_PageObjectList.begin(); }
   const_iterator begin() const { return m_PageObjectList.begin(); }
 
@@ -125,6 +150,11 @@ class CPDF_PageObjectHolder {
   std::vector<CFX_FloatRect> m_MaskBoundingBoxes;
   std::unique_ptr<CPDF_ContentParser> m_pParser;
   std::deque<std::unique_ptr<CPDF_PageObject>> m_PageObjectList;
+  mutable std::unique_ptr<CPDF_PageObjectIndex> m_pObjectIndex;
+  mutable uint32_t m_ObjectIndexGeneration = 0;
+  uint32_t m_Generation = 0;
+  uint32_t m_ParsedGeneration = 0;
+  UnownedPtr<CPDF_PageObject> m_pOwnerObject;
   CFX_Matrix m_LastCTM;
 
   // The indexes of Content streams that are dirty and need to be regenerated.
@@ -8,8 +8,15 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
+#include <utility>
 #include <vector>
 
+#include "core/fpdfapi/page/cpdf_form.h"
+#include "core/fpdfapi/page/cpdf_formobject.h"
+#include "core/fpdfapi/page/cpdf_pathobject.h"
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fxcrt/fx_extension.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -81,3 +88,47 @@ TEST(CPDFPageObjectHolder, GraphicsDataAsKey) {
   }
   EXPECT_EQ(0u, graphics_map.size());
 }
+
+TEST(CPDFPageObjectHolder, GenerationTracksObjectChanges) {
+  auto pDict = pdfium::MakeRetain<CPDF_Dictionary>();
+  CPDF_PageObjectHolder holder(nullptr, pDict.Get(), nullptr, nullptr);
+  uint32_t generation = holder.GetGeneration();
+
+  auto pOwnedPath = std::make_unique<CPDF_PathObject>();
+  CPDF_PathObject* pPath = pOwnedPath.get();
+  holder.AppendPageObject(std::move(pOwnedPath));
+  EXPECT_NE(generation, holder.GetGeneration());
+
+  generation = holder.GetGeneration();
+  pPath->SetRect(CFX_FloatRect(0, 0, 10, 10));
+  EXPECT_NE(generation, holder.GetGeneration());
+
+  // Generating content clears the dirty flag, which is not a change.
+  generation = holder.GetGeneration();
+  pPath->SetDirty(false);
+  EXPECT_EQ(generation, holder.GetGeneration());
+  pPath->SetDirty(true);
+  EXPECT_NE(generation, holder.GetGeneration());
+
+  // Changes inside a Form XObject reach the holder of the form object.
+  auto pStream = pdfium::MakeRetain<CPDF_Stream>(
+      nullptr, 0, pdfium::MakeRetain<CPDF_Dictionary>());
+  auto pOwnedForm =
+      std::make_unique<CPDF_Form>(nullptr, nullptr, pStream.Get());
+  CPDF_Form* pForm = pOwnedForm.get();
+  holder.AppendPageObject(std::make_unique<CPDF_FormObject>(
+      CPDF_PageObject::kNoContentStream, std::move(pOwnedForm), CFX_Matrix()));
+  auto pOwnedInner = std::make_unique<CPDF_PathObject>();
+  CPDF_PathObject* pInner = pOwnedInner.get();
+  pForm->AppendPageObject(std::move(pOwnedInner));
+  generation = holder.GetGeneration();
+  pInner->SetDirty(true);
+  EXPECT_NE(generation, holder.GetGeneration());
+
+  // Removed objects no longer count.
+  ASSERT_TRUE(holder.RemovePageObject(pPath));
+  std::unique_ptr<CPDF_PathObject> pRemoved(pPath);
+  generation = holder.GetGeneration();
+  pRemoved->SetDirty(true);
+  EXPECT_EQ(generation, holder.GetGeneration());
+}
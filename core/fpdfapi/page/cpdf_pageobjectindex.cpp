@@ -0,0 +1,189 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/page/cpdf_pageobjectindex.h"
+
+#include <math.h>
+
+#include <algorithm>
+
+#include "core/fpdfapi/page/cpdf_pageobject.h"
+
+namespace {
+
+// Average number of objects per cell the grid is sized for.
+constexpr size_t kObjectsPerCell = 4;
+constexpr size_t kMaxGridSide = 512;
+
+// Objects covering more cells than this are tested on every query instead.
+constexpr size_t kMaxCellsPerObject = 16;
+
+bool IsFinite(const CFX_FloatRect& rect) {
+  return isfinite(rect.left) && isfinite(rect.right) &&
+         isfinite(rect.bottom) && isfinite(rect.top);
+}
+
+bool HasNaN(const CFX_FloatRect& rect) {
+  return isnan(rect.left) || isnan(rect.right) || isnan(rect.bottom) ||
+         isnan(rect.top);
+}
+
+CFX_FloatRect GetNormalized(const CFX_FloatRect& rect) {
+  CFX_FloatRect normalized = rect;
+  normalized.Normalize();
+  return normalized;
+}
+
+// Same test as CPDF_RenderStatus::RenderObjectList() culls objects with.
+bool Intersects(const CFX_FloatRect& object_rect,
+                const CFX_FloatRect& clip_rect) {
+  return !(object_rect.left > clip_rect.right ||
+           object_rect.right < clip_rect.left ||
+           object_rect.bottom > clip_rect.top ||
+           object_rect.top < clip_rect.bottom);
+}
+
+}  // namespace
+
+size_t CPDF_PageObjectIndex::CellRange::GetCellCount() const {
+  return (last_column - first_column + 1) * (last_row - first_row + 1);
+}
+
+CPDF_PageObjectIndex::CPDF_PageObjectIndex(const ObjectList& objects)
+    : m_ObjectCount(objects.size()) {
+  m_Rects.resize(m_ObjectCount);
+  std::vector<uint32_t> gridded;
+  bool has_bounds = false;
+  for (size_t i = 0; i < m_ObjectCount; ++i) {
+    CPDF_PageObject* pObj = objects[i].get();
+    if (!pObj)
+      continue;
+
+    m_Objects.push_back(i);
+    m_Rects[i] = pObj->GetRect();
+    if (!IsFinite(m_Rects[i])) {
+      m_UnindexedObjects.push_back(i);
+      continue;
+    }
+    gridded.push_back(i);
+    CFX_FloatRect normalized = GetNormalized(m_Rects[i]);
+    if (has_bounds) {
+      m_Bounds.Union(normalized);
+    } else {
+      m_Bounds = normalized;
+      has_bounds = true;
+    }
+  }
+
+  size_t side = static_cast<size_t>(
+      ceil(sqrt(static_cast<double>(gridded.size() / kObjectsPerCell))));
+  side = std::min(std::max<size_t>(side, 1), kMaxGridSide);
+  m_Columns = m_Bounds.Width() > 0 ? side : 1;
+  m_Rows = m_Bounds.Height() > 0 ? side : 1;
+  m_CellWidth = m_Bounds.Width() / m_Columns;
+  m_CellHeight = m_Bounds.Height() / m_Rows;
+
+  // Count the objects of each cell, then place them. |m_CellStarts| ends up
+  // with the start of each cell, and one past the end of the last one.
+  m_CellStarts.assign(m_Columns * m_Rows + 1, 0);
+  std::vector<CellRange> ranges;
+  ranges.reserve(gridded.size());
+  for (uint32_t pos : gridded) {
+    CellRange range = GetCellRange(m_Rects[pos]);
+    ranges.push_back(range);
+    if (range.GetCellCount() > kMaxCellsPerObject)
+      continue;
+
+    for (size_t row = range.first_row; row <= range.last_row; ++row) {
+      for (size_t col = range.first_column; col <= range.last_column; ++col)
+        ++m_CellStarts[row * m_Columns + col + 1];
+    }
+  }
+  for (size_t cell = 1; cell < m_CellStarts.size(); ++cell)
+    m_CellStarts[cell] += m_CellStarts[cell - 1];
+
+  m_CellObjects.resize(m_CellStarts.back());
+  std::vector<uint32_t> next(m_CellStarts.begin(), m_CellStarts.end() - 1);
+  for (size_t i = 0; i < gridded.size(); ++i) {
+    const CellRange& range = ranges[i];
+    if (range.GetCellCount() > kMaxCellsPerObject) {
+      m_UnindexedObjects.push_back(gridded[i]);
+      continue;
+    }
+    for (size_t row = range.first_row; row <= range.last_row; ++row) {
+      for (size_t col = range.first_column; col <= range.last_column; ++col)
+        m_CellObjects[next[row * m_Columns + col]++] = gridded[i];
+    }
+  }
+  std::sort(m_UnindexedObjects.begin(), m_UnindexedObjects.end());
+}
+
+CPDF_PageObjectIndex::~CPDF_PageObjectIndex() = default;
+
+std::vector<size_t> CPDF_PageObjectIndex::Query(
+    const CFX_FloatRect& rect) const {
+  std::vector<size_t> result;
+  CellRange range = {};
+  bool use_grid = !HasNaN(rect);
+  if (use_grid) {
+    range = GetCellRange(rect);
+    // Collecting and sorting the cells' objects only pays off for small
+    // parts of the grid.
+    use_grid = range.GetCellCount() <= m_Columns * m_Rows / 4;
+  }
+  if (!use_grid) {
+    for (uint32_t pos : m_Objects) {
+      if (Intersects(m_Rects[pos], rect))
+        result.push_back(pos);
+    }
+    return result;
+  }
+
+  std::vector<uint32_t> candidates = m_UnindexedObjects;
+  for (size_t row = range.first_row; row <= range.last_row; ++row) {
+    size_t cell = row * m_Columns;
+    candidates.insert(candidates.end(),
+                      m_CellObjects.begin() +
+                          m_CellStarts[cell + range.first_column],
+                      m_CellObjects.begin() +
+                          m_CellStarts[cell + range.last_column + 1]);
+  }
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                   candidates.end());
+  for (uint32_t pos : candidates) {
+    if (Intersects(m_Rects[pos], rect))
+      result.push_back(pos);
+  }
+  return result;
+}
+
+CPDF_PageObjectIndex::CellRange CPDF_PageObjectIndex::GetCellRange(
+    const CFX_FloatRect& rect) const {
+  CFX_FloatRect normalized = GetNormalized(rect);
+  CellRange range;
+  range.first_column = GetColumn(normalized.left);
+  range.last_column = GetColumn(normalized.right);
+  range.first_row = GetRow(normalized.bottom);
+  range.last_row = GetRow(normalized.top);
+  return range;
+}
+
+size_t CPDF_PageObjectIndex::GetColumn(float x) const {
+  if (m_Columns == 1 || x <= m_Bounds.left)
+    return 0;
+  float column = (x - m_Bounds.left) / m_CellWidth;
+  if (!(column < m_Columns - 1))
+    return m_Columns - 1;
+  return static_cast<size_t>(column);
+}
+
+size_t CPDF_PageObjectIndex::GetRow(float y) const {
+  if (m_Rows == 1 || y <= m_Bounds.bottom)
+    return 0;
+  float row = (y - m_Bounds.bottom) / m_CellHeight;
+  if (!(row < m_Rows - 1))
+    return m_Rows - 1;
+  return static_cast<size_t>(row);
+}
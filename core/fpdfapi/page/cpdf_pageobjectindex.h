@@ -0,0 +1,75 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PAGE_CPDF_PAGEOBJECTINDEX_H_
+#define CORE_FPDFAPI_PAGE_CPDF_PAGEOBJECTINDEX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "core/fxcrt/fx_coordinates.h"
+
+class CPDF_PageObject;
+
+// Uniform grid over the rects of a list of page objects, to find the objects
+// that may be visible in a clip rect without testing every one of them.
+// Objects that span many cells, or have non-finite rects, are kept aside and
+// tested on every query.
+class CPDF_PageObjectIndex {
+ public:
+  using ObjectList = std::deque<std::unique_ptr<CPDF_PageObject>>;
+
+  // Snapshots the rects of |objects|. The owning CPDF_PageObjectHolder
+  // rebuilds the index when its generation changes.
+  explicit CPDF_PageObjectIndex(const ObjectList& objects);
+  ~CPDF_PageObjectIndex();
+
+  // Returns the positions of the objects whose rects intersect |rect|, in
+  // ascending order. Uses the same test as CPDF_RenderStatus culls objects
+  // with, so comparisons with NaN never cull.
+  std::vector<size_t> Query(const CFX_FloatRect& rect) const;
+
+  size_t GetColumnCount() const { return m_Columns; }
+  size_t GetRowCount() const { return m_Rows; }
+
+ private:
+  // Inclusive ranges of grid cells.
+  struct CellRange {
+    size_t first_column;
+    size_t last_column;
+    size_t first_row;
+    size_t last_row;
+
+    size_t GetCellCount() const;
+  };
+
+  // Returns the cells covering the normalized form of |rect|, which must be
+  // finite.
+  CellRange GetCellRange(const CFX_FloatRect& rect) const;
+  size_t GetColumn(float x) const;
+  size_t GetRow(float y) const;
+
+  const size_t m_ObjectCount;
+  CFX_FloatRect m_Bounds;
+  size_t m_Columns = 1;
+  size_t m_Rows = 1;
+  float m_CellWidth = 0;
+  float m_CellHeight = 0;
+  // Positions of the non-null objects.
+  std::vector<uint32_t> m_Objects;
+  // Object rects by position, when the index was built.
+  std::vector<CFX_FloatRect> m_Rects;
+  // Positions of the objects in each cell, with |m_CellStarts| holding where
+  // each cell's positions begin in |m_CellObjects|.
+  std::vector<uint32_t> m_CellStarts;
+  std::vector<uint32_t> m_CellObjects;
+  // Positions of the objects tested on every query.
+  std::vector<uint32_t> m_UnindexedObjects;
+};
+
+#endif  // CORE_FPDFAPI_PAGE_CPDF_PAGEOBJECTINDEX_H_
@@ -0,0 +1,94 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/page/cpdf_pageobjectindex.h"
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "core/fpdfapi/page/cpdf_pathobject.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+void AppendObject(CPDF_PageObjectIndex::ObjectList* objects,
+                  const CFX_FloatRect& rect) {
+  auto pObj = std::make_unique<CPDF_PathObject>();
+  pObj->SetRect(rect);
+  objects->push_back(std::move(pObj));
+}
+
+// The objects CPDF_RenderStatus::RenderObjectList() would not cull.
+std::vector<size_t> QueryAll(const CPDF_PageObjectIndex::ObjectList& objects,
+                             const CFX_FloatRect& rect) {
+  std::vector<size_t> result;
+  for (size_t i = 0; i < objects.size(); ++i) {
+    if (!objects[i])
+      continue;
+
+    const CFX_FloatRect& obj_rect = objects[i]->GetRect();
+    if (obj_rect.left > rect.right || obj_rect.right < rect.left ||
+        obj_rect.bottom > rect.top || obj_rect.top < rect.bottom) {
+      continue;
+    }
+    result.push_back(i);
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(CPDF_PageObjectIndex, MatchesLinearScan) {
+  CPDF_PageObjectIndex::ObjectList objects;
+  // A 100 by 100 grid of small objects, plus a few large ones.
+  for (int y = 0; y < 100; ++y) {
+    for (int x = 0; x < 100; ++x) {
+      AppendObject(&objects,
+                   CFX_FloatRect(x * 10, y * 10, x * 10 + 8, y * 10 + 8));
+    }
+  }
+  AppendObject(&objects, CFX_FloatRect(0, 0, 1000, 1000));
+  AppendObject(&objects, CFX_FloatRect(-50, 495, 1050, 505));
+  objects.push_back(nullptr);
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  AppendObject(&objects, CFX_FloatRect(nan, 0, 10, 10));
+  AppendObject(&objects, CFX_FloatRect(nan, nan, nan, nan));
+
+  CPDF_PageObjectIndex index(objects);
+  EXPECT_EQ(50u, index.GetColumnCount());
+  EXPECT_EQ(50u, index.GetRowCount());
+
+  const CFX_FloatRect kQueries[] = {
+      CFX_FloatRect(0, 0, 5, 5),          CFX_FloatRect(95, 95, 125, 118),
+      CFX_FloatRect(8, 8, 10, 10),        CFX_FloatRect(400, 480, 640, 520),
+      CFX_FloatRect(-100, -100, -5, -5),  CFX_FloatRect(990, 990, 2000, 2000),
+      CFX_FloatRect(0, 0, 1000, 1000),    CFX_FloatRect(300, 0, 310, 1000),
+      CFX_FloatRect(nan, 0, 10, 10),
+  };
+  for (const CFX_FloatRect& query : kQueries)
+    EXPECT_EQ(QueryAll(objects, query), index.Query(query));
+
+  // An all NaN rect is never culled, a null object never returned.
+  std::vector<size_t> result = index.Query(CFX_FloatRect(-9, -9, -8, -8));
+  ASSERT_EQ(1u, result.size());
+  EXPECT_EQ(objects.size() - 1, result[0]);
+}
+
+TEST(CPDF_PageObjectIndex, SnapshotsRects) {
+  CPDF_PageObjectIndex::ObjectList objects;
+  for (int i = 0; i < 64; ++i)
+    AppendObject(&objects, CFX_FloatRect(i * 10, 0, i * 10 + 5, 5));
+
+  CPDF_PageObjectIndex index(objects);
+  EXPECT_EQ(std::vector<size_t>{3}, index.Query(CFX_FloatRect(31, 1, 32, 2)));
+
+  objects[3]->SetRect(CFX_FloatRect(500, 0, 505, 5));
+  EXPECT_EQ(std::vector<size_t>{3}, index.Query(CFX_FloatRect(31, 1, 32, 2)));
+
+  CPDF_PageObjectIndex rebuilt(objects);
+  EXPECT_TRUE(rebuilt.Query(CFX_FloatRect(31, 1, 32, 2)).empty());
+  EXPECT_EQ((std::vector<size_t>{3, 50}),
+            rebuilt.Query(CFX_FloatRect(501, 1, 502, 2)));
+}
@@ -34,6 +34,7 @@ class CPDF_TextState {
   ~CPDF_TextState();
 
   void Emplace();
+  bool HasRef() const { return !!m_Ref; }
 
   RetainPtr<CPDF_Font> GetFont() const;
   void SetFont(const RetainPtr<CPDF_Font>& pFont);
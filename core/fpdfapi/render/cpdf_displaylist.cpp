@@ -0,0 +1,266 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/render/cpdf_displaylist.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "core/fpdfapi/font/cpdf_font.h"
+#include "core/fpdfapi/page/cpdf_color.h"
+#include "core/fpdfapi/page/cpdf_occontext.h"
+#include "core/fpdfapi/page/cpdf_pageobject.h"
+#include "core/fpdfapi/page/cpdf_pageobjectholder.h"
+#include "core/fpdfapi/page/cpdf_pathobject.h"
+#include "core/fpdfapi/page/cpdf_textobject.h"
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/render/charposlist.h"
+#include "core/fpdfapi/render/cpdf_renderoptions.h"
+#include "core/fpdfapi/render/cpdf_renderstatus.h"
+#include "core/fpdfapi/render/cpdf_textrenderer.h"
+#include "core/fxcrt/pauseindicator_iface.h"
+#include "core/fxge/cfx_renderdevice.h"
+
+namespace {
+
+// Same check as CPDF_RenderStatus does before drawing paths and text.
+bool IsAvailableMatrix(const CFX_Matrix& matrix) {
+  if (matrix.a == 0 || matrix.d == 0)
+    return matrix.b != 0 && matrix.c != 0;
+
+  if (matrix.b == 0 || matrix.c == 0)
+    return matrix.a != 0 && matrix.d != 0;
+
+  return true;
+}
+
+bool IsPatternColor(const CPDF_Color* pColor) {
+  return pColor && pColor->IsPattern();
+}
+
+// Whether drawing |pObj| involves CPDF_RenderStatus::ProcessTransparency() or
+// text clipping.
+bool NeedsTransparency(const CPDF_PageObject* pObj) {
+  return ToDictionary(pObj->m_GeneralState.GetSoftMask()) ||
+         pObj->m_GeneralState.GetBlendType() != BlendMode::kNormal ||
+         (pObj->m_ClipPath.HasRef() && pObj->m_ClipPath.GetTextCount() > 0);
+}
+
+bool Intersects(const CFX_FloatRect& bbox, const CFX_FloatRect& clip_rect) {
+  return bbox.left <= clip_rect.right && bbox.right >= clip_rect.left &&
+         bbox.bottom <= clip_rect.top && bbox.top >= clip_rect.bottom;
+}
+
+}  // namespace
+
+CPDF_DisplayList::Op::Op() = default;
+
+CPDF_DisplayList::Op::Op(Op&& that) = default;
+
+CPDF_DisplayList::Op::~Op() = default;
+
+// static
+std::unique_ptr<CPDF_DisplayList> CPDF_DisplayList::Build(
+    CPDF_RenderContext* pContext,
+    CFX_RenderDevice* pDevice,
+    CPDF_PageObjectHolder* pHolder,
+    const CPDF_RenderOptions& options) {
+  if (pHolder->GetParseState() != CPDF_PageObjectHolder::ParseState::kParsed)
+    return nullptr;
+
+  CPDF_RenderStatus status(pContext, pDevice);
+  status.SetOptions(options);
+  status.SetTransparency(pHolder->GetTransparency());
+  status.Initialize(nullptr, nullptr);
+
+  // Private ctor.
+  auto pList = std::unique_ptr<CPDF_DisplayList>(new CPDF_DisplayList());
+  pList->m_Transparency = pHolder->GetTransparency();
+  pList->m_Generation = pHolder->GetGeneration();
+  for (const auto& pObj : *pHolder) {
+    if (!pObj)
+      continue;
+
+    if (options.GetOCContext() &&
+        !options.GetOCContext()->CheckObjectVisible(pObj.get())) {
+      continue;
+    }
+
+    bool compiled = false;
+    if (!NeedsTransparency(pObj.get())) {
+      if (pObj->IsPath())
+        compiled = pList->CompilePath(status, pObj->AsPath());
+      else if (pObj->IsText())
+        compiled = pList->CompileText(status, pObj->AsText());
+    }
+    if (compiled)
+      continue;
+
+    Op op;
+    op.object = pObj.get();
+    op.bbox = pObj->GetRect();
+    pList->m_Ops.push_back(std::move(op));
+  }
+  return pList;
+}
+
+CPDF_DisplayList::CPDF_DisplayList() = default;
+
+CPDF_DisplayList::~CPDF_DisplayList() = default;
+
+bool CPDF_DisplayList::IsValidFor(const CPDF_PageObjectHolder* pHolder) const {
+  return pHolder->GetGeneration() == m_Generation;
+}
+
+bool CPDF_DisplayList::Render(CPDF_RenderContext* pContext,
+                              CFX_RenderDevice* pDevice,
+                              const CPDF_RenderOptions& options,
+                              const CFX_Matrix& mtObj2Device,
+                              PauseIndicatorIface* pPause,
+                              size_t* pNextOp) const {
+  CPDF_RenderStatus status(pContext, pDevice);
+  status.SetOptions(options);
+  status.SetTransparency(m_Transparency);
+  status.Initialize(nullptr, nullptr);
+
+  CFX_RenderDevice::StateRestorer restorer(pDevice);
+  CFX_FloatRect clip_rect = mtObj2Device.GetInverse().TransformRect(
+      CFX_FloatRect(pDevice->GetClipBox()));
+  size_t ops_to_go = kStepLimit;
+  while (*pNextOp < m_Ops.size()) {
+    if (ops_to_go == 0) {
+      if (pPause && pPause->NeedToPauseNow())
+        return false;
+      ops_to_go = kStepLimit;
+    }
+    const Op& op = m_Ops[(*pNextOp)++];
+    if (!Intersects(op.bbox, clip_rect))
+      continue;
+
+    // Like CPDF_ProgressiveRenderer, forms and shadings end a step.
+    const CPDF_PageObject* pObj = op.object;
+    ops_to_go = pObj->IsForm() || pObj->IsShading() ? 0 : ops_to_go - 1;
+
+    bool drawn = false;
+    if (op.type == Op::Type::kPath) {
+      status.ProcessClipPath(op.clip_path, mtObj2Device);
+      CFX_Matrix path_matrix = op.matrix * mtObj2Device;
+      if (!IsAvailableMatrix(path_matrix))
+        continue;
+
+      drawn = pDevice->DrawPathWithBlend(
+          op.path.GetObject(), &path_matrix, op.graph_state.GetObject(),
+          op.fill_argb, op.stroke_argb, op.fill_options, BlendMode::kNormal);
+    } else if (op.type == Op::Type::kText) {
+      status.ProcessClipPath(op.clip_path, mtObj2Device);
+      drawn = CPDF_TextRenderer::DrawCharPosList(
+          pDevice, op.char_pos, op.font.Get(), op.font_size,
+          op.matrix * mtObj2Device, op.fill_argb, options);
+    }
+    // Also covers compiled ops the device could not draw, which
+    // CPDF_RenderStatus knows how to fall back for.
+    if (!drawn)
+      status.RenderSingleObject(op.object, mtObj2Device);
+  }
+  return true;
+}
+
+size_t CPDF_DisplayList::GetCompiledOpCount() const {
+  return std::count_if(m_Ops.begin(), m_Ops.end(), [](const Op& op) {
+    return op.type != Op::Type::kObject;
+  });
+}
+
+bool CPDF_DisplayList::CompilePath(const CPDF_RenderStatus& status,
+                                   CPDF_PathObject* path_obj) {
+  CFX_FillRenderOptions::FillType fill_type = path_obj->filltype();
+  bool stroke = path_obj->stroke();
+  if (fill_type != CFX_FillRenderOptions::FillType::kNoFill &&
+      IsPatternColor(path_obj->m_ColorState.GetFillColor())) {
+    return false;
+  }
+  if (stroke && IsPatternColor(path_obj->m_ColorState.GetStrokeColor()))
+    return false;
+  if (fill_type == CFX_FillRenderOptions::FillType::kNoFill && !stroke)
+    return true;
+
+  // Mirrors CPDF_RenderStatus::ProcessPath().
+  const CPDF_RenderOptions& options = status.GetRenderOptions();
+  if (options.ColorModeIs(CPDF_RenderOptions::Type::kForcedColor) &&
+      options.GetOptions().bConvertFillToStroke &&
+      fill_type != CFX_FillRenderOptions::FillType::kNoFill) {
+    stroke = true;
+    fill_type = CFX_FillRenderOptions::FillType::kNoFill;
+  }
+
+  Op op;
+  op.type = Op::Type::kPath;
+  op.object = path_obj;
+  op.bbox = path_obj->GetRect();
+  op.clip_path = path_obj->m_ClipPath;
+  op.matrix = path_obj->matrix();
+  op.fill_argb = fill_type != CFX_FillRenderOptions::FillType::kNoFill
+                     ? status.GetFillArgb(path_obj)
+                     : 0;
+  op.path = path_obj->path();
+  op.graph_state = path_obj->m_GraphState;
+  op.stroke_argb = stroke ? status.GetStrokeArgb(path_obj) : 0;
+  op.fill_options = status.GetPathFillOptions(path_obj, fill_type, stroke);
+  m_Ops.push_back(std::move(op));
+  return true;
+}
+
+bool CPDF_DisplayList::CompileText(const CPDF_RenderStatus& status,
+                                   CPDF_TextObject* text_obj) {
+  if (text_obj->GetCharCodes().empty())
+    return true;
+
+  // Thumbnails draw small text as bars, depending on the device matrix.
+  if (status.GetRenderOptions().GetOptions().bThumbnail)
+    return false;
+
+  // Only plain filled text is compiled, as CPDF_RenderStatus::ProcessText()
+  // draws it with CPDF_TextRenderer::DrawNormalText().
+  RetainPtr<CPDF_Font> pFont = text_obj->m_TextState.GetFont();
+  if (pFont->IsType3Font())
+    return false;
+
+  switch (text_obj->m_TextState.GetTextMode()) {
+    case TextRenderingMode::MODE_INVISIBLE:
+    case TextRenderingMode::MODE_CLIP:
+      return true;
+    case TextRenderingMode::MODE_FILL:
+    case TextRenderingMode::MODE_FILL_CLIP:
+      break;
+    case TextRenderingMode::MODE_STROKE:
+    case TextRenderingMode::MODE_STROKE_CLIP:
+      if (pFont->HasFace())
+        return false;
+      break;
+    default:
+      return false;
+  }
+  if (IsPatternColor(text_obj->m_ColorState.GetFillColor()))
+    return false;
+
+  CFX_Matrix text_matrix = text_obj->GetTextMatrix();
+  if (!IsAvailableMatrix(text_matrix))
+    return true;
+
+  Op op;
+  op.type = Op::Type::kText;
+  op.object = text_obj;
+  op.bbox = text_obj->GetRect();
+  op.clip_path = text_obj->m_ClipPath;
+  op.matrix = text_matrix;
+  op.fill_argb = status.GetFillArgb(text_obj);
+  op.font_size = text_obj->m_TextState.GetFontSize();
+  op.char_pos = GetCharPosList(text_obj->GetCharCodes(),
+                               text_obj->GetCharPositions(), pFont.Get(),
+                               op.font_size);
+  op.font = std::move(pFont);
+  if (!op.char_pos.empty())
+    m_Ops.push_back(std::move(op));
+  return true;
+}
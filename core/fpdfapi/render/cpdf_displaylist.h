@@ -0,0 +1,122 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_RENDER_CPDF_DISPLAYLIST_H_
+#define CORE_FPDFAPI_RENDER_CPDF_DISPLAYLIST_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "core/fpdfapi/page/cpdf_clippath.h"
+#include "core/fpdfapi/page/cpdf_path.h"
+#include "core/fpdfapi/page/cpdf_transparency.h"
+#include "core/fxcrt/fx_coordinates.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxge/cfx_fillrenderoptions.h"
+#include "core/fxge/cfx_graphstate.h"
+#include "core/fxge/dib/fx_dib.h"
+#include "core/fxge/text_char_pos.h"
+
+class CFX_RenderDevice;
+class CPDF_Font;
+class CPDF_PageObject;
+class CPDF_PageObjectHolder;
+class CPDF_PathObject;
+class CPDF_RenderContext;
+class CPDF_RenderOptions;
+class CPDF_RenderStatus;
+class CPDF_TextObject;
+class PauseIndicatorIface;
+
+// The objects of a page object holder compiled into a flat list of draw
+// operations, so the holder can be rendered again under any matrix without
+// walking its objects. Path and text objects are stored with their colors,
+// fill options and glyph positions already resolved. All other objects, and
+// paths and text that need patterns, transparency or text clipping, are
+// kept as references and go through CPDF_RenderStatus on every render.
+//
+// A list refers to the objects of its holder and holds the colors resolved
+// with the options it was built with, so callers must only reuse it with the
+// same options, and must check IsValidFor() before each render.
+class CPDF_DisplayList {
+ public:
+  // Returns nullptr if |pHolder| is not fully parsed.
+  static std::unique_ptr<CPDF_DisplayList> Build(
+      CPDF_RenderContext* pContext,
+      CFX_RenderDevice* pDevice,
+      CPDF_PageObjectHolder* pHolder,
+      const CPDF_RenderOptions& options);
+
+  ~CPDF_DisplayList();
+
+  // Returns false once objects have been added to, removed from, or changed
+  // in |pHolder| since the list was built from it, as told by
+  // CPDF_PageObjectHolder::GetGeneration().
+  bool IsValidFor(const CPDF_PageObjectHolder* pHolder) const;
+
+  // Renders the list the same way CPDF_RenderContext renders a layer for the
+  // holder with |mtObj2Device|, starting at op |*pNextOp|. Returns true once
+  // all ops are rendered. Returns false when |pPause| asks to pause, with
+  // |*pNextOp| set to where to continue.
+  bool Render(CPDF_RenderContext* pContext,
+              CFX_RenderDevice* pDevice,
+              const CPDF_RenderOptions& options,
+              const CFX_Matrix& mtObj2Device,
+              PauseIndicatorIface* pPause,
+              size_t* pNextOp) const;
+
+  size_t GetOpCount() const { return m_Ops.size(); }
+  size_t GetCompiledOpCount() const;
+
+ private:
+  struct Op {
+    enum class Type : uint8_t { kPath, kText, kObject };
+
+    Op();
+    Op(Op&& that);
+    ~Op();
+
+    Type type = Type::kObject;
+    // Not an UnownedPtr, as the holder may free the object while the list
+    // is cached. Only dereferenced while IsValidFor() the holder, which
+    // stops being the case once the object is removed.
+    CPDF_PageObject* object = nullptr;
+    CFX_FloatRect bbox;
+    CPDF_ClipPath clip_path;
+    // The path or text matrix.
+    CFX_Matrix matrix;
+    FX_ARGB fill_argb = 0;
+
+    // kPath only.
+    CPDF_Path path;
+    CFX_GraphState graph_state;
+    FX_ARGB stroke_argb = 0;
+    CFX_FillRenderOptions fill_options;
+
+    // kText only.
+    RetainPtr<CPDF_Font> font;
+    float font_size = 0;
+    std::vector<TextCharPos> char_pos;
+  };
+
+  // Ops to render before checking for pause, like CPDF_ProgressiveRenderer.
+  static constexpr size_t kStepLimit = 100;
+
+  CPDF_DisplayList();
+
+  // Each returns false if the object must go through CPDF_RenderStatus.
+  // Otherwise appends the op for the object, if it draws anything.
+  bool CompilePath(const CPDF_RenderStatus& status,
+                   CPDF_PathObject* path_obj);
+  bool CompileText(const CPDF_RenderStatus& status, CPDF_TextObject* text_obj);
+
+  CPDF_Transparency m_Transparency;
+  uint32_t m_Generation = 0;
+  std::vector<Op> m_Ops;
+};
+
+#endif  // CORE_FPDFAPI_RENDER_CPDF_DISPLAYLIST_H_
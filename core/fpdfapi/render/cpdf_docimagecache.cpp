@@ -0,0 +1,42 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/render/cpdf_docimagecache.h"
+
+#include <tuple>
+
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fxge/dib/cfx_dibbase.h"
+
+CPDF_DocImageCacheKey::CPDF_DocImageCacheKey() = default;
+
+CPDF_DocImageCacheKey::CPDF_DocImageCacheKey(
+    const CPDF_DocImageCacheKey& that) = default;
+
+CPDF_DocImageCacheKey::~CPDF_DocImageCacheKey() = default;
+
+bool CPDF_DocImageCacheKey::operator<(const CPDF_DocImageCacheKey& that) const {
+  return std::tie(stream, color_spaces, group_family, std_cs, load_mask) <
+         std::tie(that.stream, that.color_spaces, that.group_family,
+                  that.std_cs, that.load_mask);
+}
+
+CPDF_DocImageCacheValue::CPDF_DocImageCacheValue() = default;
+
+CPDF_DocImageCacheValue::CPDF_DocImageCacheValue(
+    const CPDF_DocImageCacheValue& that) = default;
+
+CPDF_DocImageCacheValue::~CPDF_DocImageCacheValue() = default;
+
+// An image is decoded in full whether or not it is cached, so any image
+// within the budget is worth keeping.
+CPDF_DocImageCache::CPDF_DocImageCache()
+    : LruCache(kDefaultMaxBytes, /*max_value_share=*/1) {}
+
+CPDF_DocImageCache::~CPDF_DocImageCache() = default;
+
+void CPDF_DocImageCache::Remove(const CPDF_Stream* pStream) {
+  RemoveIf([pStream](const Key& key) { return key.stream == pStream; });
+}
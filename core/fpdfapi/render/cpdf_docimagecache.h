@@ -0,0 +1,64 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_RENDER_CPDF_DOCIMAGECACHE_H_
+#define CORE_FPDFAPI_RENDER_CPDF_DOCIMAGECACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "core/fpdfapi/page/cpdf_colorspace.h"
+#include "core/fxcrt/lru_cache.h"
+#include "core/fxcrt/retain_ptr.h"
+
+class CFX_DIBBase;
+class CPDF_Dictionary;
+class CPDF_Stream;
+
+// The image stream and everything else CPDF_DIB::StartLoadDIBBase() uses to
+// decode it. Named color spaces resolve through the page resources, so only
+// pages sharing a /ColorSpace resource dictionary share decodes.
+struct CPDF_DocImageCacheKey {
+  CPDF_DocImageCacheKey();
+  CPDF_DocImageCacheKey(const CPDF_DocImageCacheKey& that);
+  ~CPDF_DocImageCacheKey();
+
+  bool operator<(const CPDF_DocImageCacheKey& that) const;
+
+  RetainPtr<const CPDF_Stream> stream;
+  RetainPtr<const CPDF_Dictionary> color_spaces;
+  CPDF_ColorSpace::Family group_family = CPDF_ColorSpace::Family::kUnknown;
+  bool std_cs = false;
+  bool load_mask = false;
+};
+
+// A decoded image. The bitmaps are shared by everyone who looked the image
+// up, so they must not be modified.
+struct CPDF_DocImageCacheValue {
+  CPDF_DocImageCacheValue();
+  CPDF_DocImageCacheValue(const CPDF_DocImageCacheValue& that);
+  ~CPDF_DocImageCacheValue();
+
+  RetainPtr<CFX_DIBBase> bitmap;
+  RetainPtr<CFX_DIBBase> mask;
+  uint32_t matte_color = 0;
+};
+
+// Document-wide cache of decoded images. CPDF_PageRenderCache only keeps
+// images for as long as its page is loaded, so this lets pages that share an
+// image, such as a background, reuse one decode. Every open document has its
+// own cache, so it is off until the embedder gives it a budget.
+class CPDF_DocImageCache final
+    : public LruCache<CPDF_DocImageCacheKey, CPDF_DocImageCacheValue> {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 0;
+
+  CPDF_DocImageCache();
+  ~CPDF_DocImageCache();
+
+  // Removes all cached decodes of |pStream|, e.g. after it was modified.
+  void Remove(const CPDF_Stream* pStream);
+};
+
+#endif  // CORE_FPDFAPI_RENDER_CPDF_DOCIMAGECACHE_H_
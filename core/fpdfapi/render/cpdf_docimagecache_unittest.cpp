@@ -0,0 +1,126 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/render/cpdf_docimagecache.h"
+
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+CPDF_DocImageCache::Value CreateImage() {
+  auto pBitmap = pdfium::MakeRetain<CFX_DIBitmap>();
+  EXPECT_TRUE(pBitmap->Create(10, 10, FXDIB_Format::kRgb32));
+  CPDF_DocImageCache::Value image;
+  image.bitmap = pBitmap;
+  return image;
+}
+
+CPDF_DocImageCache::Key CreateKey(const RetainPtr<CPDF_Stream>& pStream) {
+  CPDF_DocImageCache::Key key;
+  key.stream = pStream;
+  return key;
+}
+
+}  // namespace
+
+TEST(CPDF_DocImageCache, LookupAndAdd) {
+  auto pStream = pdfium::MakeRetain<CPDF_Stream>();
+  CPDF_DocImageCache cache;
+  EXPECT_EQ(0u, cache.GetMaxBytes());
+  EXPECT_FALSE(cache.CanCache(400));
+  cache.SetMaxBytes(4000);
+  CPDF_DocImageCache::Value image;
+  CPDF_DocImageCache::Key key = CreateKey(pStream);
+  EXPECT_FALSE(cache.Lookup(key, &image));
+
+  CPDF_DocImageCache::Value added = CreateImage();
+  added.matte_color = 0xff00ff;
+  cache.Add(key, added, 400);
+  EXPECT_TRUE(cache.Lookup(key, &image));
+  EXPECT_EQ(added.bitmap, image.bitmap);
+  EXPECT_FALSE(image.mask);
+  EXPECT_EQ(0xff00ffu, image.matte_color);
+
+  // The decode parameters are part of the key.
+  CPDF_DocImageCache::Key std_cs_key = key;
+  std_cs_key.std_cs = true;
+  EXPECT_FALSE(cache.Lookup(std_cs_key, &image));
+  CPDF_DocImageCache::Key group_key = key;
+  group_key.group_family = CPDF_ColorSpace::Family::kDeviceCMYK;
+  EXPECT_FALSE(cache.Lookup(group_key, &image));
+  CPDF_DocImageCache::Key color_spaces_key = key;
+  color_spaces_key.color_spaces = pdfium::MakeRetain<CPDF_Dictionary>();
+  EXPECT_FALSE(cache.Lookup(color_spaces_key, &image));
+
+  CPDF_DocImageCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(1u, stats.hits);
+  EXPECT_EQ(4u, stats.misses);
+  EXPECT_EQ(0u, stats.evictions);
+  EXPECT_EQ(400u, stats.bytes);
+  EXPECT_EQ(1u, stats.entries);
+
+  cache.ResetCounters();
+  stats = cache.GetStats();
+  EXPECT_EQ(0u, stats.hits);
+  EXPECT_EQ(0u, stats.misses);
+  EXPECT_EQ(400u, stats.bytes);
+}
+
+TEST(CPDF_DocImageCache, EvictLeastRecentlyUsed) {
+  RetainPtr<CPDF_Stream> streams[4];
+  for (auto& pStream : streams)
+    pStream = pdfium::MakeRetain<CPDF_Stream>();
+
+  CPDF_DocImageCache cache;
+  cache.SetMaxBytes(1200);
+  CPDF_DocImageCache::Value image;
+  for (int i = 0; i < 3; ++i)
+    cache.Add(CreateKey(streams[i]), CreateImage(), 400);
+
+  // Touch the first image, so the second one is evicted next.
+  EXPECT_TRUE(cache.Lookup(CreateKey(streams[0]), &image));
+  cache.Add(CreateKey(streams[3]), CreateImage(), 400);
+  CPDF_DocImageCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(1u, stats.evictions);
+  EXPECT_EQ(1200u, stats.bytes);
+  EXPECT_EQ(3u, stats.entries);
+  EXPECT_TRUE(cache.Lookup(CreateKey(streams[0]), &image));
+  EXPECT_FALSE(cache.Lookup(CreateKey(streams[1]), &image));
+
+  // Too large to cache.
+  cache.Add(CreateKey(streams[1]), CreateImage(), 1201);
+  EXPECT_FALSE(cache.Lookup(CreateKey(streams[1]), &image));
+
+  cache.SetMaxBytes(0);
+  stats = cache.GetStats();
+  EXPECT_EQ(4u, stats.evictions);
+  EXPECT_EQ(0u, stats.bytes);
+  EXPECT_EQ(0u, stats.entries);
+}
+
+TEST(CPDF_DocImageCache, RemoveStream) {
+  auto pStream = pdfium::MakeRetain<CPDF_Stream>();
+  auto pOtherStream = pdfium::MakeRetain<CPDF_Stream>();
+  CPDF_DocImageCache cache;
+  cache.SetMaxBytes(4000);
+  CPDF_DocImageCache::Key key = CreateKey(pStream);
+  CPDF_DocImageCache::Key mask_key = key;
+  mask_key.load_mask = true;
+  cache.Add(key, CreateImage(), 400);
+  cache.Add(mask_key, CreateImage(), 400);
+  cache.Add(CreateKey(pOtherStream), CreateImage(), 400);
+
+  cache.Remove(pStream.Get());
+  CPDF_DocImageCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(0u, stats.evictions);
+  EXPECT_EQ(400u, stats.bytes);
+  EXPECT_EQ(1u, stats.entries);
+  CPDF_DocImageCache::Value image;
+  EXPECT_FALSE(cache.Lookup(key, &image));
+  EXPECT_FALSE(cache.Lookup(mask_key, &image));
+  EXPECT_TRUE(cache.Lookup(CreateKey(pOtherStream), &image));
+}
@@ -18,7 +18,11 @@
 #include "core/fpdfapi/page/cpdf_transferfunc.h"
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdfapi/render/cpdf_docimagecache.h"
+#include "core/fpdfapi/render/cpdf_formbitmapcache.h"
+#include "core/fpdfapi/render/cpdf_tilingcellcache.h"
 #include "core/fpdfapi/render/cpdf_type3cache.h"
+#include "core/fpdfapi/render/cpdf_type3glyphcache.h"
 
 namespace {
 
@@ -61,6 +65,30 @@ RetainPtr<CPDF_TransferFunc> CPDF_DocRenderData::GetTransferFunc(
   return pFunc;
 }
 
+CPDF_FormBitmapCache* CPDF_DocRenderData::GetFormBitmapCache() {
+  if (!m_pFormBitmapCache)
+    m_pFormBitmapCache = std::make_unique<CPDF_FormBitmapCache>();
+  return m_pFormBitmapCache.get();
+}
+
+CPDF_DocImageCache* CPDF_DocRenderData::GetImageCache() {
+  if (!m_pImageCache)
+    m_pImageCache = std::make_unique<CPDF_DocImageCache>();
+  return m_pImageCache.get();
+}
+
+CPDF_TilingCellCache* CPDF_DocRenderData::GetTilingCellCache() {
+  if (!m_pTilingCellCache)
+    m_pTilingCellCache = std::make_unique<CPDF_TilingCellCache>();
+  return m_pTilingCellCache.get();
+}
+
+CPDF_Type3GlyphCache* CPDF_DocRenderData::GetType3GlyphCache() {
+  if (!m_pType3GlyphCache)
+    m_pType3GlyphCache = std::make_unique<CPDF_Type3GlyphCache>();
+  return m_pType3GlyphCache.get();
+}
+
 RetainPtr<CPDF_TransferFunc> CPDF_DocRenderData::CreateTransferFunc(
     const CPDF_Object* pObj) const {
   std::unique_ptr<CPDF_Function> pFuncs[3];
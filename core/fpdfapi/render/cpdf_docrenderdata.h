@@ -8,16 +8,21 @@
 #define CORE_FPDFAPI_RENDER_CPDF_DOCRENDERDATA_H_
 
 #include <map>
+#include <memory>
 
 #include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fxcrt/observed_ptr.h"
 #include "core/fxcrt/retain_ptr.h"
 
+class CPDF_DocImageCache;
 class CPDF_Font;
+class CPDF_FormBitmapCache;
 class CPDF_Object;
+class CPDF_TilingCellCache;
 class CPDF_TransferFunc;
 class CPDF_Type3Cache;
 class CPDF_Type3Font;
+class CPDF_Type3GlyphCache;
 
 class CPDF_DocRenderData : public CPDF_Document::RenderDataIface {
  public:
@@ -31,6 +36,10 @@ class CPDF_DocRenderData : public CPDF_Document::RenderDataIface {
 
   RetainPtr<CPDF_Type3Cache> GetCachedType3(CPDF_Type3Font* pFont);
   RetainPtr<CPDF_TransferFunc> GetTransferFunc(const CPDF_Object* pObj);
+  CPDF_FormBitmapCache* GetFormBitmapCache();
+  CPDF_DocImageCache* GetImageCache();
+  CPDF_TilingCellCache* GetTilingCellCache();
+  CPDF_Type3GlyphCache* GetType3GlyphCache();
 
  protected:
   // protected for use by test subclasses.
@@ -41,6 +50,10 @@ class CPDF_DocRenderData : public CPDF_Document::RenderDataIface {
   std::map<CPDF_Font*, ObservedPtr<CPDF_Type3Cache>> m_Type3FaceMap;
   std::map<const CPDF_Object*, ObservedPtr<CPDF_TransferFunc>>
       m_TransferFuncMap;
+  std::unique_ptr<CPDF_FormBitmapCache> m_pFormBitmapCache;
+  std::unique_ptr<CPDF_DocImageCache> m_pImageCache;
+  std::unique_ptr<CPDF_TilingCellCache> m_pTilingCellCache;
+  std::unique_ptr<CPDF_Type3GlyphCache> m_pType3GlyphCache;
 };
 
 #endif  // CORE_FPDFAPI_RENDER_CPDF_DOCRENDERDATA_H_
@@ -0,0 +1,39 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/render/cpdf_formbitmapcache.h"
+
+#include <tuple>
+
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+
+CPDF_FormBitmapCacheKey::CPDF_FormBitmapCacheKey() = default;
+
+CPDF_FormBitmapCacheKey::CPDF_FormBitmapCacheKey(
+    const CPDF_FormBitmapCacheKey& that) = default;
+
+CPDF_FormBitmapCacheKey::~CPDF_FormBitmapCacheKey() = default;
+
+bool CPDF_FormBitmapCacheKey::operator<(
+    const CPDF_FormBitmapCacheKey& that) const {
+  return std::tie(stream, resources, matrix, options, fill_color, stroke_color,
+                  fill_alpha, stroke_alpha, stroke_adjust, line_width,
+                  miter_limit, dash_phase, line_cap, line_join, dash_array,
+                  font_dict, font_size, char_space, word_space, text_mode) <
+         std::tie(that.stream, that.resources, that.matrix, that.options,
+                  that.fill_color, that.stroke_color, that.fill_alpha,
+                  that.stroke_alpha, that.stroke_adjust, that.line_width,
+                  that.miter_limit, that.dash_phase, that.line_cap,
+                  that.line_join, that.dash_array, that.font_dict,
+                  that.font_size, that.char_space, that.word_space,
+                  that.text_mode);
+}
+
+// Leave room for a few forms, so one large form does not flush the rest.
+CPDF_FormBitmapCache::CPDF_FormBitmapCache()
+    : LruCache(kDefaultMaxBytes, /*max_value_share=*/4) {}
+
+CPDF_FormBitmapCache::~CPDF_FormBitmapCache() = default;
@@ -0,0 +1,66 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_RENDER_CPDF_FORMBITMAPCACHE_H_
+#define CORE_FPDFAPI_RENDER_CPDF_FORMBITMAPCACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <vector>
+
+#include "core/fxcrt/lru_cache.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxge/dib/fx_dib.h"
+
+class CFX_DIBitmap;
+class CPDF_Dictionary;
+class CPDF_Stream;
+
+// Everything a rendered form depends on besides its integer device offset:
+// the form stream and resources, the form to bitmap matrix, the graphics
+// state the form inherits, and the render options. Only forms whose objects
+// are still as parsed from the stream may be cached.
+struct CPDF_FormBitmapCacheKey {
+  CPDF_FormBitmapCacheKey();
+  CPDF_FormBitmapCacheKey(const CPDF_FormBitmapCacheKey& that);
+  ~CPDF_FormBitmapCacheKey();
+
+  bool operator<(const CPDF_FormBitmapCacheKey& that) const;
+
+  RetainPtr<const CPDF_Stream> stream;
+  RetainPtr<const CPDF_Dictionary> resources;
+  std::array<float, 6> matrix = {};
+  uint32_t options = 0;
+  FX_COLORREF fill_color = 0;
+  FX_COLORREF stroke_color = 0;
+  float fill_alpha = 0;
+  float stroke_alpha = 0;
+  bool stroke_adjust = false;
+  float line_width = 0;
+  float miter_limit = 0;
+  float dash_phase = 0;
+  int line_cap = 0;
+  int line_join = 0;
+  std::vector<float> dash_array;
+  RetainPtr<const CPDF_Dictionary> font_dict;
+  float font_size = 0;
+  float char_space = 0;
+  float word_space = 0;
+  int text_mode = 0;
+};
+
+// Document-wide cache of Form XObjects rendered into ARGB bitmaps, so a form
+// drawn the same way on many pages is only rasterized once.
+class CPDF_FormBitmapCache final
+    : public LruCache<CPDF_FormBitmapCacheKey, RetainPtr<CFX_DIBitmap>> {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 32 * 1024 * 1024;
+
+  CPDF_FormBitmapCache();
+  ~CPDF_FormBitmapCache();
+};
+
+#endif  // CORE_FPDFAPI_RENDER_CPDF_FORMBITMAPCACHE_H_
@@ -0,0 +1,112 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/render/cpdf_formbitmapcache.h"
+
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+RetainPtr<CFX_DIBitmap> CreateBitmap(int width, int height) {
+  auto pBitmap = pdfium::MakeRetain<CFX_DIBitmap>();
+  EXPECT_TRUE(pBitmap->Create(width, height, FXDIB_Format::kArgb));
+  return pBitmap;
+}
+
+void AddBitmap(CPDF_FormBitmapCache* cache,
+               const CPDF_FormBitmapCache::Key& key,
+               const RetainPtr<CFX_DIBitmap>& pBitmap) {
+  cache->Add(key, pBitmap, pBitmap->GetPitch() * pBitmap->GetHeight());
+}
+
+bool IsCached(CPDF_FormBitmapCache* cache,
+              const CPDF_FormBitmapCache::Key& key) {
+  RetainPtr<CFX_DIBitmap> pBitmap;
+  return cache->Lookup(key, &pBitmap);
+}
+
+CPDF_FormBitmapCache::Key CreateKey(const RetainPtr<CPDF_Stream>& pStream,
+                                    float scale) {
+  CPDF_FormBitmapCache::Key key;
+  key.stream = pStream;
+  key.matrix = {scale, 0, 0, scale, 0, 0};
+  return key;
+}
+
+}  // namespace
+
+TEST(CPDF_FormBitmapCache, LookupAndAdd) {
+  auto pStream = pdfium::MakeRetain<CPDF_Stream>();
+  CPDF_FormBitmapCache cache;
+  CPDF_FormBitmapCache::Key key = CreateKey(pStream, 1);
+  EXPECT_FALSE(IsCached(&cache, key));
+
+  RetainPtr<CFX_DIBitmap> pBitmap = CreateBitmap(10, 10);
+  AddBitmap(&cache, key, pBitmap);
+  RetainPtr<CFX_DIBitmap> pFound;
+  ASSERT_TRUE(cache.Lookup(key, &pFound));
+  EXPECT_EQ(pBitmap, pFound);
+
+  // Any difference in the key is a different entry.
+  EXPECT_FALSE(IsCached(&cache, CreateKey(pStream, 2)));
+  CPDF_FormBitmapCache::Key other_color = key;
+  other_color.fill_color = 0xff;
+  EXPECT_FALSE(IsCached(&cache, other_color));
+  CPDF_FormBitmapCache::Key other_stroke_adjust = key;
+  other_stroke_adjust.stroke_adjust = true;
+  EXPECT_FALSE(IsCached(&cache, other_stroke_adjust));
+  EXPECT_FALSE(
+      IsCached(&cache, CreateKey(pdfium::MakeRetain<CPDF_Stream>(), 1)));
+
+  CPDF_FormBitmapCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(1u, stats.hits);
+  EXPECT_EQ(5u, stats.misses);
+  EXPECT_EQ(0u, stats.evictions);
+  EXPECT_EQ(400u, stats.bytes);
+  EXPECT_EQ(1u, stats.entries);
+
+  cache.ResetCounters();
+  stats = cache.GetStats();
+  EXPECT_EQ(0u, stats.hits);
+  EXPECT_EQ(0u, stats.misses);
+  EXPECT_EQ(400u, stats.bytes);
+  EXPECT_EQ(1u, stats.entries);
+}
+
+TEST(CPDF_FormBitmapCache, EvictLeastRecentlyUsed) {
+  auto pStream = pdfium::MakeRetain<CPDF_Stream>();
+  CPDF_FormBitmapCache cache;
+  cache.SetMaxBytes(1600);
+  EXPECT_TRUE(cache.CanCache(400));
+  EXPECT_FALSE(cache.CanCache(401));
+  EXPECT_FALSE(cache.CanCache(0));
+
+  for (int i = 1; i <= 4; ++i)
+    AddBitmap(&cache, CreateKey(pStream, i), CreateBitmap(10, 10));
+  EXPECT_EQ(4u, cache.GetStats().entries);
+
+  // Touch the first entry, so the second one is evicted next.
+  EXPECT_TRUE(IsCached(&cache, CreateKey(pStream, 1)));
+  AddBitmap(&cache, CreateKey(pStream, 5), CreateBitmap(10, 10));
+  CPDF_FormBitmapCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(1u, stats.evictions);
+  EXPECT_EQ(1600u, stats.bytes);
+  EXPECT_EQ(4u, stats.entries);
+  EXPECT_TRUE(IsCached(&cache, CreateKey(pStream, 1)));
+  EXPECT_FALSE(IsCached(&cache, CreateKey(pStream, 2)));
+
+  // Too large to cache.
+  AddBitmap(&cache, CreateKey(pStream, 6), CreateBitmap(20, 20));
+  EXPECT_FALSE(IsCached(&cache, CreateKey(pStream, 6)));
+  EXPECT_EQ(4u, cache.GetStats().entries);
+
+  cache.SetMaxBytes(0);
+  stats = cache.GetStats();
+  EXPECT_EQ(5u, stats.evictions);
+  EXPECT_EQ(0u, stats.bytes);
+  EXPECT_EQ(0u, stats.entries);
+}
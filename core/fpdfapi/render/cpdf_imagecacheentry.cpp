@@ -15,6 +15,7 @@
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/render/cpdf_docrenderdata.h"
 #include "core/fpdfapi/render/cpdf_pagerendercache.h"
 #include "core/fpdfapi/render/cpdf_rendercontext.h"
 #include "core/fpdfapi/render/cpdf_renderstatus.h"
@@ -65,6 +66,33 @@ CPDF_DIB::LoadState CPDF_ImageCacheEntry::StartGetCachedBitmap(
     return CPDF_DIB::LoadState::kSuccess;
   }
 
+  // Inline images resolve their resources through the enclosing form, so
+  // only share decodes of image XObjects.
+  m_bUseDocCache =
+      !m_pImage->IsInline() && GetDocImageCache()->GetMaxBytes() > 0;
+  if (m_bUseDocCache) {
+    m_DocCacheKey.stream.Reset(m_pImage->GetStream());
+    m_DocCacheKey.color_spaces.Reset(
+        pPageResources ? pPageResources->GetDictFor("ColorSpace") : nullptr);
+    m_DocCacheKey.group_family = pRenderStatus->GetGroupFamily();
+    m_DocCacheKey.std_cs = bStdCS;
+    m_DocCacheKey.load_mask = pRenderStatus->GetLoadMask();
+
+    CPDF_DocImageCache::Value image;
+    if (GetDocImageCache()->Lookup(m_DocCacheKey, &image)) {
+      m_pCachedBitmap = std::move(image.bitmap);
+      m_pCachedMask = std::move(image.mask);
+      m_MatteColor = image.matte_color;
+      m_dwTimeCount =
+          pRenderStatus->GetContext()->GetPageCache()->GetTimeCount();
+      m_pCurBitmap = m_pCachedBitmap;
+      m_pCurMask = m_pCachedMask;
+      CalcSize();
+      // Same as a synchronous decode, so the page cache accounts for it.
+      return CPDF_DIB::LoadState::kFail;
+    }
+  }
+
   m_pCurBitmap = pdfium::MakeRetain<CPDF_DIB>();
   CPDF_DIB::LoadState ret = m_pCurBitmap.As<CPDF_DIB>()->StartLoadDIBBase(
       m_pDocument.Get(), m_pImage->GetStream(), true,
@@ -101,7 +129,9 @@ void CPDF_ImageCacheEntry::ContinueGetCachedBitmap(
   CPDF_RenderContext* pContext = pRenderStatus->GetContext();
   CPDF_PageRenderCache* pPageRenderCache = pContext->GetPageCache();
   m_dwTimeCount = pPageRenderCache->GetTimeCount();
-  if (m_pCurBitmap->GetPitch() * m_pCurBitmap->GetHeight() < kHugeImageSize) {
+  bool bDecoded =
+      m_pCurBitmap->GetPitch() * m_pCurBitmap->GetHeight() < kHugeImageSize;
+  if (bDecoded) {
     m_pCachedBitmap = m_pCurBitmap->Clone(nullptr);
     m_pCurBitmap.Reset();
   } else {
@@ -114,9 +144,22 @@ void CPDF_ImageCacheEntry::ContinueGetCachedBitmap(
   m_pCurBitmap = m_pCachedBitmap;
   m_pCurMask = m_pCachedMask;
   CalcSize();
+
+  // Huge images stay streamed from the CPDF_DIB and are not worth sharing.
+  if (m_bUseDocCache && bDecoded && m_pCachedBitmap) {
+    CPDF_DocImageCache::Value image;
+    image.bitmap = m_pCachedBitmap;
+    image.mask = m_pCachedMask;
+    image.matte_color = m_MatteColor;
+    GetDocImageCache()->Add(m_DocCacheKey, image, m_dwCacheSize);
+  }
 }
 
 void CPDF_ImageCacheEntry::CalcSize() {
   m_dwCacheSize = GetEstimatedImageSize(m_pCachedBitmap) +
                   GetEstimatedImageSize(m_pCachedMask);
 }
+
+CPDF_DocImageCache* CPDF_ImageCacheEntry::GetDocImageCache() const {
+  return CPDF_DocRenderData::FromDocument(m_pDocument.Get())->GetImageCache();
+}
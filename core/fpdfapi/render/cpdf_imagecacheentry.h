@@ -10,6 +10,7 @@
 #include <stdint.h>
 
 #include "core/fpdfapi/page/cpdf_dib.h"
+#include "core/fpdfapi/render/cpdf_docimagecache.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/unowned_ptr.h"
 
@@ -46,16 +47,19 @@ class CPDF_ImageCacheEntry {
  private:
   void ContinueGetCachedBitmap(const CPDF_RenderStatus* pRenderStatus);
   void CalcSize();
+  CPDF_DocImageCache* GetDocImageCache() const;
 
   uint32_t m_dwTimeCount = 0;
   uint32_t m_MatteColor = 0;
   uint32_t m_dwCacheSize = 0;
+  bool m_bUseDocCache = false;
   UnownedPtr<CPDF_Document> const m_pDocument;
   RetainPtr<CPDF_Image> const m_pImage;
   RetainPtr<CFX_DIBBase> m_pCurBitmap;
   RetainPtr<CFX_DIBBase> m_pCurMask;
   RetainPtr<CFX_DIBBase> m_pCachedBitmap;
   RetainPtr<CFX_DIBBase> m_pCachedMask;
+  CPDF_DocImageCache::Key m_DocCacheKey;
 };
 
 #endif  // CORE_FPDFAPI_RENDER_CPDF_IMAGECACHEENTRY_H_
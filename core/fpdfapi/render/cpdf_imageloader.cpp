@@ -23,8 +23,10 @@ CPDF_ImageLoader::~CPDF_ImageLoader() = default;
 
 bool CPDF_ImageLoader::Start(const CPDF_ImageObject* pImage,
                              const CPDF_RenderStatus* pRenderStatus,
-                             bool bStdCS) {
-  m_pCache = pRenderStatus->GetContext()->GetPageCache();
+                             bool bStdCS,
+                             const CFX_Size& min_decode_size) {
+  const bool bReduced = min_decode_size.width > 0 && min_decode_size.height > 0;
+  m_pCache = bReduced ? nullptr : pRenderStatus->GetContext()->GetPageCache();
   m_pImageObject = pImage;
   bool ret;
   if (m_pCache) {
@@ -33,7 +35,8 @@ bool CPDF_ImageLoader::Start(const CPDF_ImageObject* pImage,
   } else {
     ret = m_pImageObject->GetImage()->StartLoadDIBBase(
         pRenderStatus->GetFormResource(), pRenderStatus->GetPageResource(),
-        bStdCS, pRenderStatus->GetGroupFamily(), pRenderStatus->GetLoadMask());
+        bStdCS, pRenderStatus->GetGroupFamily(), pRenderStatus->GetLoadMask(),
+        min_decode_size);
   }
   if (!ret)
     HandleFailure();
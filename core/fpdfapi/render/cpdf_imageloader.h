@@ -7,6 +7,7 @@
 #ifndef CORE_FPDFAPI_RENDER_CPDF_IMAGELOADER_H_
 #define CORE_FPDFAPI_RENDER_CPDF_IMAGELOADER_H_
 
+#include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/unowned_ptr.h"
 
@@ -22,9 +23,12 @@ class CPDF_ImageLoader {
   CPDF_ImageLoader();
   ~CPDF_ImageLoader();
 
+  // A non-empty |min_decode_size| allows a reduced size decode, which
+  // bypasses the image caches.
   bool Start(const CPDF_ImageObject* pImage,
              const CPDF_RenderStatus* pRenderStatus,
-             bool bStdCS);
+             bool bStdCS,
+             const CFX_Size& min_decode_size);
   bool Continue(PauseIndicatorIface* pPause, CPDF_RenderStatus* pRenderStatus);
 
   RetainPtr<CFX_DIBBase> TranslateImage(
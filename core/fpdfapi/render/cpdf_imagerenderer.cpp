@@ -66,8 +66,18 @@ bool CPDF_ImageRenderer::StartLoadDIBBase() {
   if (!GetUnitRect().has_value())
     return false;
 
-  if (!m_Loader.Start(m_pImageObject.Get(), m_pRenderStatus.Get(), m_bStdCS))
+  // Thumbnails only need images at about their device size.
+  CFX_Size min_decode_size;
+  if (GetRenderOptions().GetOptions().bThumbnail) {
+    min_decode_size.width =
+        std::max(1, static_cast<int>(ceilf(m_ImageMatrix.GetXUnit())));
+    min_decode_size.height =
+        std::max(1, static_cast<int>(ceilf(m_ImageMatrix.GetYUnit())));
+  }
+  if (!m_Loader.Start(m_pImageObject.Get(), m_pRenderStatus.Get(), m_bStdCS,
+                      min_decode_size)) {
     return false;
+  }
 
   m_Mode = Mode::kDefault;
   return true;
@@ -7,10 +7,14 @@
 #include "core/fpdfapi/render/cpdf_pagerendercache.h"
 
 #include <algorithm>
+#include <utility>
 #include <vector>
 
 #include "core/fpdfapi/page/cpdf_image.h"
 #include "core/fpdfapi/page/cpdf_page.h"
+#include "core/fpdfapi/render/cpdf_displaylist.h"
+#include "core/fpdfapi/render/cpdf_docimagecache.h"
+#include "core/fpdfapi/render/cpdf_docrenderdata.h"
 #include "core/fpdfapi/render/cpdf_imagecacheentry.h"
 #include "core/fpdfapi/render/cpdf_renderstatus.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
@@ -114,10 +118,25 @@ bool CPDF_PageRenderCache::Continue(PauseIndicatorIface* pPause,
   return false;
 }
 
+CPDF_DisplayList* CPDF_PageRenderCache::GetDisplayList(uint32_t key) const {
+  return key == m_DisplayListKey ? m_pDisplayList.get() : nullptr;
+}
+
+void CPDF_PageRenderCache::SetDisplayList(
+    uint32_t key,
+    std::unique_ptr<CPDF_DisplayList> pList) {
+  m_DisplayListKey = key;
+  m_pDisplayList = std::move(pList);
+}
+
 void CPDF_PageRenderCache::ResetBitmapForImage(
     const RetainPtr<CPDF_Image>& pImage) {
   CPDF_ImageCacheEntry* pEntry;
   CPDF_Stream* pStream = pImage->GetStream();
+  CPDF_DocRenderData::FromDocument(m_pPage->GetDocument())
+      ->GetImageCache()
+      ->Remove(pStream);
+
   const auto it = m_ImageCache.find(pStream);
   if (it == m_ImageCache.end())
     return;
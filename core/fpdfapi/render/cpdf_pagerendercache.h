@@ -17,6 +17,7 @@
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/unowned_ptr.h"
 
+class CPDF_DisplayList;
 class CPDF_Image;
 class CPDF_ImageCacheEntry;
 class CPDF_Page;
@@ -45,12 +46,20 @@ class CPDF_PageRenderCache : public CPDF_Page::RenderCacheIface {
 
   bool Continue(PauseIndicatorIface* pPause, CPDF_RenderStatus* pRenderStatus);
 
+  // Holds one display list for the page, built with render options that the
+  // caller identifies by |key|. Returns nullptr if the list was built with a
+  // different |key|.
+  CPDF_DisplayList* GetDisplayList(uint32_t key) const;
+  void SetDisplayList(uint32_t key, std::unique_ptr<CPDF_DisplayList> pList);
+
  private:
   void ClearImageCacheEntry(CPDF_Stream* pStream);
 
   UnownedPtr<CPDF_Page> const m_pPage;
   std::map<CPDF_Stream*, std::unique_ptr<CPDF_ImageCacheEntry>> m_ImageCache;
   MaybeOwned<CPDF_ImageCacheEntry> m_pCurImageCacheEntry;
+  std::unique_ptr<CPDF_DisplayList> m_pDisplayList;
+  uint32_t m_DisplayListKey = 0;
   uint32_t m_nTimeCount = 0;
   uint32_t m_nCacheSize = 0;
   bool m_bCurFindCache = false;
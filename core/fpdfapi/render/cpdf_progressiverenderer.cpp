@@ -6,15 +6,19 @@
 
 #include "core/fpdfapi/render/cpdf_progressiverenderer.h"
 
+#include <algorithm>
+
 #include "core/fpdfapi/page/cpdf_image.h"
 #include "core/fpdfapi/page/cpdf_imageobject.h"
 #include "core/fpdfapi/page/cpdf_pageobject.h"
 #include "core/fpdfapi/page/cpdf_pageobjectholder.h"
+#include "core/fpdfapi/render/cpdf_displaylist.h"
 #include "core/fpdfapi/render/cpdf_pagerendercache.h"
 #include "core/fpdfapi/render/cpdf_renderoptions.h"
 #include "core/fpdfapi/render/cpdf_renderstatus.h"
 #include "core/fxcrt/pauseindicator_iface.h"
 #include "core/fxge/cfx_renderdevice.h"
+#include "third_party/base/check_op.h"
 
 CPDF_ProgressiveRenderer::CPDF_ProgressiveRenderer(
     CPDF_RenderContext* pContext,
@@ -29,6 +33,13 @@ CPDF_ProgressiveRenderer::~CPDF_ProgressiveRenderer() {
   }
 }
 
+void CPDF_ProgressiveRenderer::SetDisplayList(const CPDF_DisplayList* pList,
+                                              const CFX_Matrix& matrix) {
+  DCHECK_EQ(m_Status, kReady);
+  m_pDisplayList = pList;
+  m_DisplayListMatrix = matrix;
+}
+
 void CPDF_ProgressiveRenderer::Start(PauseIndicatorIface* pPause) {
   if (!m_pContext || !m_pDevice || m_Status != kReady) {
     m_Status = kFailed;
@@ -39,6 +50,14 @@ void CPDF_ProgressiveRenderer::Start(PauseIndicatorIface* pPause) {
 }
 
 void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
+  if (m_pDisplayList && m_Status == kToBeContinued) {
+    if (!m_pDisplayList->Render(m_pContext.Get(), m_pDevice.Get(), *m_pOptions,
+                                m_DisplayListMatrix, pPause,
+                                &m_NextDisplayListOp)) {
+      return;
+    }
+    m_pDisplayList = nullptr;
+  }
   while (m_Status == kToBeContinued) {
     if (!m_pCurrentLayer) {
       if (m_LayerIndex >= m_pContext->CountLayers()) {
@@ -57,6 +76,9 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
       m_pDevice->SaveState();
       m_ClipRect = m_pCurrentLayer->GetMatrix().GetInverse().TransformRect(
           CFX_FloatRect(m_pDevice->GetClipBox()));
+      m_VisibleObjects =
+          m_pCurrentLayer->GetObjectHolder()->GetObjectPositionsInRect(
+              m_ClipRect);
     }
     CPDF_PageObjectHolder::const_iterator iter;
     CPDF_PageObjectHolder::const_iterator iterEnd =
@@ -67,6 +89,7 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
     } else {
       iter = m_pCurrentLayer->GetObjectHolder()->begin();
     }
+    iter = SeekVisibleObject(iter);
     int nObjsToGo = kStepLimit;
     bool is_mask = false;
     while (iter != iterEnd) {
@@ -106,7 +129,7 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
           return;
         nObjsToGo = kStepLimit;
       }
-      ++iter;
+      iter = SeekVisibleObject(std::next(iter));
       if (is_mask && iter != iterEnd)
         return;
     }
@@ -129,3 +152,16 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
     }
   }
 }
+
+CPDF_PageObjectHolder::const_iterator
+CPDF_ProgressiveRenderer::SeekVisibleObject(
+    CPDF_PageObjectHolder::const_iterator iter) const {
+  if (!m_VisibleObjects.has_value())
+    return iter;
+
+  const CPDF_PageObjectHolder* pHolder = m_pCurrentLayer->GetObjectHolder();
+  const std::vector<size_t>& visible = m_VisibleObjects.value();
+  size_t pos = iter - pHolder->begin();
+  auto it = std::lower_bound(visible.begin(), visible.end(), pos);
+  return it != visible.end() ? pHolder->begin() + *it : pHolder->end();
+}
@@ -10,12 +10,15 @@
 #include <stdint.h>
 
 #include <memory>
+#include <vector>
 
 #include "core/fpdfapi/page/cpdf_pageobjectholder.h"
 #include "core/fpdfapi/render/cpdf_rendercontext.h"
 #include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/unowned_ptr.h"
+#include "third_party/base/optional.h"
 
+class CPDF_DisplayList;
 class CPDF_RenderOptions;
 class CPDF_RenderStatus;
 class CFX_RenderDevice;
@@ -39,6 +42,11 @@ class CPDF_ProgressiveRenderer {
   ~CPDF_ProgressiveRenderer();
 
   Status GetStatus() const { return m_Status; }
+
+  // Renders |pList| with |matrix| before the layers of the context, pausing
+  // in between its ops as well. Must be called before Start().
+  void SetDisplayList(const CPDF_DisplayList* pList, const CFX_Matrix& matrix);
+
   void Start(PauseIndicatorIface* pPause);
   void Continue(PauseIndicatorIface* pPause);
 
@@ -46,15 +54,25 @@ class CPDF_ProgressiveRenderer {
   // Maximum page objects to render before checking for pause.
   static constexpr int kStepLimit = 100;
 
+  // Returns the first object from |iter| on that may intersect |m_ClipRect|.
+  CPDF_PageObjectHolder::const_iterator SeekVisibleObject(
+      CPDF_PageObjectHolder::const_iterator iter) const;
+
   Status m_Status = kReady;
   UnownedPtr<CPDF_RenderContext> const m_pContext;
   UnownedPtr<CFX_RenderDevice> const m_pDevice;
   UnownedPtr<const CPDF_RenderOptions> const m_pOptions;
   std::unique_ptr<CPDF_RenderStatus> m_pRenderStatus;
+  UnownedPtr<const CPDF_DisplayList> m_pDisplayList;
+  CFX_Matrix m_DisplayListMatrix;
+  size_t m_NextDisplayListOp = 0;
   CFX_FloatRect m_ClipRect;
   uint32_t m_LayerIndex = 0;
   CPDF_RenderContext::Layer* m_pCurrentLayer = nullptr;
   CPDF_PageObjectHolder::const_iterator m_LastObjectRendered;
+  // Positions of the objects of the current layer that intersect
+  // |m_ClipRect|, when its holder has an index.
+  Optional<std::vector<size_t>> m_VisibleObjects;
 };
 
 #endif  // CORE_FPDFAPI_RENDER_CPDF_PROGRESSIVERENDERER_H_
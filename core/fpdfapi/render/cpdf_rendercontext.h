@@ -12,6 +12,7 @@
 #include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/unowned_ptr.h"
+#include "core/fxge/dib/cfx_bitmappool.h"
 
 class CPDF_Dictionary;
 class CPDF_Document;
@@ -71,11 +72,15 @@ class CPDF_RenderContext {
   CPDF_Dictionary* GetPageResources() const { return m_pPageResources.Get(); }
   CPDF_PageRenderCache* GetPageCache() const { return m_pPageCache.Get(); }
 
+  // Scratch bitmaps for transparency groups and soft masks.
+  CFX_BitmapPool* GetBitmapPool() { return &m_BitmapPool; }
+
  protected:
   UnownedPtr<CPDF_Document> const m_pDocument;
   RetainPtr<CPDF_Dictionary> const m_pPageResources;
   UnownedPtr<CPDF_PageRenderCache> const m_pPageCache;
   std::vector<Layer> m_Layers;
+  CFX_BitmapPool m_BitmapPool;
 };
 
 #endif  // CORE_FPDFAPI_RENDER_CPDF_RENDERCONTEXT_H_
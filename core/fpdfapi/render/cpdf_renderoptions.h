@@ -35,6 +35,9 @@ class CPDF_RenderOptions {
     bool bNoImageSmooth = false;
     bool bLimitedImageCache = false;
     bool bConvertFillToStroke = false;
+    bool bCacheForms = false;
+    // Trade fidelity for speed when rendering small thumbnails.
+    bool bThumbnail = false;
   };
 
   struct ColorScheme {
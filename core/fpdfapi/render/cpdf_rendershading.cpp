@@ -89,6 +89,51 @@ std::array<FX_ARGB, kShadingSteps> GetShadingSteps(
   return shading_steps;
 }
 
+// Computes the position along the axis of each pixel in |row|. The terms are
+// added in the same order as CFX_Matrix::Transform() adds them, so the
+// positions match transforming each pixel with |matrix|.
+void GetAxialShadingRow(const CFX_Matrix& matrix,
+                        int row,
+                        float start_x,
+                        float start_y,
+                        float x_span,
+                        float y_span,
+                        float axis_len_square,
+                        pdfium::span<float> scales) {
+  const float row_x = matrix.c * static_cast<float>(row);
+  const float row_y = matrix.d * static_cast<float>(row);
+  for (size_t column = 0; column < scales.size(); column++) {
+    const float x = matrix.a * static_cast<float>(column) + row_x + matrix.e;
+    const float y = matrix.b * static_cast<float>(column) + row_y + matrix.f;
+    scales[column] =
+        (((x - start_x) * x_span) + ((y - start_y) * y_span)) / axis_len_square;
+  }
+}
+
+// Writes the colors of the shading positions in |scales| to |dib_buf|,
+// leaving the pixels outside of the unextended ends untouched.
+void WriteShadingRow(pdfium::span<const float> scales,
+                     const std::array<FX_ARGB, kShadingSteps>& shading_steps,
+                     bool bStartExtend,
+                     bool bEndExtend,
+                     uint32_t* dib_buf) {
+  for (size_t column = 0; column < scales.size(); column++) {
+    int index = static_cast<int32_t>(scales[column] * (kShadingSteps - 1));
+    if (index < 0) {
+      if (!bStartExtend)
+        continue;
+
+      index = 0;
+    } else if (index >= kShadingSteps) {
+      if (!bEndExtend)
+        continue;
+
+      index = kShadingSteps - 1;
+    }
+    dib_buf[column] = shading_steps[index];
+  }
+}
+
 void DrawAxialShading(const RetainPtr<CFX_DIBitmap>& pBitmap,
                       const CFX_Matrix& mtObject2Bitmap,
                       const CPDF_Dictionary* pDict,
@@ -131,29 +176,21 @@ void DrawAxialShading(const RetainPtr<CFX_DIBitmap>& pBitmap,
 
   int pitch = pBitmap->GetPitch();
   CFX_Matrix matrix = mtObject2Bitmap.GetInverse();
+
+  // The position along the axis only depends on the column when neither
+  // coordinate that contributes to it changes from row to row, e.g. for
+  // horizontal gradients. Then the first row's positions are reused.
+  const bool bSameRows = (matrix.c == 0 || x_span == 0) &&
+                         (matrix.d == 0 || y_span == 0);
+  std::vector<float> scales(width);
   for (int row = 0; row < height; row++) {
+    if (row == 0 || !bSameRows) {
+      GetAxialShadingRow(matrix, row, start_x, start_y, x_span, y_span,
+                         axis_len_square, scales);
+    }
     uint32_t* dib_buf =
         reinterpret_cast<uint32_t*>(pBitmap->GetBuffer() + row * pitch);
-    for (int column = 0; column < width; column++) {
-      CFX_PointF pos = matrix.Transform(
-          CFX_PointF(static_cast<float>(column), static_cast<float>(row)));
-      float scale =
-          (((pos.x - start_x) * x_span) + ((pos.y - start_y) * y_span)) /
-          axis_len_square;
-      int index = static_cast<int32_t>(scale * (kShadingSteps - 1));
-      if (index < 0) {
-        if (!bStartExtend)
-          continue;
-
-        index = 0;
-      } else if (index >= kShadingSteps) {
-        if (!bEndExtend)
-          continue;
-
-        index = kShadingSteps - 1;
-      }
-      dib_buf[column] = shading_steps[index];
-    }
+    WriteShadingRow(scales, shading_steps, bStartExtend, bEndExtend, dib_buf);
   }
 }
 
@@ -206,16 +243,28 @@ void DrawRadialShading(const RetainPtr<CFX_DIBitmap>& pBitmap,
   bool bDecreasing = dr < 0 && static_cast<int>(FXSYS_sqrt2(dx, dy)) < -dr;
 
   CFX_Matrix matrix = mtObject2Bitmap.GetInverse();
+  std::vector<float> b_values(width);
+  std::vector<float> c_values(width);
   for (int row = 0; row < height; row++) {
+    // Compute the quadratic coefficients of the whole row first. Only
+    // picking the root below depends on the discriminant and /Extend.
+    const float row_x = matrix.c * static_cast<float>(row);
+    const float row_y = matrix.d * static_cast<float>(row);
+    for (int column = 0; column < width; column++) {
+      float pos_dx =
+          matrix.a * static_cast<float>(column) + row_x + matrix.e - start_x;
+      float pos_dy =
+          matrix.b * static_cast<float>(column) + row_y + matrix.f - start_y;
+      b_values[column] = -2 * (pos_dx * dx + pos_dy * dy + start_r * dr);
+      c_values[column] =
+          pos_dx * pos_dx + pos_dy * pos_dy - start_r * start_r;
+    }
+
     uint32_t* dib_buf =
         reinterpret_cast<uint32_t*>(pBitmap->GetBuffer() + row * pitch);
     for (int column = 0; column < width; column++) {
-      CFX_PointF pos = matrix.Transform(
-          CFX_PointF(static_cast<float>(column), static_cast<float>(row)));
-      float pos_dx = pos.x - start_x;
-      float pos_dy = pos.y - start_y;
-      float b = -2 * (pos_dx * dx + pos_dy * dy + start_r * dr);
-      float c = pos_dx * pos_dx + pos_dy * pos_dy - start_r * start_r;
+      const float b = b_values[column];
+      const float c = c_values[column];
       float s;
       if (FXSYS_IsFloatZero(b)) {
         s = sqrt(-c / a);
@@ -316,22 +365,33 @@ void DrawFuncShading(const RetainPtr<CFX_DIBitmap>& pBitmap,
   }
 }
 
-bool GetScanlineIntersect(int y,
-                          const CFX_PointF& first,
-                          const CFX_PointF& second,
-                          float* x) {
-  if (first.y == second.y)
-    return false;
-
-  if (first.y < second.y) {
-    if (y < first.y || y > second.y)
-      return false;
-  } else if (y < second.y || y > first.y) {
-    return false;
-  }
-  *x = first.x + ((second.x - first.x) * (y - first.y) / (second.y - first.y));
-  return true;
-}
+// A triangle edge for DrawGouraud(), with the differences between its
+// vertices computed once instead of for every scanline.
+struct GouraudEdge {
+  void Init(const CPDF_MeshVertex& vertex1, const CPDF_MeshVertex& vertex2) {
+    start = vertex1;
+    x_span = vertex2.position.x - vertex1.position.x;
+    y_span = vertex2.position.y - vertex1.position.y;
+    r_span = vertex2.r - vertex1.r;
+    g_span = vertex2.g - vertex1.g;
+    b_span = vertex2.b - vertex1.b;
+    min_y = std::min(vertex1.position.y, vertex2.position.y);
+    max_y = std::max(vertex1.position.y, vertex2.position.y);
+  }
+
+  bool Intersects(int y) const {
+    return y_span != 0 && y >= min_y && y <= max_y;
+  }
+
+  CPDF_MeshVertex start;
+  float x_span;
+  float y_span;
+  float r_span;
+  float g_span;
+  float b_span;
+  float min_y;
+  float max_y;
+};
 
 void DrawGouraud(const RetainPtr<CFX_DIBitmap>& pBitmap,
                  int alpha,
@@ -350,26 +410,29 @@ void DrawGouraud(const RetainPtr<CFX_DIBitmap>& pBitmap,
   if (max_yi >= pBitmap->GetHeight())
     max_yi = pBitmap->GetHeight() - 1;
 
+  GouraudEdge edges[3];
+  for (int i = 0; i < 3; i++)
+    edges[i].Init(triangle[i], triangle[(i + 1) % 3]);
+
+  const int width = pBitmap->GetWidth();
   for (int y = min_yi; y <= max_yi; y++) {
     int nIntersects = 0;
     float inter_x[3];
     float r[3];
     float g[3];
     float b[3];
-    for (int i = 0; i < 3; i++) {
-      CPDF_MeshVertex& vertex1 = triangle[i];
-      CPDF_MeshVertex& vertex2 = triangle[(i + 1) % 3];
-      CFX_PointF& position1 = vertex1.position;
-      CFX_PointF& position2 = vertex2.position;
-      bool bIntersect =
-          GetScanlineIntersect(y, position1, position2, &inter_x[nIntersects]);
-      if (!bIntersect)
+    for (const GouraudEdge& edge : edges) {
+      if (!edge.Intersects(y))
         continue;
 
-      float y_dist = (y - position1.y) / (position2.y - position1.y);
-      r[nIntersects] = vertex1.r + ((vertex2.r - vertex1.r) * y_dist);
-      g[nIntersects] = vertex1.g + ((vertex2.g - vertex1.g) * y_dist);
-      b[nIntersects] = vertex1.b + ((vertex2.b - vertex1.b) * y_dist);
+      const CPDF_MeshVertex& vertex1 = edge.start;
+      inter_x[nIntersects] = vertex1.position.x +
+                             ((edge.x_span * (y - vertex1.position.y)) /
+                              edge.y_span);
+      float y_dist = (y - vertex1.position.y) / edge.y_span;
+      r[nIntersects] = vertex1.r + (edge.r_span * y_dist);
+      g[nIntersects] = vertex1.g + (edge.g_span * y_dist);
+      b[nIntersects] = vertex1.b + (edge.b_span * y_dist);
       nIntersects++;
     }
     if (nIntersects != 2)
@@ -392,10 +455,14 @@ void DrawGouraud(const RetainPtr<CFX_DIBitmap>& pBitmap,
     }
 
     int start_x = std::max(min_x, 0);
-    int end_x = std::min(max_x, pBitmap->GetWidth());
+    int end_x = std::min(max_x, width);
+    if (start_x >= end_x)
+      continue;
 
-    uint8_t* dib_buf =
-        pBitmap->GetBuffer() + y * pBitmap->GetPitch() + start_x * 4;
+    uint32_t* dib_buf =
+        reinterpret_cast<uint32_t*>(pBitmap->GetBuffer() +
+                                    y * pBitmap->GetPitch()) +
+        start_x;
     float r_unit = (r[end_index] - r[start_index]) / (max_x - min_x);
     float g_unit = (g[end_index] - g[start_index]) / (max_x - min_x);
     float b_unit = (b[end_index] - b[start_index]) / (max_x - min_x);
@@ -406,10 +473,9 @@ void DrawGouraud(const RetainPtr<CFX_DIBitmap>& pBitmap,
       r_result += r_unit;
       g_result += g_unit;
       b_result += b_unit;
-      FXARGB_SETDIB(dib_buf, ArgbEncode(alpha, static_cast<int>(r_result * 255),
-                                        static_cast<int>(g_result * 255),
-                                        static_cast<int>(b_result * 255)));
-      dib_buf += 4;
+      *dib_buf++ = ArgbEncode(alpha, static_cast<int>(r_result * 255),
+                              static_cast<int>(g_result * 255),
+                              static_cast<int>(b_result * 255));
     }
   }
 }
@@ -544,6 +610,15 @@ struct CoonBezierCoeff {
     return dis < 0 ? -dis : dis;
   }
 
+  // How far the inner control points are from dividing the chord into
+  // thirds. The curve stays within this distance of its chord.
+  float Flatness() const {
+    return std::max(fabsf(a + b), fabsf(2 * a + b)) / 3;
+  }
+
+  float GetStart() const { return d; }
+  float GetEnd() const { return a + b + c + d; }
+
   float a;
   float b;
   float c;
@@ -609,6 +684,10 @@ struct CoonBezier {
   }
 
   float Distance() const { return x.Distance() + y.Distance(); }
+  float Flatness() const { return std::max(x.Flatness(), y.Flatness()); }
+
+  CFX_PointF GetStart() const { return {x.GetStart(), y.GetStart()}; }
+  CFX_PointF GetEnd() const { return {x.GetEnd(), y.GetEnd()}; }
 
   CoonBezierCoeff x;
   CoonBezierCoeff y;
@@ -663,6 +742,8 @@ struct CoonColor {
 
 struct PatchDrawer {
   static constexpr int kCoonColorThreshold = 4;
+  // In device pixels, below what curve flattening would resolve anyway.
+  static constexpr float kCoonFlatness = 0.25f;
 
   void Draw(int x_scale,
             int y_scale,
@@ -705,18 +786,31 @@ struct PatchDrawer {
     if (bSmall ||
         (d_bottom < kCoonColorThreshold && d_left < kCoonColorThreshold &&
          d_top < kCoonColorThreshold && d_right < kCoonColorThreshold)) {
-      pdfium::span<CFX_Path::Point> points = path.GetPoints();
-      C1.GetPoints(points.subspan(0, 4));
-      D2.GetPoints(points.subspan(3, 4));
-      C2.GetPointsReverse(points.subspan(6, 4));
-      D1.GetPointsReverse(points.subspan(9, 4));
+      // Patches with straight sides, which deep subdivision produces, are
+      // filled as quadrilaterals, sparing the rasterizer the curves.
+      const bool bFlat =
+          C1.Flatness() < kCoonFlatness && C2.Flatness() < kCoonFlatness &&
+          D1.Flatness() < kCoonFlatness && D2.Flatness() < kCoonFlatness;
+      CFX_Path* fill_path = bFlat ? &flat_path : &path;
+      pdfium::span<CFX_Path::Point> points = fill_path->GetPoints();
+      if (bFlat) {
+        points[0].m_Point = C1.GetStart();
+        points[1].m_Point = D2.GetStart();
+        points[2].m_Point = D2.GetEnd();
+        points[3].m_Point = C2.GetStart();
+      } else {
+        C1.GetPoints(points.subspan(0, 4));
+        D2.GetPoints(points.subspan(3, 4));
+        C2.GetPointsReverse(points.subspan(6, 4));
+        D1.GetPointsReverse(points.subspan(9, 4));
+      }
       CFX_FillRenderOptions fill_options(
           CFX_FillRenderOptions::WindingOptions());
       fill_options.full_cover = true;
       if (bNoPathSmooth)
         fill_options.aliased_path = true;
       pDevice->DrawPath(
-          &path, nullptr, nullptr,
+          fill_path, nullptr, nullptr,
           ArgbEncode(alpha, div_colors[0].comp[0], div_colors[0].comp[1],
                      div_colors[0].comp[2]),
           0, fill_options);
@@ -767,6 +861,7 @@ struct PatchDrawer {
 
   int max_delta;
   CFX_Path path;
+  CFX_Path flat_path;
   CFX_RenderDevice* pDevice;
   int bNoPathSmooth;
   int alpha;
@@ -802,6 +897,11 @@ void DrawCoonPatchMeshes(
                                              ? CFX_Path::Point::Type::kMove
                                              : CFX_Path::Point::Type::kBezier);
   }
+  for (int i = 0; i < 4; i++) {
+    patch.flat_path.AppendPoint(
+        CFX_PointF(),
+        i == 0 ? CFX_Path::Point::Type::kMove : CFX_Path::Point::Type::kLine);
+  }
 
   CFX_PointF coords[16];
   int point_count = type == kTensorProductPatchMeshShading ? 16 : 12;
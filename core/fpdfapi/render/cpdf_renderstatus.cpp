@@ -6,9 +6,10 @@
 
 #include "core/fpdfapi/render/cpdf_renderstatus.h"
 
+#include <math.h>
+
 #include <algorithm>
 #include <memory>
-#include <numeric>
 #include <set>
 #include <utility>
 #include <vector>
@@ -18,6 +19,8 @@
 #include "core/fpdfapi/font/cpdf_font.h"
 #include "core/fpdfapi/font/cpdf_type3char.h"
 #include "core/fpdfapi/font/cpdf_type3font.h"
+#include "core/fpdfapi/page/cpdf_contentmarkitem.h"
+#include "core/fpdfapi/page/cpdf_contentmarks.h"
 #include "core/fpdfapi/page/cpdf_docpagedata.h"
 #include "core/fpdfapi/page/cpdf_form.h"
 #include "core/fpdfapi/page/cpdf_formobject.h"
@@ -40,6 +43,7 @@
 #include "core/fpdfapi/parser/fpdf_parser_utility.h"
 #include "core/fpdfapi/render/charposlist.h"
 #include "core/fpdfapi/render/cpdf_docrenderdata.h"
+#include "core/fpdfapi/render/cpdf_formbitmapcache.h"
 #include "core/fpdfapi/render/cpdf_imagerenderer.h"
 #include "core/fpdfapi/render/cpdf_pagerendercache.h"
 #include "core/fpdfapi/render/cpdf_rendercontext.h"
@@ -58,6 +62,7 @@
 #include "core/fxge/cfx_fillrenderoptions.h"
 #include "core/fxge/cfx_glyphbitmap.h"
 #include "core/fxge/cfx_path.h"
+#include "core/fxge/dib/cfx_bitmappool.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
 #include "core/fxge/fx_font.h"
 #include "core/fxge/renderdevicedriver_iface.h"
@@ -76,6 +81,17 @@ namespace {
 constexpr int kRenderMaxRecursionDepth = 64;
 int g_CurrentRecursionDepth = 0;
 
+// In thumbnails, text with a smaller em size in device pixels is drawn as
+// bars, and shadings and patterns no larger than the cutoff in either
+// direction are skipped.
+constexpr float kThumbnailTextBarSize = 4.0f;
+constexpr int kThumbnailDetailCutoff = 4;
+
+bool IsBelowThumbnailDetailCutoff(const FX_RECT& rect) {
+  return rect.Width() <= kThumbnailDetailCutoff &&
+         rect.Height() <= kThumbnailDetailCutoff;
+}
+
 CFX_FillRenderOptions GetFillOptionsForDrawPathWithBlend(
     const CPDF_RenderOptions::Options& options,
     const CPDF_PathObject* path_obj,
@@ -143,6 +159,59 @@ bool Type3CharMissingStrokeColor(const CPDF_Type3Char* pChar,
   return pChar && (!pChar->colored() || MissingStrokeColor(pColorState));
 }
 
+bool HasOptionalContent(const CPDF_PageObject* pObj) {
+  const CPDF_ContentMarks* pMarks = pObj->GetContentMarks();
+  for (size_t i = 0; i < pMarks->CountItems(); ++i) {
+    if (pMarks->GetItem(i)->GetName() == "OC")
+      return true;
+  }
+  return false;
+}
+
+// Whether rendering the objects of |pHolder| onto a transparent bitmap and
+// compositing that gives the same result as rendering them directly, for
+// any render of any page. This excludes content that blends with or reads
+// back the backdrop, and optional content, which may be toggled between
+// renders.
+bool IsFormContentCacheable(const CPDF_PageObjectHolder* pHolder) {
+  for (const auto& pObj : *pHolder) {
+    if (!pObj)
+      continue;
+
+    if (pObj->m_GeneralState.GetBlendType() != BlendMode::kNormal ||
+        HasOptionalContent(pObj.get())) {
+      return false;
+    }
+    const CPDF_FormObject* pFormObj = pObj->AsForm();
+    if (!pFormObj)
+      continue;
+
+    const CPDF_Form* pForm = pFormObj->form();
+    const CPDF_Transparency& transparency = pForm->GetTransparency();
+    if (pForm->GetDict()->KeyExist("OC") ||
+        (transparency.IsGroup() && !transparency.IsIsolated()) ||
+        !IsFormContentCacheable(pForm)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+uint32_t GetFormCacheOptions(const CPDF_RenderOptions& options, bool bStdCS) {
+  const CPDF_RenderOptions::Options& flags = options.GetOptions();
+  uint32_t result = options.ColorModeIs(CPDF_RenderOptions::kGray) ? 1 : 0;
+  result |= flags.bNoNativeText ? 1 << 1 : 0;
+  result |= flags.bForceHalftone ? 1 << 2 : 0;
+  result |= flags.bRectAA ? 1 << 3 : 0;
+  result |= flags.bBreakForMasks ? 1 << 4 : 0;
+  result |= flags.bNoTextSmooth ? 1 << 5 : 0;
+  result |= flags.bNoPathSmooth ? 1 << 6 : 0;
+  result |= flags.bNoImageSmooth ? 1 << 7 : 0;
+  result |= bStdCS ? 1 << 8 : 0;
+  result |= flags.bThumbnail ? 1 << 9 : 0;
+  return result;
+}
+
 #if defined(_SKIA_SUPPORT_) || defined(_SKIA_SUPPORT_PATHS_)
 class ScopedSkiaDeviceFlush {
  public:
@@ -161,6 +230,52 @@ class ScopedSkiaDeviceFlush {
 };
 #endif
 
+// Returns the smallest rect holding all non-zero pixels of the k8bppMask
+// |pMask|, or an empty rect if there are none.
+FX_RECT GetMaskCoverageBox(const RetainPtr<CFX_DIBitmap>& pMask) {
+  const int width = pMask->GetWidth();
+  FX_RECT box(width, pMask->GetHeight(), 0, 0);
+  for (int row = 0; row < pMask->GetHeight(); ++row) {
+    const uint8_t* scan = pMask->GetScanline(row);
+    int left = 0;
+    while (left < width && !scan[left])
+      ++left;
+    if (left == width)
+      continue;
+
+    int right = width;
+    while (!scan[right - 1])
+      --right;
+    box.left = std::min(box.left, left);
+    box.right = std::max(box.right, right);
+    box.top = std::min(box.top, row);
+    box.bottom = row + 1;
+  }
+  if (box.top >= box.bottom)
+    return FX_RECT();
+  return box;
+}
+
+// Same as FXRGB2GRAY() on a row of BGR pixels |Bpp| bytes apart. The weighted
+// sum is at most 25500, and for those (sum * 5243) >> 19 equals sum / 100, so
+// no division is needed per pixel.
+template <int Bpp>
+void GetLuminosityRow(const uint8_t* src_scan, int width, uint8_t* dest_scan) {
+  for (int col = 0; col < width; ++col) {
+    const uint8_t* pixel = src_scan + col * Bpp;
+    uint32_t weighted = pixel[0] * 11 + pixel[1] * 59 + pixel[2] * 30;
+    dest_scan[col] = static_cast<uint8_t>((weighted * 5243) >> 19);
+  }
+}
+
+void ApplyTransfers(
+    const std::vector<uint8_t, FxAllocAllocator<uint8_t>>& transfers,
+    uint8_t* scan,
+    int width) {
+  for (int col = 0; col < width; ++col)
+    scan[col] = transfers[scan[col]];
+}
+
 }  // namespace
 
 CPDF_RenderStatus::CPDF_RenderStatus(CPDF_RenderContext* pContext,
@@ -202,23 +317,36 @@ void CPDF_RenderStatus::RenderObjectList(
 #endif
   CFX_FloatRect clip_rect = mtObj2Device.GetInverse().TransformRect(
       CFX_FloatRect(m_pDevice->GetClipBox()));
-  for (const auto& pCurObj : *pObjectHolder) {
-    if (pCurObj.get() == m_pStopObj) {
-      m_bStopped = true;
-      return;
+  // The stop object must be noticed even when it is not visible.
+  Optional<std::vector<size_t>> positions;
+  if (!m_pStopObj)
+    positions = pObjectHolder->GetObjectPositionsInRect(clip_rect);
+  if (positions.has_value()) {
+    for (size_t pos : positions.value()) {
+      RenderSingleObject(pObjectHolder->GetPageObjectByIndex(pos),
+                         mtObj2Device);
+      if (m_bStopped)
+        return;
     }
-    if (!pCurObj)
-      continue;
-
-    if (pCurObj->GetRect().left > clip_rect.right ||
-        pCurObj->GetRect().right < clip_rect.left ||
-        pCurObj->GetRect().bottom > clip_rect.top ||
-        pCurObj->GetRect().top < clip_rect.bottom) {
-      continue;
+  } else {
+    for (const auto& pCurObj : *pObjectHolder) {
+      if (pCurObj.get() == m_pStopObj) {
+        m_bStopped = true;
+        return;
+      }
+      if (!pCurObj)
+        continue;
+
+      if (pCurObj->GetRect().left > clip_rect.right ||
+          pCurObj->GetRect().right < clip_rect.left ||
+          pCurObj->GetRect().bottom > clip_rect.top ||
+          pCurObj->GetRect().top < clip_rect.bottom) {
+        continue;
+      }
+      RenderSingleObject(pCurObj.get(), mtObj2Device);
+      if (m_bStopped)
+        return;
     }
-    RenderSingleObject(pCurObj.get(), mtObj2Device);
-    if (m_bStopped)
-      return;
   }
 #if defined(_SKIA_SUPPORT_)
   DebugVerifyDeviceIsPreMultiplied();
@@ -378,6 +506,10 @@ bool CPDF_RenderStatus::ProcessForm(const CPDF_FormObject* pFormObj,
       !m_Options.GetOCContext()->CheckOCGVisible(pOC)) {
     return true;
   }
+  if (m_Options.GetOptions().bCacheForms &&
+      DrawFormWithCache(pFormObj, mtObj2Device)) {
+    return true;
+  }
   CFX_Matrix matrix = pFormObj->form_matrix() * mtObj2Device;
   const CPDF_Dictionary* pResources =
       pFormObj->form()->GetDict()->GetDictFor("Resources");
@@ -400,6 +532,105 @@ bool CPDF_RenderStatus::ProcessForm(const CPDF_FormObject* pFormObj,
   return true;
 }
 
+bool CPDF_RenderStatus::DrawFormWithCache(const CPDF_FormObject* pFormObj,
+                                          const CFX_Matrix& mtObj2Device) {
+#if defined(_SKIA_SUPPORT_) || defined(_SKIA_SUPPORT_PATHS_)
+  // Skia premultiplies bitmaps in place when drawing them.
+  return false;
+#else
+  if (m_bPrint || m_bLoadMask || m_bDropObjects || m_pType3Char ||
+      m_pStopObj || m_curBlend != BlendMode::kNormal ||
+      !m_DeviceMatrix.IsIdentity() ||
+      m_pDevice->GetBackDrop() || m_Options.GetOptions().bClearType ||
+      !(m_Options.ColorModeIs(CPDF_RenderOptions::kNormal) ||
+        m_Options.ColorModeIs(CPDF_RenderOptions::kGray))) {
+    return false;
+  }
+
+  // The key only describes the form as parsed from its stream, so edited
+  // forms are always rendered directly.
+  const CPDF_Form* pForm = pFormObj->form();
+  const CPDF_ColorState& color_state = pFormObj->m_ColorState;
+  if (!pForm->GetStream() || pForm->HasChangedSinceParse() ||
+      !color_state.HasFillColor() ||
+      !color_state.HasStrokeColor() ||
+      color_state.GetFillColor()->IsPattern() ||
+      color_state.GetStrokeColor()->IsPattern() ||
+      !pFormObj->m_TextState.HasRef() || pFormObj->m_GeneralState.GetTR() ||
+      pFormObj->m_GeneralState.GetSoftMask()) {
+    return false;
+  }
+
+  // Render the whole form, so the bitmap can be reused under any clip.
+  FX_RECT rect = pFormObj->GetTransformedBBox(mtObj2Device);
+  if (GetClippedBBox(rect).IsEmpty())
+    return false;
+
+  CPDF_FormBitmapCache* pCache =
+      CPDF_DocRenderData::FromDocument(m_pContext->GetDocument())
+          ->GetFormBitmapCache();
+  FX_SAFE_SIZE_T bytes = rect.Width();
+  bytes *= rect.Height();
+  bytes *= 4;
+  if (!bytes.IsValid() || !pCache->CanCache(bytes.ValueOrDie()))
+    return false;
+
+  CFX_Matrix new_matrix = mtObj2Device;
+  new_matrix.Translate(-rect.left, -rect.top);
+  CFX_Matrix form_matrix = pFormObj->form_matrix() * new_matrix;
+
+  CPDF_FormBitmapCache::Key key;
+  key.stream.Reset(pForm->GetStream());
+  key.resources.Reset(pForm->GetResources());
+  key.matrix = {form_matrix.a, form_matrix.b, form_matrix.c,
+                form_matrix.d, form_matrix.e, form_matrix.f};
+  key.options = GetFormCacheOptions(m_Options, m_bStdCS);
+  key.fill_color = color_state.GetFillColorRef();
+  key.stroke_color = color_state.GetStrokeColorRef();
+  key.fill_alpha = pFormObj->m_GeneralState.GetFillAlpha();
+  key.stroke_alpha = pFormObj->m_GeneralState.GetStrokeAlpha();
+  key.stroke_adjust = pFormObj->m_GeneralState.GetStrokeAdjust();
+  key.line_width = pFormObj->m_GraphState.GetLineWidth();
+  key.miter_limit = pFormObj->m_GraphState.GetMiterLimit();
+  key.dash_phase = pFormObj->m_GraphState.GetLineDashPhase();
+  key.line_cap = pFormObj->m_GraphState.GetLineCap();
+  key.line_join = pFormObj->m_GraphState.GetLineJoin();
+  key.dash_array = pFormObj->m_GraphState.GetLineDashArray();
+  RetainPtr<CPDF_Font> pFont = pFormObj->m_TextState.GetFont();
+  if (pFont)
+    key.font_dict.Reset(pFont->GetFontDict());
+  key.font_size = pFormObj->m_TextState.GetFontSize();
+  key.char_space = pFormObj->m_TextState.GetCharSpace();
+  key.word_space = pFormObj->m_TextState.GetWordSpace();
+  key.text_mode = static_cast<int>(pFormObj->m_TextState.GetTextMode());
+
+  RetainPtr<CFX_DIBitmap> pBitmap;
+  if (!pCache->Lookup(key, &pBitmap)) {
+    if (!IsFormContentCacheable(pForm))
+      return false;
+
+    CFX_DefaultRenderDevice bitmap_device;
+    if (!bitmap_device.Create(rect.Width(), rect.Height(), FXDIB_Format::kArgb,
+                              nullptr)) {
+      return false;
+    }
+    pBitmap = bitmap_device.GetBitmap();
+    pBitmap->Clear(0);
+
+    // Turn the cache off for nested forms, which are part of this bitmap.
+    CPDF_RenderOptions options = m_Options;
+    options.GetOptions().bCacheForms = false;
+    CPDF_RenderStatus status(m_pContext.Get(), &bitmap_device);
+    status.SetOptions(options);
+    status.SetStdCS(m_bStdCS);
+    status.Initialize(nullptr, &m_InitialStates);
+    status.ProcessForm(pFormObj, new_matrix);
+    pCache->Add(key, pBitmap, bytes.ValueOrDie());
+  }
+  return m_pDevice->SetDIBits(pBitmap, rect.left, rect.top);
+#endif
+}
+
 bool CPDF_RenderStatus::ProcessPath(CPDF_PathObject* path_obj,
                                     const CFX_Matrix& mtObj2Device) {
   CFX_FillRenderOptions::FillType fill_type = path_obj->filltype();
@@ -434,6 +665,14 @@ bool CPDF_RenderStatus::ProcessPath(CPDF_PathObject* path_obj,
       m_curBlend);
 }
 
+CFX_FillRenderOptions CPDF_RenderStatus::GetPathFillOptions(
+    const CPDF_PathObject* path_obj,
+    CFX_FillRenderOptions::FillType fill_type,
+    bool stroke) const {
+  return GetFillOptionsForDrawPathWithBlend(m_Options.GetOptions(), path_obj,
+                                            fill_type, stroke, !!m_pType3Char);
+}
+
 RetainPtr<CPDF_TransferFunc> CPDF_RenderStatus::GetTransferFunc(
     const CPDF_Object* pObj) const {
   DCHECK(pObj);
@@ -644,33 +883,17 @@ bool CPDF_RenderStatus::ProcessTransparency(CPDF_PageObject* pPageObj,
   if (rect.IsEmpty())
     return true;
 
-  int width = rect.Width();
-  int height = rect.Height();
-  CFX_DefaultRenderDevice bitmap_device;
-  RetainPtr<CFX_DIBitmap> backdrop;
-  if (!transparency.IsIsolated() &&
-      (m_pDevice->GetRenderCaps() & FXRC_GET_BITS)) {
-    backdrop = pdfium::MakeRetain<CFX_DIBitmap>();
-    if (!m_pDevice->CreateCompatibleBitmap(backdrop, width, height))
-      return true;
-    m_pDevice->GetDIBits(backdrop, rect.left, rect.top);
-  }
-  if (!bitmap_device.Create(width, height, FXDIB_Format::kArgb, backdrop))
-    return true;
-
-  RetainPtr<CFX_DIBitmap> bitmap = bitmap_device.GetBitmap();
-  bitmap->Clear(0);
-
-  CFX_Matrix new_matrix = mtObj2Device;
-  new_matrix.Translate(-rect.left, -rect.top);
-
+  CFX_BitmapPool* pPool = m_pContext->GetBitmapPool();
   RetainPtr<CFX_DIBitmap> pTextMask;
   if (bTextClip) {
-    pTextMask = pdfium::MakeRetain<CFX_DIBitmap>();
-    if (!pTextMask->Create(width, height, FXDIB_Format::k8bppMask))
+    pTextMask =
+        pPool->Create(rect.Width(), rect.Height(), FXDIB_Format::k8bppMask);
+    if (!pTextMask)
       return true;
 
     pTextMask->Clear(0);
+    CFX_Matrix text_matrix = mtObj2Device;
+    text_matrix.Translate(-rect.left, -rect.top);
     CFX_DefaultRenderDevice text_device;
     text_device.Attach(pTextMask, false, nullptr, false);
     for (size_t i = 0; i < pPageObj->m_ClipPath.GetTextCount(); ++i) {
@@ -683,10 +906,48 @@ bool CPDF_RenderStatus::ProcessTransparency(CPDF_PageObject* pPageObj,
           &text_device, textobj->GetCharCodes(), textobj->GetCharPositions(),
           textobj->m_TextState.GetFont().Get(),
           textobj->m_TextState.GetFontSize(), textobj->GetTextMatrix(),
-          &new_matrix, textobj->m_GraphState.GetObject(), 0xffffffff, 0,
+          &text_matrix, textobj->m_GraphState.GetObject(), 0xffffffff, 0,
           nullptr, CFX_FillRenderOptions());
     }
+
+    // Nothing outside the text shows, so only render the group under it.
+    FX_RECT text_rect = GetMaskCoverageBox(pTextMask);
+    if (text_rect.IsEmpty())
+      return true;
+
+    if (text_rect.Width() != rect.Width() ||
+        text_rect.Height() != rect.Height()) {
+      pTextMask = pTextMask->Clone(&text_rect);
+      if (!pTextMask)
+        return true;
+    }
+    text_rect.Offset(rect.left, rect.top);
+    rect = text_rect;
+  }
+
+  int width = rect.Width();
+  int height = rect.Height();
+  CFX_DefaultRenderDevice bitmap_device;
+  RetainPtr<CFX_DIBitmap> backdrop;
+  if (!transparency.IsIsolated() &&
+      (m_pDevice->GetRenderCaps() & FXRC_GET_BITS)) {
+    backdrop =
+        pPool->Create(width, height, m_pDevice->GetCompatibleBitmapFormat());
+    if (!backdrop)
+      return true;
+    if (!m_pDevice->GetDIBits(backdrop, rect.left, rect.top))
+      backdrop.Reset();
   }
+  RetainPtr<CFX_DIBitmap> bitmap =
+      pPool->Create(width, height, FXDIB_Format::kArgb);
+  if (!bitmap_device.Attach(bitmap, false, backdrop, false))
+    return true;
+
+  bitmap->Clear(0);
+
+  CFX_Matrix new_matrix = mtObj2Device;
+  new_matrix.Translate(-rect.left, -rect.top);
+
   CPDF_RenderStatus bitmap_render(m_pContext.Get(), &bitmap_device);
   bitmap_render.SetOptions(m_Options);
   bitmap_render.SetStopObject(m_pStopObj.Get());
@@ -744,13 +1005,12 @@ RetainPtr<CFX_DIBitmap> CPDF_RenderStatus::GetBackdrop(
     bool bBackAlphaRequired) {
   int width = bbox.Width();
   int height = bbox.Height();
-  auto pBackdrop = pdfium::MakeRetain<CFX_DIBitmap>();
-  if (bBackAlphaRequired && !m_bDropObjects)
-    pBackdrop->Create(width, height, FXDIB_Format::kArgb);
-  else
-    m_pDevice->CreateCompatibleBitmap(pBackdrop, width, height);
-
-  if (!pBackdrop->GetBuffer())
+  FXDIB_Format format = bBackAlphaRequired && !m_bDropObjects
+                            ? FXDIB_Format::kArgb
+                            : m_pDevice->GetCompatibleBitmapFormat();
+  RetainPtr<CFX_DIBitmap> pBackdrop =
+      m_pContext->GetBitmapPool()->Create(width, height, format);
+  if (!pBackdrop)
     return nullptr;
 
   bool bNeedDraw;
@@ -759,10 +1019,9 @@ RetainPtr<CFX_DIBitmap> CPDF_RenderStatus::GetBackdrop(
   else
     bNeedDraw = !(m_pDevice->GetRenderCaps() & FXRC_GET_BITS);
 
-  if (!bNeedDraw) {
-    m_pDevice->GetDIBits(pBackdrop, bbox.left, bbox.top);
+  if (!bNeedDraw && m_pDevice->GetDIBits(pBackdrop, bbox.left, bbox.top))
     return pBackdrop;
-  }
+
   CFX_Matrix FinalMatrix = m_DeviceMatrix;
   FinalMatrix.Translate(-bbox.left, -bbox.top);
   pBackdrop->Clear(pBackdrop->IsAlphaFormat() ? 0 : 0xffffffff);
@@ -872,6 +1131,16 @@ bool CPDF_RenderStatus::ProcessText(CPDF_TextObject* textobj,
     return true;
 
   float font_size = textobj->m_TextState.GetFontSize();
+  if (m_Options.GetOptions().bThumbnail && !is_clip && !bPattern &&
+      fabsf(font_size) * (text_matrix * mtObj2Device).GetYUnit() <
+          kThumbnailTextBarSize) {
+    // Glyphs this small cannot be read anyway. Half the text color is about
+    // what their anti-aliased coverage averages out to.
+    FX_RECT rect = textobj->GetTransformedBBox(mtObj2Device);
+    m_pDevice->FillRect(
+        rect, FXARGB_MUL_ALPHA(is_fill ? fill_argb : stroke_argb, 128));
+    return true;
+  }
   if (bPattern) {
     DrawTextPathWithPattern(textobj, mtObj2Device, pFont.Get(), font_size,
                             text_matrix, is_fill, is_stroke);
@@ -1163,6 +1432,9 @@ void CPDF_RenderStatus::ProcessShading(const CPDF_ShadingObject* pShadingObj,
   if (rect.IsEmpty())
     return;
 
+  if (m_Options.GetOptions().bThumbnail && IsBelowThumbnailDetailCutoff(rect))
+    return;
+
   CFX_Matrix matrix = pShadingObj->matrix() * mtObj2Device;
   CPDF_RenderShading::Draw(
       m_pDevice, m_pContext.Get(), m_pCurObj.Get(), pShadingObj->pattern(),
@@ -1208,6 +1480,12 @@ void CPDF_RenderStatus::DrawPathWithPattern(CPDF_PathObject* path_obj,
   if (!pattern)
     return;
 
+  if (m_Options.GetOptions().bThumbnail &&
+      IsBelowThumbnailDetailCutoff(
+          GetObjectClippedRect(path_obj, mtObj2Device))) {
+    return;
+  }
+
   if (CPDF_TilingPattern* pTilingPattern = pattern->AsTilingPattern())
     DrawTilingPattern(pTilingPattern, path_obj, mtObj2Device, stroke);
   else if (CPDF_ShadingPattern* pShadingPattern = pattern->AsShadingPattern())
@@ -1357,9 +1635,11 @@ void CPDF_RenderStatus::CompositeDIBitmap(
                                pDIBitmap, 0, 0, blend_mode, nullptr, false);
   }
 
-  auto pBackdrop1 = pdfium::MakeRetain<CFX_DIBitmap>();
-  pBackdrop1->Create(pBackdrop->GetWidth(), pBackdrop->GetHeight(),
-                     FXDIB_Format::kRgb32);
+  RetainPtr<CFX_DIBitmap> pBackdrop1 = m_pContext->GetBitmapPool()->Create(
+      pBackdrop->GetWidth(), pBackdrop->GetHeight(), FXDIB_Format::kRgb32);
+  if (!pBackdrop1)
+    return;
+
   pBackdrop1->Clear((uint32_t)-1);
   pBackdrop1->CompositeBitmap(0, 0, pBackdrop->GetWidth(),
                               pBackdrop->GetHeight(), pBackdrop, 0, 0,
@@ -1405,10 +1685,11 @@ RetainPtr<CFX_DIBitmap> CPDF_RenderStatus::LoadSMask(
 #else
   format = bLuminosity ? FXDIB_Format::kRgb : FXDIB_Format::k8bppMask;
 #endif
-  if (!bitmap_device.Create(width, height, format, nullptr))
+  CFX_BitmapPool* pPool = m_pContext->GetBitmapPool();
+  RetainPtr<CFX_DIBitmap> bitmap = pPool->Create(width, height, format);
+  if (!bitmap_device.Attach(bitmap, false, nullptr, false))
     return nullptr;
 
-  RetainPtr<CFX_DIBitmap> bitmap = bitmap_device.GetBitmap();
   CPDF_ColorSpace::Family nCSFamily = CPDF_ColorSpace::Family::kUnknown;
   if (bLuminosity) {
     FX_ARGB back_color =
@@ -1433,43 +1714,42 @@ RetainPtr<CFX_DIBitmap> CPDF_RenderStatus::LoadSMask(
   status.Initialize(nullptr, nullptr);
   status.RenderObjectList(&form, matrix);
 
-  auto pMask = pdfium::MakeRetain<CFX_DIBitmap>();
-  if (!pMask->Create(width, height, FXDIB_Format::k8bppMask))
-    return nullptr;
-
-  uint8_t* dest_buf = pMask->GetBuffer();
-  int dest_pitch = pMask->GetPitch();
-  uint8_t* src_buf = bitmap->GetBuffer();
-  int src_pitch = bitmap->GetPitch();
-  std::vector<uint8_t, FxAllocAllocator<uint8_t>> transfers(256);
+  std::vector<uint8_t, FxAllocAllocator<uint8_t>> transfers;
   if (pFunc) {
+    transfers.resize(256);
     std::vector<float> results(pFunc->CountOutputs());
     for (size_t i = 0; i < transfers.size(); ++i) {
       float input = i / 255.0f;
       pFunc->Call(pdfium::make_span(&input, 1), results);
       transfers[i] = FXSYS_roundf(results[0] * 255);
     }
-  } else {
-    // Fill |transfers| with 0, 1, ... N.
-    std::iota(transfers.begin(), transfers.end(), 0);
   }
-  if (bLuminosity) {
-    int Bpp = bitmap->GetBPP() / 8;
-    for (int row = 0; row < height; row++) {
-      uint8_t* dest_pos = dest_buf + row * dest_pitch;
-      uint8_t* src_pos = src_buf + row * src_pitch;
-      for (int col = 0; col < width; col++) {
-        *dest_pos++ = transfers[FXRGB2GRAY(src_pos[2], src_pos[1], *src_pos)];
-        src_pos += Bpp;
-      }
-    }
-  } else if (pFunc) {
-    int size = dest_pitch * height;
-    for (int i = 0; i < size; i++) {
-      dest_buf[i] = transfers[src_buf[i]];
+
+  // An alpha mask is rendered as k8bppMask already, so it is the result once
+  // the transfer function is applied.
+  if (!bLuminosity) {
+    if (pFunc) {
+      for (int row = 0; row < height; row++)
+        ApplyTransfers(transfers, bitmap->GetWritableScanline(row), width);
     }
-  } else {
-    memcpy(dest_buf, src_buf, dest_pitch * height);
+    return bitmap;
+  }
+
+  RetainPtr<CFX_DIBitmap> pMask =
+      pPool->Create(width, height, FXDIB_Format::k8bppMask);
+  if (!pMask)
+    return nullptr;
+
+  const int Bpp = bitmap->GetBPP() / 8;
+  for (int row = 0; row < height; row++) {
+    uint8_t* dest_scan = pMask->GetWritableScanline(row);
+    const uint8_t* src_scan = bitmap->GetScanline(row);
+    if (Bpp == 4)
+      GetLuminosityRow<4>(src_scan, width, dest_scan);
+    else
+      GetLuminosityRow<3>(src_scan, width, dest_scan);
+    if (pFunc)
+      ApplyTransfers(transfers, dest_scan, width);
   }
   return pMask;
 }
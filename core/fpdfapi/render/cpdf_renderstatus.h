@@ -103,6 +103,13 @@ class CPDF_RenderStatus {
 
   FX_ARGB GetFillArgb(CPDF_PageObject* pObj) const;
   FX_ARGB GetFillArgbForType3(CPDF_PageObject* pObj) const;
+  FX_ARGB GetStrokeArgb(CPDF_PageObject* pObj) const;
+
+  // Returns the options ProcessPath() draws |path_obj| with.
+  CFX_FillRenderOptions GetPathFillOptions(
+      const CPDF_PathObject* path_obj,
+      CFX_FillRenderOptions::FillType fill_type,
+      bool stroke) const;
 
   void DrawTilingPattern(CPDF_TilingPattern* pPattern,
                          CPDF_PageObject* pPageObj,
@@ -165,6 +172,10 @@ class CPDF_RenderStatus {
                                bool stroke);
   bool ProcessForm(const CPDF_FormObject* pFormObj,
                    const CFX_Matrix& mtObj2Device);
+  // Draws |pFormObj| from the document's form bitmap cache, rendering and
+  // caching it first if needed. Returns false if the form is not cacheable.
+  bool DrawFormWithCache(const CPDF_FormObject* pFormObj,
+                         const CFX_Matrix& mtObj2Device);
   FX_RECT GetClippedBBox(const FX_RECT& rect) const;
   RetainPtr<CFX_DIBitmap> GetBackdrop(const CPDF_PageObject* pObj,
                                       const FX_RECT& rect,
@@ -176,7 +187,6 @@ class CPDF_RenderStatus {
   FX_ARGB GetBackColor(const CPDF_Dictionary* pSMaskDict,
                        const CPDF_Dictionary* pGroupDict,
                        CPDF_ColorSpace::Family* pCSFamily);
-  FX_ARGB GetStrokeArgb(CPDF_PageObject* pObj) const;
   FX_RECT GetObjectClippedRect(const CPDF_PageObject* pObj,
                                const CFX_Matrix& mtObj2Device) const;
 
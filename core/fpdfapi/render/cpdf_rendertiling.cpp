@@ -6,16 +6,21 @@
 
 #include "core/fpdfapi/render/cpdf_rendertiling.h"
 
+#include <algorithm>
+#include <array>
 #include <limits>
 #include <memory>
 
 #include "core/fpdfapi/page/cpdf_form.h"
 #include "core/fpdfapi/page/cpdf_tilingpattern.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/render/cpdf_docrenderdata.h"
 #include "core/fpdfapi/render/cpdf_pagerendercache.h"
 #include "core/fpdfapi/render/cpdf_rendercontext.h"
 #include "core/fpdfapi/render/cpdf_renderoptions.h"
 #include "core/fpdfapi/render/cpdf_renderstatus.h"
+#include "core/fpdfapi/render/cpdf_tilingcellcache.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
 
@@ -64,6 +69,130 @@ RetainPtr<CFX_DIBitmap> DrawPatternBitmap(
   return pBitmap;
 }
 
+uint32_t GetCellCacheOptions(const CPDF_RenderOptions& options) {
+  const CPDF_RenderOptions::Options& flags = options.GetOptions();
+  uint32_t result = options.ColorModeIs(CPDF_RenderOptions::kGray) ? 1 : 0;
+  result |= flags.bClearType ? 1 << 1 : 0;
+  result |= flags.bNoNativeText ? 1 << 2 : 0;
+  result |= flags.bRectAA ? 1 << 3 : 0;
+  result |= flags.bBreakForMasks ? 1 << 4 : 0;
+  result |= flags.bNoTextSmooth ? 1 << 5 : 0;
+  result |= flags.bNoPathSmooth ? 1 << 6 : 0;
+  result |= flags.bNoImageSmooth ? 1 << 7 : 0;
+  result |= flags.bConvertFillToStroke ? 1 << 8 : 0;
+  result |= flags.bThumbnail ? 1 << 9 : 0;
+  return result;
+}
+
+std::array<float, 6> GetMatrixArray(const CFX_Matrix& matrix) {
+  return {matrix.a, matrix.b, matrix.c, matrix.d, matrix.e, matrix.f};
+}
+
+// Renders a cell of |pPattern| that is |width| by |height| device pixels.
+RetainPtr<CFX_DIBitmap> RenderPatternCell(
+    CPDF_RenderContext* pContext,
+    CPDF_TilingPattern* pPattern,
+    CPDF_Form* pPatternForm,
+    const CFX_Matrix& mtObj2Device,
+    int width,
+    int height,
+    const CPDF_RenderOptions& options) {
+  RetainPtr<CFX_DIBitmap> pPatternBitmap;
+  if (width * height < 16) {
+    RetainPtr<CFX_DIBitmap> pEnlargedBitmap = DrawPatternBitmap(
+        pContext->GetDocument(), pContext->GetPageCache(), pPattern,
+        pPatternForm, mtObj2Device, 8, 8, options.GetOptions());
+    if (!pEnlargedBitmap)
+      return nullptr;
+
+    pPatternBitmap = pEnlargedBitmap->StretchTo(
+        width, height, FXDIB_ResampleOptions(), nullptr);
+  } else {
+    pPatternBitmap = DrawPatternBitmap(
+        pContext->GetDocument(), pContext->GetPageCache(), pPattern,
+        pPatternForm, mtObj2Device, width, height, options.GetOptions());
+  }
+  if (!pPatternBitmap)
+    return nullptr;
+
+  if (options.ColorModeIs(CPDF_RenderOptions::kGray))
+    pPatternBitmap->ConvertColorScale(0, 0xffffff);
+  return pPatternBitmap;
+}
+
+// Returns the cell from the document's cell cache, rendering it on a miss.
+// The returned bitmap may be shared and must not be modified.
+RetainPtr<CFX_DIBitmap> GetPatternCell(CPDF_RenderContext* pContext,
+                                       CPDF_TilingPattern* pPattern,
+                                       CPDF_Form* pPatternForm,
+                                       const CFX_Matrix& mtObj2Device,
+                                       int width,
+                                       int height,
+                                       const CPDF_RenderOptions& options) {
+  const CPDF_Stream* pStream = pPattern->pattern_obj()->AsStream();
+  if (!pStream) {
+    return RenderPatternCell(pContext, pPattern, pPatternForm, mtObj2Device,
+                             width, height, options);
+  }
+
+  CPDF_TilingCellCache::Key key;
+  key.stream.Reset(pStream);
+  key.parent_matrix = GetMatrixArray(pPattern->parent_matrix());
+  key.matrix = {mtObj2Device.a, mtObj2Device.b, mtObj2Device.c,
+                mtObj2Device.d};
+  key.width = width;
+  key.height = height;
+  key.options = GetCellCacheOptions(options);
+
+  CPDF_TilingCellCache* pCache =
+      CPDF_DocRenderData::FromDocument(pContext->GetDocument())
+          ->GetTilingCellCache();
+  RetainPtr<CFX_DIBitmap> pCell;
+  if (pCache->Lookup(key, &pCell))
+    return pCell;
+
+  pCell = RenderPatternCell(pContext, pPattern, pPatternForm, mtObj2Device,
+                            width, height, options);
+  if (pCell)
+    pCache->Add(key, pCell, pCell->GetPitch() * pCell->GetHeight());
+  return pCell;
+}
+
+// Tiles |pScreen| with the non-overlapping cells of an aligned pattern.
+// Composing onto the transparent screen does not depend on what is below,
+// so one composed cell is replicated with row copies. |origin_x| and
+// |origin_y| are the screen position of a cell.
+void ReplicateAlignedCell(const RetainPtr<CFX_DIBitmap>& pScreen,
+                          const RetainPtr<CFX_DIBitmap>& pCell,
+                          int origin_x,
+                          int origin_y) {
+  const int cell_width = pCell->GetWidth();
+  const int cell_height = pCell->GetHeight();
+  const int screen_width = pScreen->GetWidth();
+  const int screen_height = pScreen->GetHeight();
+  const int first_cell_x = ((-origin_x) % cell_width + cell_width) % cell_width;
+  const int first_cell_y =
+      ((-origin_y) % cell_height + cell_height) % cell_height;
+  for (int row = 0; row < screen_height; ++row) {
+    uint8_t* dest_scan = pScreen->GetWritableScanline(row);
+    if (row >= cell_height) {
+      memcpy(dest_scan, pScreen->GetScanline(row - cell_height),
+             screen_width * 4);
+      continue;
+    }
+
+    const uint8_t* src_scan =
+        pCell->GetScanline((first_cell_y + row) % cell_height);
+    int cell_x = first_cell_x;
+    for (int col = 0; col < screen_width;) {
+      int run = std::min(cell_width - cell_x, screen_width - col);
+      memcpy(dest_scan + col * 4, src_scan + cell_x * 4, run * 4);
+      col += run;
+      cell_x = 0;
+    }
+  }
+}
+
 }  // namespace
 
 // static
@@ -168,24 +297,12 @@ RetainPtr<CFX_DIBitmap> CPDF_RenderTiling::Draw(
   }
   float left_offset = cell_bbox.left - mtPattern2Device.e;
   float top_offset = cell_bbox.bottom - mtPattern2Device.f;
-  RetainPtr<CFX_DIBitmap> pPatternBitmap;
-  if (width * height < 16) {
-    RetainPtr<CFX_DIBitmap> pEnlargedBitmap = DrawPatternBitmap(
-        pContext->GetDocument(), pContext->GetPageCache(), pPattern,
-        pPatternForm, mtObj2Device, 8, 8, options.GetOptions());
-    pPatternBitmap = pEnlargedBitmap->StretchTo(
-        width, height, FXDIB_ResampleOptions(), nullptr);
-  } else {
-    pPatternBitmap = DrawPatternBitmap(
-        pContext->GetDocument(), pContext->GetPageCache(), pPattern,
-        pPatternForm, mtObj2Device, width, height, options.GetOptions());
-  }
+  RetainPtr<CFX_DIBitmap> pPatternBitmap =
+      GetPatternCell(pContext, pPattern, pPatternForm, mtObj2Device, width,
+                     height, options);
   if (!pPatternBitmap)
     return nullptr;
 
-  if (options.ColorModeIs(CPDF_RenderOptions::kGray))
-    pPatternBitmap->ConvertColorScale(0, 0xffffff);
-
   FX_ARGB fill_argb = pRenderStatus->GetFillArgb(pPageObj);
   int clip_width = clip_box.right - clip_box.left;
   int clip_height = clip_box.bottom - clip_box.top;
@@ -194,6 +311,25 @@ RetainPtr<CFX_DIBitmap> CPDF_RenderTiling::Draw(
     return nullptr;
 
   pScreen->Clear(0);
+  if (bAligned && width * height > 1) {
+    auto pCell = pdfium::MakeRetain<CFX_DIBitmap>();
+    if (!pCell->Create(width, height, FXDIB_Format::kArgb))
+      return nullptr;
+
+    pCell->Clear(0);
+    if (pPattern->colored()) {
+      pCell->CompositeBitmap(0, 0, width, height, pPatternBitmap, 0, 0,
+                             BlendMode::kNormal, nullptr, false);
+    } else {
+      pCell->CompositeMask(0, 0, width, height, pPatternBitmap, fill_argb, 0,
+                           0, BlendMode::kNormal, nullptr, false);
+    }
+    ReplicateAlignedCell(pScreen, pCell,
+                         FXSYS_roundf(mtPattern2Device.e) - clip_box.left,
+                         FXSYS_roundf(mtPattern2Device.f) - clip_box.top);
+    return pScreen;
+  }
+
   const uint8_t* const src_buf = pPatternBitmap->GetBuffer();
   for (int col = min_col; col <= max_col; col++) {
     for (int row = min_row; row <= max_row; row++) {
@@ -140,6 +140,18 @@ bool CPDF_TextRenderer::DrawNormalText(CFX_RenderDevice* pDevice,
                                        const CPDF_RenderOptions& options) {
   std::vector<TextCharPos> pos =
       GetCharPosList(char_codes, char_pos, pFont, font_size);
+  return DrawCharPosList(pDevice, pos, pFont, font_size, mtText2Device,
+                         fill_argb, options);
+}
+
+// static
+bool CPDF_TextRenderer::DrawCharPosList(CFX_RenderDevice* pDevice,
+                                        pdfium::span<const TextCharPos> pos,
+                                        CPDF_Font* pFont,
+                                        float font_size,
+                                        const CFX_Matrix& mtText2Device,
+                                        FX_ARGB fill_argb,
+                                        const CPDF_RenderOptions& options) {
   if (pos.empty())
     return true;
 
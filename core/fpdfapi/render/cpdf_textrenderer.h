@@ -19,6 +19,7 @@ class CFX_GraphStateData;
 class CFX_Path;
 class CPDF_RenderOptions;
 class CPDF_Font;
+class TextCharPos;
 struct CFX_FillRenderOptions;
 
 class CPDF_TextRenderer {
@@ -55,6 +56,15 @@ class CPDF_TextRenderer {
                              FX_ARGB fill_argb,
                              const CPDF_RenderOptions& options);
 
+  // Same as DrawNormalText(), for glyph positions from GetCharPosList().
+  static bool DrawCharPosList(CFX_RenderDevice* pDevice,
+                              pdfium::span<const TextCharPos> pos,
+                              CPDF_Font* pFont,
+                              float font_size,
+                              const CFX_Matrix& mtText2Device,
+                              FX_ARGB fill_argb,
+                              const CPDF_RenderOptions& options);
+
   CPDF_TextRenderer() = delete;
   CPDF_TextRenderer(const CPDF_TextRenderer&) = delete;
   CPDF_TextRenderer& operator=(const CPDF_TextRenderer&) = delete;
@@ -0,0 +1,29 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/render/cpdf_tilingcellcache.h"
+
+#include <tuple>
+
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+
+CPDF_TilingCellCacheKey::CPDF_TilingCellCacheKey() = default;
+
+CPDF_TilingCellCacheKey::CPDF_TilingCellCacheKey(
+    const CPDF_TilingCellCacheKey& that) = default;
+
+CPDF_TilingCellCacheKey::~CPDF_TilingCellCacheKey() = default;
+
+bool CPDF_TilingCellCacheKey::operator<(
+    const CPDF_TilingCellCacheKey& that) const {
+  return std::tie(stream, parent_matrix, matrix, width, height, options) <
+         std::tie(that.stream, that.parent_matrix, that.matrix, that.width,
+                  that.height, that.options);
+}
+
+CPDF_TilingCellCache::CPDF_TilingCellCache()
+    : LruCache(kDefaultMaxBytes, /*max_value_share=*/4) {}
+
+CPDF_TilingCellCache::~CPDF_TilingCellCache() = default;
@@ -0,0 +1,50 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_RENDER_CPDF_TILINGCELLCACHE_H_
+#define CORE_FPDFAPI_RENDER_CPDF_TILINGCELLCACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+
+#include "core/fxcrt/lru_cache.h"
+#include "core/fxcrt/retain_ptr.h"
+
+class CFX_DIBitmap;
+class CPDF_Stream;
+
+// Everything CPDF_RenderTiling uses to render a cell: the pattern stream, the
+// matrix its content is parsed with, the linear part of the pattern object to
+// device matrix, the cell size and the render options. The cell is rendered
+// at the bitmap origin, so the translation of the matrix does not matter.
+struct CPDF_TilingCellCacheKey {
+  CPDF_TilingCellCacheKey();
+  CPDF_TilingCellCacheKey(const CPDF_TilingCellCacheKey& that);
+  ~CPDF_TilingCellCacheKey();
+
+  bool operator<(const CPDF_TilingCellCacheKey& that) const;
+
+  RetainPtr<const CPDF_Stream> stream;
+  std::array<float, 6> parent_matrix = {};
+  std::array<float, 4> matrix = {};
+  int width = 0;
+  int height = 0;
+  uint32_t options = 0;
+};
+
+// Document-wide cache of rendered tiling pattern cells, so a pattern that
+// fills many paths, possibly on many pages, is only rendered once per device
+// cell size. The cached bitmaps are shared and must not be modified.
+class CPDF_TilingCellCache final
+    : public LruCache<CPDF_TilingCellCacheKey, RetainPtr<CFX_DIBitmap>> {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 16 * 1024 * 1024;
+
+  CPDF_TilingCellCache();
+  ~CPDF_TilingCellCache();
+};
+
+#endif  // CORE_FPDFAPI_RENDER_CPDF_TILINGCELLCACHE_H_
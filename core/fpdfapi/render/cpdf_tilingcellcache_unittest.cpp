@@ -0,0 +1,93 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/render/cpdf_tilingcellcache.h"
+
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+RetainPtr<CFX_DIBitmap> CreateCell(int width, int height) {
+  auto pBitmap = pdfium::MakeRetain<CFX_DIBitmap>();
+  EXPECT_TRUE(pBitmap->Create(width, height, FXDIB_Format::k8bppMask));
+  return pBitmap;
+}
+
+void AddCell(CPDF_TilingCellCache* cache,
+             const CPDF_TilingCellCache::Key& key,
+             const RetainPtr<CFX_DIBitmap>& pCell) {
+  cache->Add(key, pCell, pCell->GetPitch() * pCell->GetHeight());
+}
+
+bool IsCached(CPDF_TilingCellCache* cache,
+              const CPDF_TilingCellCache::Key& key) {
+  RetainPtr<CFX_DIBitmap> pCell;
+  return cache->Lookup(key, &pCell);
+}
+
+CPDF_TilingCellCache::Key CreateKey(const RetainPtr<CPDF_Stream>& pStream,
+                                    int size) {
+  CPDF_TilingCellCache::Key key;
+  key.stream = pStream;
+  key.matrix = {1, 0, 0, 1};
+  key.width = size;
+  key.height = size;
+  return key;
+}
+
+}  // namespace
+
+TEST(CPDF_TilingCellCache, LookupAndAdd) {
+  auto pStream = pdfium::MakeRetain<CPDF_Stream>();
+  CPDF_TilingCellCache cache;
+  CPDF_TilingCellCache::Key key = CreateKey(pStream, 4);
+  EXPECT_FALSE(IsCached(&cache, key));
+
+  RetainPtr<CFX_DIBitmap> pCell = CreateCell(4, 4);
+  AddCell(&cache, key, pCell);
+  RetainPtr<CFX_DIBitmap> pFound;
+  ASSERT_TRUE(cache.Lookup(key, &pFound));
+  EXPECT_EQ(pCell, pFound);
+
+  CPDF_TilingCellCache::Key other_matrix = key;
+  other_matrix.matrix[0] = 2;
+  EXPECT_FALSE(IsCached(&cache, other_matrix));
+  CPDF_TilingCellCache::Key other_options = key;
+  other_options.options = 1;
+  EXPECT_FALSE(IsCached(&cache, other_options));
+
+  CPDF_TilingCellCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(1u, stats.hits);
+  EXPECT_EQ(3u, stats.misses);
+  EXPECT_EQ(16u, stats.bytes);
+  EXPECT_EQ(1u, stats.entries);
+}
+
+TEST(CPDF_TilingCellCache, EvictLeastRecentlyUsed) {
+  auto pStream = pdfium::MakeRetain<CPDF_Stream>();
+  CPDF_TilingCellCache cache;
+  cache.SetMaxBytes(64);
+  for (int i = 1; i <= 4; ++i)
+    AddCell(&cache, CreateKey(pStream, i), CreateCell(4, 4));
+
+  // Touch the first cell, so the second one is evicted next.
+  EXPECT_TRUE(IsCached(&cache, CreateKey(pStream, 1)));
+  AddCell(&cache, CreateKey(pStream, 5), CreateCell(4, 4));
+  CPDF_TilingCellCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(1u, stats.evictions);
+  EXPECT_EQ(64u, stats.bytes);
+  EXPECT_TRUE(IsCached(&cache, CreateKey(pStream, 1)));
+  EXPECT_FALSE(IsCached(&cache, CreateKey(pStream, 2)));
+
+  // Larger than a quarter of the budget.
+  AddCell(&cache, CreateKey(pStream, 6), CreateCell(4, 5));
+  EXPECT_FALSE(IsCached(&cache, CreateKey(pStream, 6)));
+
+  cache.SetMaxBytes(0);
+  stats = cache.GetStats();
+  EXPECT_EQ(5u, stats.evictions);
+  EXPECT_EQ(0u, stats.entries);
+}
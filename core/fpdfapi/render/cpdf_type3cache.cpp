@@ -9,11 +9,15 @@
 #include <math.h>
 #include <stdarg.h>
 
+#include <array>
 #include <memory>
 #include <utility>
 
 #include "core/fpdfapi/font/cpdf_type3char.h"
 #include "core/fpdfapi/font/cpdf_type3font.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/render/cpdf_docrenderdata.h"
+#include "core/fpdfapi/render/cpdf_type3glyphcache.h"
 #include "core/fpdfapi/render/cpdf_type3glyphmap.h"
 #include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/fx_safe_types.h"
@@ -92,6 +96,11 @@ int DetectLastScan(const RetainPtr<CFX_DIBitmap>& pBitmap) {
   return -1;
 }
 
+std::array<int, 4> GetMatrixKey(const CFX_Matrix& mtMatrix) {
+  return {FXSYS_roundf(mtMatrix.a * 10000), FXSYS_roundf(mtMatrix.b * 10000),
+          FXSYS_roundf(mtMatrix.c * 10000), FXSYS_roundf(mtMatrix.d * 10000)};
+}
+
 }  // namespace
 
 CPDF_Type3Cache::CPDF_Type3Cache(CPDF_Type3Font* pFont) : m_pFont(pFont) {}
@@ -100,10 +109,10 @@ CPDF_Type3Cache::~CPDF_Type3Cache() = default;
 
 const CFX_GlyphBitmap* CPDF_Type3Cache::LoadGlyph(uint32_t charcode,
                                                   const CFX_Matrix& mtMatrix) {
+  std::array<int, 4> matrix_key = GetMatrixKey(mtMatrix);
   UniqueKeyGen keygen;
-  keygen.Generate(
-      4, FXSYS_roundf(mtMatrix.a * 10000), FXSYS_roundf(mtMatrix.b * 10000),
-      FXSYS_roundf(mtMatrix.c * 10000), FXSYS_roundf(mtMatrix.d * 10000));
+  keygen.Generate(4, matrix_key[0], matrix_key[1], matrix_key[2],
+                  matrix_key[3]);
   ByteString FaceGlyphsKey(keygen.m_Key, keygen.m_KeyLen);
   CPDF_Type3GlyphMap* pSizeCache;
   auto it = m_SizeMap.find(FaceGlyphsKey);
@@ -137,34 +146,62 @@ std::unique_ptr<CFX_GlyphBitmap> CPDF_Type3Cache::RenderGlyph(
   CFX_Matrix image_matrix = pChar->matrix() * text_matrix;
 
   RetainPtr<CFX_DIBitmap> pBitmap = pChar->GetBitmap();
-  RetainPtr<CFX_DIBitmap> pResBitmap;
-  int left = 0;
-  int top = 0;
+  bool bStretch = false;
+  bool bFlipped = false;
+  int top_line = 0;
+  int bottom_line = 0;
   if (fabs(image_matrix.b) < fabs(image_matrix.a) / 100 &&
       fabs(image_matrix.c) < fabs(image_matrix.d) / 100) {
-    int top_line = DetectFirstScan(pBitmap);
-    int bottom_line = DetectLastScan(pBitmap);
+    top_line = DetectFirstScan(pBitmap);
+    bottom_line = DetectLastScan(pBitmap);
     if (top_line == 0 && bottom_line == pBitmap->GetHeight() - 1) {
       float top_y = image_matrix.d + image_matrix.f;
       float bottom_y = image_matrix.f;
-      bool bFlipped = top_y > bottom_y;
+      bFlipped = top_y > bottom_y;
       if (bFlipped)
         std::swap(top_y, bottom_y);
       std::tie(top_line, bottom_line) = pSize->AdjustBlue(top_y, bottom_y);
-      FX_SAFE_INT32 safe_height = bFlipped ? top_line : bottom_line;
-      safe_height -= bFlipped ? bottom_line : top_line;
-      if (!safe_height.IsValid())
-        return nullptr;
-
-      pResBitmap = pBitmap->StretchTo(static_cast<int>(image_matrix.a),
-                                      safe_height.ValueOrDie(),
-                                      FXDIB_ResampleOptions(), nullptr);
-      top = top_line;
-      if (image_matrix.a < 0)
-        left = FXSYS_roundf(image_matrix.e + image_matrix.a);
-      else
-        left = FXSYS_roundf(image_matrix.e);
+      bStretch = true;
+    }
+  }
+
+  // The blue zone lines depend on the glyphs this font rendered before, so
+  // they go in the key to get the same bitmap as rendering it here would.
+  CPDF_Type3GlyphCache* pSharedCache = nullptr;
+  CPDF_Type3GlyphCache::Key key;
+  if (pChar->bitmap_is_inline_mask() && pChar->char_proc()) {
+    pSharedCache = CPDF_DocRenderData::FromDocument(m_pFont->GetDocument())
+                       ->GetType3GlyphCache();
+    key.char_proc.Reset(pChar->char_proc());
+    key.matrix = GetMatrixKey(mtMatrix);
+    key.stretched = bStretch;
+    if (bStretch) {
+      key.top_line = top_line;
+      key.bottom_line = bottom_line;
     }
+    CPDF_Type3GlyphCache::Value glyph;
+    if (pSharedCache->Lookup(key, &glyph))
+      return std::make_unique<CFX_GlyphBitmap>(glyph.left, glyph.top,
+                                               glyph.bitmap);
+  }
+
+  RetainPtr<CFX_DIBitmap> pResBitmap;
+  int left = 0;
+  int top = 0;
+  if (bStretch) {
+    FX_SAFE_INT32 safe_height = bFlipped ? top_line : bottom_line;
+    safe_height -= bFlipped ? bottom_line : top_line;
+    if (!safe_height.IsValid())
+      return nullptr;
+
+    pResBitmap = pBitmap->StretchTo(static_cast<int>(image_matrix.a),
+                                    safe_height.ValueOrDie(),
+                                    FXDIB_ResampleOptions(), nullptr);
+    top = top_line;
+    if (image_matrix.a < 0)
+      left = FXSYS_roundf(image_matrix.e + image_matrix.a);
+    else
+      left = FXSYS_roundf(image_matrix.e);
   }
   if (!pResBitmap)
     pResBitmap = pBitmap->TransformTo(image_matrix, &left, &top);
@@ -173,5 +210,13 @@ std::unique_ptr<CFX_GlyphBitmap> CPDF_Type3Cache::RenderGlyph(
 
   auto pGlyph = std::make_unique<CFX_GlyphBitmap>(left, -top);
   pGlyph->GetBitmap()->TakeOver(std::move(pResBitmap));
+  if (pSharedCache) {
+    CPDF_Type3GlyphCache::Value glyph;
+    glyph.bitmap = pGlyph->GetBitmap();
+    glyph.left = pGlyph->left();
+    glyph.top = pGlyph->top();
+    const size_t bytes = glyph.bitmap->GetPitch() * glyph.bitmap->GetHeight();
+    pSharedCache->Add(key, glyph, bytes);
+  }
   return pGlyph;
 }
@@ -0,0 +1,36 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/render/cpdf_type3glyphcache.h"
+
+#include <tuple>
+
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+
+CPDF_Type3GlyphCacheKey::CPDF_Type3GlyphCacheKey() = default;
+
+CPDF_Type3GlyphCacheKey::CPDF_Type3GlyphCacheKey(
+    const CPDF_Type3GlyphCacheKey& that) = default;
+
+CPDF_Type3GlyphCacheKey::~CPDF_Type3GlyphCacheKey() = default;
+
+bool CPDF_Type3GlyphCacheKey::operator<(
+    const CPDF_Type3GlyphCacheKey& that) const {
+  return std::tie(char_proc, matrix, stretched, top_line, bottom_line) <
+         std::tie(that.char_proc, that.matrix, that.stretched, that.top_line,
+                  that.bottom_line);
+}
+
+CPDF_Type3GlyphCacheValue::CPDF_Type3GlyphCacheValue() = default;
+
+CPDF_Type3GlyphCacheValue::CPDF_Type3GlyphCacheValue(
+    const CPDF_Type3GlyphCacheValue& that) = default;
+
+CPDF_Type3GlyphCacheValue::~CPDF_Type3GlyphCacheValue() = default;
+
+CPDF_Type3GlyphCache::CPDF_Type3GlyphCache()
+    : LruCache(kDefaultMaxBytes, /*max_value_share=*/4) {}
+
+CPDF_Type3GlyphCache::~CPDF_Type3GlyphCache() = default;
@@ -0,0 +1,60 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_RENDER_CPDF_TYPE3GLYPHCACHE_H_
+#define CORE_FPDFAPI_RENDER_CPDF_TYPE3GLYPHCACHE_H_
+
+#include <stddef.h>
+
+#include <array>
+
+#include "core/fxcrt/lru_cache.h"
+#include "core/fxcrt/retain_ptr.h"
+
+class CFX_DIBitmap;
+class CPDF_Stream;
+
+// The CharProc stream, the glyph to device matrix without its translation in
+// CPDF_Type3Cache units, and the blue zone aligned lines when the glyph is
+// stretched rather than transformed.
+struct CPDF_Type3GlyphCacheKey {
+  CPDF_Type3GlyphCacheKey();
+  CPDF_Type3GlyphCacheKey(const CPDF_Type3GlyphCacheKey& that);
+  ~CPDF_Type3GlyphCacheKey();
+
+  bool operator<(const CPDF_Type3GlyphCacheKey& that) const;
+
+  RetainPtr<const CPDF_Stream> char_proc;
+  std::array<int, 4> matrix = {};
+  bool stretched = false;
+  int top_line = 0;
+  int bottom_line = 0;
+};
+
+// A rendered glyph and its origin. The bitmap is shared and must not be
+// modified.
+struct CPDF_Type3GlyphCacheValue {
+  CPDF_Type3GlyphCacheValue();
+  CPDF_Type3GlyphCacheValue(const CPDF_Type3GlyphCacheValue& that);
+  ~CPDF_Type3GlyphCacheValue();
+
+  RetainPtr<CFX_DIBitmap> bitmap;
+  int left = 0;
+  int top = 0;
+};
+
+// Document-wide cache of rendered Type 3 glyphs that are a sole inline image
+// mask. Those only depend on the CharProc stream, so fonts that share
+// CharProcs, as per-page subsets of the same bitmap font often do, also
+// share the rendered glyphs.
+class CPDF_Type3GlyphCache final
+    : public LruCache<CPDF_Type3GlyphCacheKey, CPDF_Type3GlyphCacheValue> {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 4 * 1024 * 1024;
+
+  CPDF_Type3GlyphCache();
+  ~CPDF_Type3GlyphCache();
+};
+
+#endif  // CORE_FPDFAPI_RENDER_CPDF_TYPE3GLYPHCACHE_H_
@@ -0,0 +1,92 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/render/cpdf_type3glyphcache.h"
+
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+CPDF_Type3GlyphCache::Value CreateGlyph(int width, int height) {
+  CPDF_Type3GlyphCache::Value glyph;
+  glyph.bitmap = pdfium::MakeRetain<CFX_DIBitmap>();
+  EXPECT_TRUE(glyph.bitmap->Create(width, height, FXDIB_Format::k8bppMask));
+  glyph.left = 1;
+  glyph.top = -2;
+  return glyph;
+}
+
+void AddGlyph(CPDF_Type3GlyphCache* cache,
+              const CPDF_Type3GlyphCache::Key& key,
+              const CPDF_Type3GlyphCache::Value& glyph) {
+  cache->Add(key, glyph, glyph.bitmap->GetPitch() * glyph.bitmap->GetHeight());
+}
+
+CPDF_Type3GlyphCache::Key CreateKey(const RetainPtr<CPDF_Stream>& pStream,
+                                    int scale) {
+  CPDF_Type3GlyphCache::Key key;
+  key.char_proc = pStream;
+  key.matrix = {scale, 0, 0, scale};
+  return key;
+}
+
+}  // namespace
+
+TEST(CPDF_Type3GlyphCache, LookupAndAdd) {
+  auto pStream = pdfium::MakeRetain<CPDF_Stream>();
+  CPDF_Type3GlyphCache cache;
+  CPDF_Type3GlyphCache::Key key = CreateKey(pStream, 10000);
+  CPDF_Type3GlyphCache::Value found;
+  EXPECT_FALSE(cache.Lookup(key, &found));
+
+  CPDF_Type3GlyphCache::Value glyph = CreateGlyph(4, 4);
+  AddGlyph(&cache, key, glyph);
+  ASSERT_TRUE(cache.Lookup(key, &found));
+  EXPECT_EQ(glyph.bitmap, found.bitmap);
+  EXPECT_EQ(1, found.left);
+  EXPECT_EQ(-2, found.top);
+
+  CPDF_Type3GlyphCache::Key other_stream =
+      CreateKey(pdfium::MakeRetain<CPDF_Stream>(), 10000);
+  EXPECT_FALSE(cache.Lookup(other_stream, &found));
+  CPDF_Type3GlyphCache::Key other_lines = key;
+  other_lines.stretched = true;
+  other_lines.bottom_line = 4;
+  EXPECT_FALSE(cache.Lookup(other_lines, &found));
+
+  CPDF_Type3GlyphCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(1u, stats.hits);
+  EXPECT_EQ(3u, stats.misses);
+  EXPECT_EQ(16u, stats.bytes);
+  EXPECT_EQ(1u, stats.entries);
+}
+
+TEST(CPDF_Type3GlyphCache, EvictLeastRecentlyUsed) {
+  auto pStream = pdfium::MakeRetain<CPDF_Stream>();
+  CPDF_Type3GlyphCache cache;
+  cache.SetMaxBytes(64);
+  for (int i = 1; i <= 4; ++i)
+    AddGlyph(&cache, CreateKey(pStream, i), CreateGlyph(4, 4));
+
+  // Touch the first glyph, so the second one is evicted next.
+  CPDF_Type3GlyphCache::Value found;
+  EXPECT_TRUE(cache.Lookup(CreateKey(pStream, 1), &found));
+  AddGlyph(&cache, CreateKey(pStream, 5), CreateGlyph(4, 4));
+  CPDF_Type3GlyphCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(1u, stats.evictions);
+  EXPECT_EQ(64u, stats.bytes);
+  EXPECT_TRUE(cache.Lookup(CreateKey(pStream, 1), &found));
+  EXPECT_FALSE(cache.Lookup(CreateKey(pStream, 2), &found));
+
+  // Larger than a quarter of the budget.
+  AddGlyph(&cache, CreateKey(pStream, 6), CreateGlyph(4, 5));
+  EXPECT_FALSE(cache.Lookup(CreateKey(pStream, 6), &found));
+
+  cache.SetMaxBytes(0);
+  stats = cache.GetStats();
+  EXPECT_EQ(5u, stats.evictions);
+  EXPECT_EQ(0u, stats.entries);
+}
@@ -7,6 +7,7 @@
 #include "core/fxcodec/fax/faxmodule.h"
 
 #include <algorithm>
+#include <array>
 #include <iterator>
 #include <memory>
 #include <vector>
@@ -117,19 +118,20 @@ void FaxFillBits(uint8_t* dest_buf, int columns, int startpos, int endpos) {
   if (startpos >= endpos)
     return;
 
-  int first_byte = startpos / 8;
-  int last_byte = (endpos - 1) / 8;
+  // Clear the partial bytes at either end with masks, and the whole bytes in
+  // between with a single memset().
+  const int first_byte = startpos / 8;
+  const int last_byte = (endpos - 1) / 8;
+  const uint8_t first_mask = 0xff >> (startpos % 8);
+  const uint8_t last_mask =
+      static_cast<uint8_t>(0xff << (7 - (endpos - 1) % 8));
   if (first_byte == last_byte) {
-    for (int i = startpos % 8; i <= (endpos - 1) % 8; ++i)
-      dest_buf[first_byte] -= 1 << (7 - i);
+    dest_buf[first_byte] &= ~(first_mask & last_mask);
     return;
   }
 
-  for (int i = startpos % 8; i < 8; ++i)
-    dest_buf[first_byte] -= 1 << (7 - i);
-  for (int i = 0; i <= (endpos - 1) % 8; ++i)
-    dest_buf[last_byte] -= 1 << (7 - i);
-
+  dest_buf[first_byte] &= ~first_mask;
+  dest_buf[last_byte] &= ~last_mask;
   if (last_byte > first_byte + 1)
     memset(dest_buf + first_byte + 1, 0, last_byte - first_byte - 1);
 }
@@ -254,30 +256,157 @@ const uint8_t FaxWhiteRunIns[] = {
     0xff,
 };
 
-int FaxGetRun(const uint8_t* ins_array,
-              const uint8_t* src_buf,
-              int* bitpos,
-              int bitsize) {
-  uint32_t code = 0;
+// The longest run length code is 13 bits long, so any code can be decoded
+// with a single lookup into a table indexed by the next 13 bits.
+constexpr int kFaxMaxCodeBits = 13;
+constexpr int kFaxRunTableSize = 1 << kFaxMaxCodeBits;
+
+// Each entry holds the code length in the low 4 bits and the run length in the
+// upper 12 bits. An entry of 0 means no code matches.
+struct FaxRunTable {
+  int max_code_len;
+  std::array<uint16_t, kFaxRunTableSize> entries;
+};
+
+// Expands one of the instruction arrays above into a FaxRunTable. Codes are
+// added from shortest to longest, so when several codes match a bit pattern,
+// the table picks the same one as walking |ins_array| bit by bit would.
+FaxRunTable BuildFaxRunTable(const uint8_t* ins_array) {
+  FaxRunTable table = {};
   int ins_off = 0;
-  while (1) {
-    uint8_t ins = ins_array[ins_off++];
-    if (ins == 0xff)
-      return -1;
+  int code_len = 0;
+  while (ins_array[ins_off] != 0xff) {
+    const int count = ins_array[ins_off++];
+    ++code_len;
+    DCHECK_LE(code_len, kFaxMaxCodeBits);
+    for (int i = 0; i < count; ++i, ins_off += 3) {
+      const uint32_t code = ins_array[ins_off];
+      if (code >= (1u << code_len))
+        continue;
+
+      const int run = ins_array[ins_off + 1] + ins_array[ins_off + 2] * 256;
+      const uint16_t entry = static_cast<uint16_t>(run << 4 | code_len);
+      const int shift = kFaxMaxCodeBits - code_len;
+      const uint32_t first = code << shift;
+      const uint32_t last = first + (1u << shift);
+      for (uint32_t index = first; index < last; ++index) {
+        if (!table.entries[index])
+          table.entries[index] = entry;
+      }
+    }
+  }
+  table.max_code_len = code_len;
+  return table;
+}
 
-    if (*bitpos >= bitsize)
-      return -1;
+const FaxRunTable& GetFaxRunTable(bool white) {
+  static const FaxRunTable kWhiteTable = BuildFaxRunTable(FaxWhiteRunIns);
+  static const FaxRunTable kBlackTable = BuildFaxRunTable(FaxBlackRunIns);
+  return white ? kWhiteTable : kBlackTable;
+}
 
-    code <<= 1;
-    if (src_buf[*bitpos / 8] & (1 << (7 - *bitpos % 8)))
-      ++code;
+// Returns the |count| bits starting at |bitpos|, MSB first. Bits past the end
+// of the data read as 0.
+uint32_t PeekBits(const uint8_t* src_buf, int bitsize, int bitpos, int count) {
+  DCHECK_LE(count, 17);
+  const int byte_pos = bitpos / 8;
+  const int byte_size = (bitsize + 7) / 8;
+  uint32_t bits = 0;
+  for (int i = 0; i < 3; ++i) {
+    bits <<= 8;
+    if (byte_pos + i < byte_size)
+      bits |= src_buf[byte_pos + i];
+  }
+  return (bits >> (24 - count - bitpos % 8)) & ((1u << count) - 1);
+}
 
-    ++(*bitpos);
-    int next_off = ins_off + ins * 3;
-    for (; ins_off < next_off; ins_off += 3) {
-      if (ins_array[ins_off] == code)
-        return ins_array[ins_off + 1] + ins_array[ins_off + 2] * 256;
-    }
+int FaxGetRun(bool white, const uint8_t* src_buf, int* bitpos, int bitsize) {
+  if (*bitpos >= bitsize)
+    return -1;
+
+  const FaxRunTable& table = GetFaxRunTable(white);
+  const uint16_t entry =
+      table.entries[PeekBits(src_buf, bitsize, *bitpos, kFaxMaxCodeBits)];
+  const int code_len = entry & 0xf;
+  if (!code_len) {
+    // Consume as many bits as a bit-by-bit search would before giving up.
+    *bitpos = std::min(*bitpos + table.max_code_len, bitsize);
+    return -1;
+  }
+  if (code_len > bitsize - *bitpos) {
+    *bitpos = bitsize;
+    return -1;
+  }
+  *bitpos += code_len;
+  return entry >> 4;
+}
+
+enum class FaxMode : uint8_t {
+  kVertical,
+  kHorizontal,
+  kPass,
+  kExtension,
+  kEndOfFacsimileBlock,
+};
+
+struct FaxModeCode {
+  FaxMode mode;
+  int8_t v_delta;
+  uint8_t code_len;
+};
+
+// All 2D mode codes fit in 7 bits. Codes 0000001 and 0000000 introduce an
+// extension code and an EOFB respectively.
+constexpr int kFaxModeBits = 7;
+
+constexpr FaxModeCode GetFaxModeCode(uint32_t bits) {
+  int leading_zeros = 0;
+  while (leading_zeros < kFaxModeBits &&
+         !(bits & (1u << (kFaxModeBits - 1 - leading_zeros)))) {
+    ++leading_zeros;
+  }
+  switch (leading_zeros) {
+    case 0:
+      return {FaxMode::kVertical, 0, 1};
+    case 1:
+      return {FaxMode::kVertical, static_cast<int8_t>(bits & 0x10 ? 1 : -1), 3};
+    case 2:
+      return {FaxMode::kHorizontal, 0, 3};
+    case 3:
+      return {FaxMode::kPass, 0, 4};
+    case 4:
+      return {FaxMode::kVertical, static_cast<int8_t>(bits & 0x02 ? 2 : -2), 6};
+    case 5:
+      return {FaxMode::kVertical, static_cast<int8_t>(bits & 0x01 ? 3 : -3), 7};
+    case 6:
+      return {FaxMode::kExtension, 0, 7};
+    default:
+      return {FaxMode::kEndOfFacsimileBlock, 0, 7};
+  }
+}
+
+constexpr std::array<FaxModeCode, 1 << kFaxModeBits> BuildFaxModeTable() {
+  std::array<FaxModeCode, 1 << kFaxModeBits> table = {};
+  for (uint32_t i = 0; i < table.size(); ++i)
+    table[i] = GetFaxModeCode(i);
+  return table;
+}
+
+constexpr std::array<FaxModeCode, 1 << kFaxModeBits> kFaxModeTable =
+    BuildFaxModeTable();
+
+// Returns the length of the run made of one or more makeup codes followed by a
+// terminating code, or a negative value on error.
+int FaxGetRunLength(bool white,
+                    const uint8_t* src_buf,
+                    int* bitpos,
+                    int bitsize) {
+  int run_len = 0;
+  while (1) {
+    int run = FaxGetRun(white, src_buf, bitpos, bitsize);
+    run_len += run;
+    if (run < 64)
+      return run_len;
   }
 }
 
@@ -299,27 +428,19 @@ void FaxG4GetRow(const uint8_t* src_buf,
     int b2;
     FaxG4FindB1B2(ref_buf, columns, a0, a0color, &b1, &b2);
 
-    int v_delta = 0;
-    if (!NextBit(src_buf, bitpos)) {
-      if (*bitpos >= bitsize)
-        return;
-
-      bool bit1 = NextBit(src_buf, bitpos);
-      if (*bitpos >= bitsize)
-        return;
+    const FaxModeCode& code =
+        kFaxModeTable[PeekBits(src_buf, bitsize, *bitpos, kFaxModeBits)];
+    if (code.code_len > bitsize - *bitpos) {
+      *bitpos = bitsize;
+      return;
+    }
+    *bitpos += code.code_len;
 
-      bool bit2 = NextBit(src_buf, bitpos);
-      if (bit1) {
-        v_delta = bit2 ? 1 : -1;
-      } else if (bit2) {
-        int run_len1 = 0;
-        while (1) {
-          int run = FaxGetRun(a0color ? FaxWhiteRunIns : FaxBlackRunIns,
-                              src_buf, bitpos, bitsize);
-          run_len1 += run;
-          if (run < 64)
-            break;
-        }
+    switch (code.mode) {
+      case FaxMode::kVertical:
+        break;
+      case FaxMode::kHorizontal: {
+        int run_len1 = FaxGetRunLength(a0color, src_buf, bitpos, bitsize);
         if (a0 < 0)
           ++run_len1;
         if (run_len1 < 0)
@@ -329,14 +450,7 @@ void FaxG4GetRow(const uint8_t* src_buf,
         if (!a0color)
           FaxFillBits(dest_buf, columns, a0, a1);
 
-        int run_len2 = 0;
-        while (1) {
-          int run = FaxGetRun(a0color ? FaxBlackRunIns : FaxWhiteRunIns,
-                              src_buf, bitpos, bitsize);
-          run_len2 += run;
-          if (run < 64)
-            break;
-        }
+        int run_len2 = FaxGetRunLength(!a0color, src_buf, bitpos, bitsize);
         if (run_len2 < 0)
           return;
         a2 = a1 + run_len2;
@@ -348,50 +462,24 @@ void FaxG4GetRow(const uint8_t* src_buf,
           continue;
 
         return;
-      } else {
-        if (*bitpos >= bitsize)
-          return;
-
-        if (NextBit(src_buf, bitpos)) {
-          if (!a0color)
-            FaxFillBits(dest_buf, columns, a0, b2);
-
-          if (b2 >= columns)
-            return;
-
-          a0 = b2;
-          continue;
-        }
-
-        if (*bitpos >= bitsize)
-          return;
+      }
+      case FaxMode::kPass:
+        if (!a0color)
+          FaxFillBits(dest_buf, columns, a0, b2);
 
-        bool next_bit1 = NextBit(src_buf, bitpos);
-        if (*bitpos >= bitsize)
+        if (b2 >= columns)
           return;
 
-        bool next_bit2 = NextBit(src_buf, bitpos);
-        if (next_bit1) {
-          v_delta = next_bit2 ? 2 : -2;
-        } else if (next_bit2) {
-          if (*bitpos >= bitsize)
-            return;
-
-          v_delta = NextBit(src_buf, bitpos) ? 3 : -3;
-        } else {
-          if (*bitpos >= bitsize)
-            return;
-
-          if (NextBit(src_buf, bitpos)) {
-            *bitpos += 3;
-            continue;
-          }
-          *bitpos += 5;
-          return;
-        }
-      }
+        a0 = b2;
+        continue;
+      case FaxMode::kExtension:
+        *bitpos += 3;
+        continue;
+      case FaxMode::kEndOfFacsimileBlock:
+        *bitpos += 5;
+        return;
     }
-    a1 = b1 + v_delta;
+    a1 = b1 + code.v_delta;
     if (!a0color)
       FaxFillBits(dest_buf, columns, a0, a1);
 
@@ -431,8 +519,7 @@ void FaxGet1DLine(const uint8_t* src_buf,
 
     int run_len = 0;
     while (1) {
-      int run = FaxGetRun(color ? FaxWhiteRunIns : FaxBlackRunIns, src_buf,
-                          bitpos, bitsize);
+      int run = FaxGetRun(color, src_buf, bitpos, bitsize);
       if (run < 0) {
         while (*bitpos < bitsize) {
           if (NextBit(src_buf, bitpos))
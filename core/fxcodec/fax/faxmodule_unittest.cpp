@@ -0,0 +1,130 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/fax/faxmodule.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "core/fxcodec/scanlinedecoder.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// Packs a string of '0' and '1' characters into bytes, MSB first. Other
+// characters are ignored so codes can be separated with spaces.
+std::vector<uint8_t> BitsToBytes(const char* bits) {
+  std::vector<uint8_t> result;
+  int bitpos = 0;
+  for (const char* p = bits; *p; ++p) {
+    if (*p != '0' && *p != '1')
+      continue;
+    if (bitpos % 8 == 0)
+      result.push_back(0);
+    if (*p == '1')
+      result.back() |= 1 << (7 - bitpos % 8);
+    ++bitpos;
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(FaxModule, G4DecodeAllWhite) {
+  // One V0 code per row.
+  std::vector<uint8_t> src = BitsToBytes("111");
+  uint8_t dest[3 * 4];
+  EXPECT_EQ(3, FaxModule::FaxG4Decode(src.data(), src.size(), 0, 16, 3, 4,
+                                      dest));
+  for (uint8_t byte : dest)
+    EXPECT_EQ(0xff, byte);
+}
+
+TEST(FaxModule, G4DecodeHorizontalAndVertical) {
+  // Row 0: H, white 5, black 10, V0.
+  // Row 1: V0, V0, V0, copying row 0.
+  std::vector<uint8_t> src =
+      BitsToBytes("001 1100 0000100 1"
+                  "1 1 1");
+  uint8_t dest[2 * 4];
+  EXPECT_EQ(18, FaxModule::FaxG4Decode(src.data(), src.size(), 0, 32, 2, 4,
+                                       dest));
+  const uint8_t kExpectedRow[] = {0xf8, 0x01, 0xff, 0xff};
+  for (int row = 0; row < 2; ++row) {
+    for (int i = 0; i < 4; ++i)
+      EXPECT_EQ(kExpectedRow[i], dest[row * 4 + i]) << row << " " << i;
+  }
+}
+
+TEST(FaxModule, G4DecodeVerticalOffsetsAndPass) {
+  // Row 0: H, white 4, black 4, V0.
+  // Row 1: VR1, VL1, V0.
+  // Row 2: P, V0.
+  std::vector<uint8_t> src =
+      BitsToBytes("001 1011 011 1"
+                  "011 010 1"
+                  "0001 1");
+  uint8_t dest[3 * 4];
+  EXPECT_EQ(23, FaxModule::FaxG4Decode(src.data(), src.size(), 0, 16, 3, 4,
+                                       dest));
+  EXPECT_EQ(0xf0, dest[0]);
+  EXPECT_EQ(0xff, dest[1]);
+  EXPECT_EQ(0xf9, dest[4]);
+  EXPECT_EQ(0xff, dest[5]);
+  EXPECT_EQ(0xff, dest[8]);
+  EXPECT_EQ(0xff, dest[9]);
+}
+
+TEST(FaxModule, G4DecodeMakeupCodes) {
+  // H, white 2560 + 0, black 40.
+  std::vector<uint8_t> src =
+      BitsToBytes("001 000000011111 00110101 000001101100");
+  constexpr int kWidth = 2600;
+  constexpr int kPitch = 328;
+  std::vector<uint8_t> dest(kPitch);
+  EXPECT_EQ(35, FaxModule::FaxG4Decode(src.data(), src.size(), 0, kWidth, 1,
+                                       kPitch, dest.data()));
+  for (int i = 0; i < kPitch; ++i) {
+    if (i >= 320 && i < 325)
+      EXPECT_EQ(0x00, dest[i]) << i;
+    else
+      EXPECT_EQ(0xff, dest[i]) << i;
+  }
+}
+
+TEST(FaxModule, G4DecodeTruncated) {
+  // H, followed by an incomplete white run code.
+  std::vector<uint8_t> src = BitsToBytes("001 00000");
+  uint8_t dest[4];
+  EXPECT_EQ(8, FaxModule::FaxG4Decode(src.data(), src.size(), 0, 8, 1, 4,
+                                      dest));
+}
+
+TEST(FaxModule, G3Decode1D) {
+  // White 1728 + 2, black 64 + 0, white 6.
+  std::vector<uint8_t> src =
+      BitsToBytes("010011011 0111 0000001111 0000110111 1110");
+  constexpr int kWidth = 1800;
+  std::unique_ptr<ScanlineDecoder> decoder = FaxModule::CreateDecoder(
+      src, kWidth, 1, /*K=*/0, /*EndOfLine=*/false,
+      /*EncodedByteAlign=*/false, /*BlackIs1=*/false, /*Columns=*/0,
+      /*Rows=*/0);
+  ASSERT_TRUE(decoder);
+  const uint8_t* line = decoder->GetScanline(0);
+  ASSERT_TRUE(line);
+  for (int i = 0; i < kWidth; ++i) {
+    bool black = i >= 1730 && i < 1794;
+    EXPECT_EQ(black, !(line[i / 8] & (1 << (7 - i % 8)))) << i;
+  }
+}
+
+TEST(FaxModule, CreateDecoderBadParams) {
+  std::vector<uint8_t> src = BitsToBytes("1");
+  EXPECT_FALSE(FaxModule::CreateDecoder(src, 0, 1, -1, false, false, false, 0,
+                                        0));
+  EXPECT_FALSE(FaxModule::CreateDecoder(src, 1, 65536, -1, false, false,
+                                        false, 0, 0));
+}
@@ -20,6 +20,7 @@
 #include "core/fxcrt/fx_memory_wrappers.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "third_party/base/check.h"
+#include "third_party/base/check_op.h"
 #include "third_party/base/notreached.h"
 #include "third_party/base/numerics/safe_conversions.h"
 #include "third_party/base/span.h"
@@ -123,13 +124,20 @@ class CLZWDecoder {
   }
 
  private:
+  uint32_t ReadCode();
   void AddCode(uint32_t prefix_code, uint8_t append_char);
+  uint32_t GetStringLength(uint32_t code) const;
+  uint8_t GetFirstChar(uint32_t code) const;
+  void WriteString(uint32_t code, uint32_t length, uint8_t* dest) const;
   void DecodeString(uint32_t code);
   void ExpandDestBuf(uint32_t additional_size);
 
   pdfium::span<const uint8_t> const src_span_;
   std::unique_ptr<uint8_t, FxFreeDeleter> dest_buf_;
   uint32_t src_bit_pos_ = 0;
+  uint32_t src_byte_pos_ = 0;   // Next byte to load into |bit_buf_|.
+  uint64_t bit_buf_ = 0;        // Pending input bits, MSB first.
+  uint32_t bit_buf_size_ = 0;   // Number of valid bits in |bit_buf_|.
   uint32_t dest_buf_size_ = 0;  // Actual allocated size.
   uint32_t dest_byte_pos_ = 0;  // Size used.
   uint32_t stack_len_ = 0;
@@ -138,16 +146,42 @@ class CLZWDecoder {
   uint8_t code_len_ = 9;
   uint32_t current_code_ = 0;
   uint32_t codes_[5021];
+  // Decoded string length of each code in |codes_|, or 0 if the prefix chain
+  // could not be resolved when the code was added.
+  uint16_t code_lengths_[5021];
+  uint8_t code_first_chars_[5021];
 };
 
 CLZWDecoder::CLZWDecoder(pdfium::span<const uint8_t> src_span,
                          bool early_change)
     : src_span_(src_span), early_change_(early_change ? 1 : 0) {}
 
+uint32_t CLZWDecoder::ReadCode() {
+  // Refill a byte at a time until the buffer is nearly full, so several codes
+  // can be extracted before the source needs to be touched again.
+  if (bit_buf_size_ < code_len_) {
+    while (bit_buf_size_ <= 56 && src_byte_pos_ < src_span_.size()) {
+      bit_buf_ |= static_cast<uint64_t>(src_span_[src_byte_pos_++])
+                  << (56 - bit_buf_size_);
+      bit_buf_size_ += 8;
+    }
+  }
+  DCHECK_GE(bit_buf_size_, code_len_);
+  uint32_t code = static_cast<uint32_t>(bit_buf_ >> (64 - code_len_));
+  bit_buf_ <<= code_len_;
+  bit_buf_size_ -= code_len_;
+  src_bit_pos_ += code_len_;
+  return code;
+}
+
 void CLZWDecoder::AddCode(uint32_t prefix_code, uint8_t append_char) {
   if (current_code_ + early_change_ == 4094)
     return;
 
+  uint32_t prefix_length = GetStringLength(prefix_code);
+  code_lengths_[current_code_] =
+      prefix_length ? static_cast<uint16_t>(prefix_length + 1) : 0;
+  code_first_chars_[current_code_] = GetFirstChar(prefix_code);
   codes_[current_code_++] = (prefix_code << 16) | append_char;
   if (current_code_ + early_change_ == 512 - 258)
     code_len_ = 10;
@@ -157,6 +191,35 @@ void CLZWDecoder::AddCode(uint32_t prefix_code, uint8_t append_char) {
     code_len_ = 12;
 }
 
+uint32_t CLZWDecoder::GetStringLength(uint32_t code) const {
+  if (code < 258)
+    return 1;
+
+  uint32_t index = code - 258;
+  return index < current_code_ ? code_lengths_[index] : 0;
+}
+
+uint8_t CLZWDecoder::GetFirstChar(uint32_t code) const {
+  if (code < 258)
+    return static_cast<uint8_t>(code);
+
+  uint32_t index = code - 258;
+  return index < current_code_ ? code_first_chars_[index] : 0;
+}
+
+void CLZWDecoder::WriteString(uint32_t code,
+                              uint32_t length,
+                              uint8_t* dest) const {
+  // Walk the prefix chain once, filling |dest| from the back.
+  while (length > 1) {
+    uint32_t data = codes_[code - 258];
+    dest[--length] = static_cast<uint8_t>(data);
+    code = data >> 16;
+  }
+  DCHECK_LT(code, 258u);
+  dest[0] = static_cast<uint8_t>(code);
+}
+
 void CLZWDecoder::DecodeString(uint32_t code) {
   while (1) {
     int index = code - 258;
@@ -200,24 +263,7 @@ bool CLZWDecoder::Decode() {
     if (src_bit_pos_ + code_len_ > src_span_.size() * 8)
       break;
 
-    int byte_pos = src_bit_pos_ / 8;
-    int bit_pos = src_bit_pos_ % 8;
-    uint8_t bit_left = code_len_;
-    uint32_t code = 0;
-    if (bit_pos) {
-      bit_left -= 8 - bit_pos;
-      code = (src_span_[byte_pos++] & ((1 << (8 - bit_pos)) - 1)) << bit_left;
-    }
-    if (bit_left < 8) {
-      code |= src_span_[byte_pos] >> (8 - bit_left);
-    } else {
-      bit_left -= 8;
-      code |= src_span_[byte_pos++] << bit_left;
-      if (bit_left)
-        code |= src_span_[byte_pos] >> (8 - bit_left);
-    }
-    src_bit_pos_ += code_len_;
-
+    uint32_t code = ReadCode();
     if (code < 256) {
       if (dest_byte_pos_ >= dest_buf_size_) {
         ExpandDestBuf(dest_byte_pos_ - dest_buf_size_ + 1);
@@ -247,17 +293,29 @@ bool CLZWDecoder::Decode() {
       return false;
 
     DCHECK(old_code < 256 || old_code >= 258);
-    stack_len_ = 0;
-    if (code - 258 >= current_code_) {
-      if (stack_len_ < sizeof(decode_stack_))
-        decode_stack_[stack_len_++] = last_char;
-      DecodeString(old_code);
+    // When |code| is not in the table yet, the string is the one for
+    // |old_code| followed by its own first character.
+    const bool known_code = code - 258 < current_code_;
+    const uint32_t string_code = known_code ? code : old_code;
+    const uint32_t string_length = GetStringLength(string_code);
+    uint32_t output_length = string_length;
+    if (string_length) {
+      if (!known_code)
+        ++output_length;
     } else {
-      DecodeString(code);
+      // The prefix chain pointed past the end of the table when a code was
+      // added. Resolve it against the current table the slow way.
+      stack_len_ = 0;
+      if (!known_code) {
+        if (stack_len_ < sizeof(decode_stack_))
+          decode_stack_[stack_len_++] = last_char;
+      }
+      DecodeString(string_code);
+      output_length = stack_len_;
     }
 
     FX_SAFE_UINT32 safe_required_size = dest_byte_pos_;
-    safe_required_size += stack_len_;
+    safe_required_size += output_length;
     if (!safe_required_size.IsValid())
       return false;
 
@@ -268,10 +326,18 @@ bool CLZWDecoder::Decode() {
         return false;
     }
 
-    for (uint32_t i = 0; i < stack_len_; i++)
-      dest_buf_.get()[dest_byte_pos_ + i] = decode_stack_[stack_len_ - i - 1];
-    dest_byte_pos_ += stack_len_;
-    last_char = decode_stack_[stack_len_ - 1];
+    uint8_t* dest = dest_buf_.get() + dest_byte_pos_;
+    if (string_length) {
+      WriteString(string_code, string_length, dest);
+      if (!known_code)
+        dest[string_length] = last_char;
+      last_char = GetFirstChar(string_code);
+    } else {
+      for (uint32_t i = 0; i < stack_len_; i++)
+        dest[i] = decode_stack_[stack_len_ - i - 1];
+      last_char = decode_stack_[stack_len_ - 1];
+    }
+    dest_byte_pos_ += output_length;
     if (old_code >= 258 && old_code - 258 >= current_code_)
       break;
 
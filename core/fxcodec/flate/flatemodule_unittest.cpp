@@ -0,0 +1,48 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/flate/flatemodule.h"
+
+#include <stdint.h>
+
+#include <memory>
+
+#include "core/fxcrt/fx_memory_wrappers.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/base/cxx17_backports.h"
+#include "third_party/base/span.h"
+
+TEST(FlateModule, LZWDecodeSpecExample) {
+  // Example from the LZWDecode section of the PDF specification.
+  static constexpr uint8_t kSrc[] = {0x80, 0x0B, 0x60, 0x50, 0x22,
+                                     0x0C, 0x0C, 0x85, 0x01};
+  static constexpr uint8_t kExpected[] = {0x2D, 0x2D, 0x2D, 0x2D, 0x2D,
+                                          0x41, 0x2D, 0x2D, 0x2D, 0x42};
+  for (bool early_change : {true, false}) {
+    std::unique_ptr<uint8_t, FxFreeDeleter> dest_buf;
+    uint32_t dest_size = 0;
+    EXPECT_EQ(pdfium::size(kSrc),
+              FlateModule::FlateOrLZWDecode(true, kSrc, early_change, 0, 0, 0,
+                                            0, 0, &dest_buf, &dest_size));
+    ASSERT_EQ(pdfium::size(kExpected), dest_size);
+    auto dest_span = pdfium::make_span(dest_buf.get(), dest_size);
+    for (size_t i = 0; i < dest_size; ++i)
+      EXPECT_EQ(kExpected[i], dest_span[i]) << i;
+  }
+}
+
+TEST(FlateModule, LZWDecodeCodeNotYetInTable) {
+  // Codes 256 (clear), 65, 258, 259, 257 (EOD). 258 and 259 are each used
+  // before they are added to the table.
+  static constexpr uint8_t kSrc[] = {0x80, 0x10, 0x60, 0x50, 0x38, 0x08};
+  std::unique_ptr<uint8_t, FxFreeDeleter> dest_buf;
+  uint32_t dest_size = 0;
+  EXPECT_EQ(pdfium::size(kSrc),
+            FlateModule::FlateOrLZWDecode(true, kSrc, true, 0, 0, 0, 0, 0,
+                                          &dest_buf, &dest_size));
+  ASSERT_EQ(6u, dest_size);
+  auto dest_span = pdfium::make_span(dest_buf.get(), dest_size);
+  for (uint8_t byte : dest_span)
+    EXPECT_EQ('A', byte);
+}
@@ -8,11 +8,11 @@
 
 #include <string.h>
 
-#include <algorithm>
 #include <memory>
 #include <utility>
 
 #include "core/fxcrt/fx_safe_types.h"
+#include "third_party/base/check_op.h"
 #include "third_party/base/numerics/safe_math.h"
 #include "third_party/base/ptr_util.h"
 
@@ -107,8 +107,7 @@ LZWDecompressor::Status LZWDecompressor::Decode(const uint8_t* src_buf,
             if (!DecodeString(code))
               return Status::kError;
 
-            uint8_t append_char = decompressed_[decompressed_next_ - 1];
-            AddCode(code_old_, append_char);
+            AddCode(code_old_, decompressed_[0]);
           }
         }
       } else {
@@ -137,10 +136,19 @@ void LZWDecompressor::ClearTable() {
   code_size_cur_ = code_size_ + 1;
   code_next_ = code_end_ + 1;
   code_old_ = static_cast<uint16_t>(-1);
-  memset(code_table_, 0, sizeof(code_table_));
-  for (uint16_t i = 0; i < code_clear_; i++)
+  for (uint16_t i = 0; i < code_clear_; i++) {
+    code_table_[i].prefix = 0;
     code_table_[i].suffix = static_cast<uint8_t>(i);
-  decompressed_.resize(code_next_ - code_clear_ + 1);
+    code_table_[i].length = i < code_color_end_ ? 1 : 0;
+  }
+  // Codes that have not been added yet decode as the zeroed entry would, i.e.
+  // a 0 suffix on top of the 0 literal.
+  for (uint16_t i = code_clear_; i < GIF_MAX_LZW_CODE; i++) {
+    code_table_[i].prefix = 0;
+    code_table_[i].suffix = 0;
+    code_table_[i].length = 2;
+  }
+  decompressed_.clear();
   decompressed_next_ = 0;
 }
 
@@ -148,8 +156,12 @@ void LZWDecompressor::AddCode(uint16_t prefix_code, uint8_t append_char) {
   if (code_next_ == GIF_MAX_LZW_CODE)
     return;
 
-  code_table_[code_next_].prefix = prefix_code;
-  code_table_[code_next_].suffix = append_char;
+  CodeEntry& entry = code_table_[code_next_];
+  const uint16_t prefix_length =
+      prefix_code == code_next_ ? 0 : code_table_[prefix_code].length;
+  entry.prefix = prefix_code;
+  entry.suffix = append_char;
+  entry.length = prefix_length ? prefix_length + 1 : 0;
   if (++code_next_ < GIF_MAX_LZW_CODE) {
     if (code_next_ >> code_size_cur_)
       code_size_cur_++;
@@ -157,22 +169,20 @@ void LZWDecompressor::AddCode(uint16_t prefix_code, uint8_t append_char) {
 }
 
 bool LZWDecompressor::DecodeString(uint16_t code) {
-  decompressed_.resize(code_next_ - code_clear_ + 1);
-  decompressed_next_ = 0;
-
-  while (code >= code_clear_ && code <= code_next_) {
-    if (code == code_table_[code].prefix ||
-        decompressed_next_ >= decompressed_.size())
-      return false;
+  if (code > code_next_ || !code_table_[code].length)
+    return false;
 
-    decompressed_[decompressed_next_++] = code_table_[code].suffix;
+  // The string length is known up front, so write it out back to front
+  // straight into place instead of reversing it afterwards.
+  size_t pos = code_table_[code].length;
+  decompressed_.resize(pos);
+  while (pos > 1) {
+    decompressed_[--pos] = code_table_[code].suffix;
     code = code_table_[code].prefix;
   }
-
-  if (code >= code_color_end_)
-    return false;
-
-  decompressed_[decompressed_next_++] = static_cast<uint8_t>(code);
+  DCHECK_LT(code, code_clear_);
+  decompressed_[0] = static_cast<uint8_t>(code);
+  decompressed_next_ = decompressed_.size();
   code_first_ = static_cast<uint8_t>(code);
   return true;
 }
@@ -184,8 +194,9 @@ uint32_t LZWDecompressor::ExtractData(uint8_t* dest_buf, uint32_t dest_size) {
   uint32_t copy_size = dest_size <= decompressed_next_
                            ? dest_size
                            : static_cast<uint32_t>(decompressed_next_);
-  std::reverse_copy(decompressed_.data() + decompressed_next_ - copy_size,
-                    decompressed_.data() + decompressed_next_, dest_buf);
+  const uint8_t* pending =
+      decompressed_.data() + decompressed_.size() - decompressed_next_;
+  memcpy(dest_buf, pending, copy_size);
   decompressed_next_ -= copy_size;
   return copy_size;
 }
@@ -27,6 +27,8 @@ class LZWDecompressor {
   struct CodeEntry {
     uint16_t prefix;
     uint8_t suffix;
+    // Length of the string this code decodes to, or 0 if it fails to decode.
+    uint16_t length;
   };
 
   // Returns nullptr on error
@@ -49,7 +49,7 @@ TEST(LZWDecompressor, ExtractData) {
     EXPECT_EQ(5u, decompressor->ExtractDataForTest(dest_buf, 5));
     size_t i = 0;
     for (; i < 5; ++i)
-      EXPECT_EQ(9 - i, dest_buf[i]);
+      EXPECT_EQ(i, dest_buf[i]);
     for (; i < pdfium::size(dest_buf); ++i)
       EXPECT_EQ(static_cast<uint8_t>(-1), dest_buf[i]);
 
@@ -71,7 +71,7 @@ TEST(LZWDecompressor, ExtractData) {
                                                     pdfium::size(dest_buf)));
     size_t i = 0;
     for (; i < 10; ++i)
-      EXPECT_EQ(9 - i, dest_buf[i]);
+      EXPECT_EQ(i, dest_buf[i]);
     for (; i < pdfium::size(dest_buf); ++i)
       EXPECT_EQ(static_cast<uint8_t>(-1), dest_buf[i]);
 
@@ -217,3 +217,31 @@ TEST(LZWDecompressor, HandleColourCodeOutOfPalette) {
       LZWDecompressor::Status::kError,
       decompressor->Decode(kImageData, image_size, output_data, &output_size));
 }
+
+TEST(LZWDecompressor, DecodeStopsWithinString) {
+  uint8_t palette_exp = 0x1;
+  uint8_t code_exp = 0x2;
+  auto decompressor = LZWDecompressor::Create(palette_exp, code_exp);
+  ASSERT_NE(nullptr, decompressor);
+
+  static constexpr uint8_t kImageData[] = {
+      0x8C, 0x2D, 0x99, 0x87, 0x2A, 0x1C, 0xDC, 0x33, 0xA0, 0x02, 0x75,
+      0xEC, 0x95, 0xFA, 0xA8, 0xDE, 0x60, 0x8C, 0x04, 0x91, 0x4C, 0x01};
+  uint32_t image_size = pdfium::size(kImageData);
+
+  // The first 20 bytes of Decode10x10MultipleColour. They end within a
+  // string, whose last 4 bytes are left for the next call.
+  static constexpr uint8_t kExpectedData[] = {
+      0x01, 0x01, 0x01, 0x01, 0x01, 0x02, 0x02, 0x02, 0x02, 0x02,
+      0x01, 0x01, 0x01, 0x01, 0x01, 0x02, 0x02, 0x02, 0x02, 0x02};
+
+  uint8_t output_data[pdfium::size(kExpectedData)];
+  memset(output_data, 0, sizeof(output_data));
+  uint32_t output_size = pdfium::size(output_data);
+
+  EXPECT_EQ(
+      LZWDecompressor::Status::kInsufficientDestSize,
+      decompressor->Decode(kImageData, image_size, output_data, &output_size));
+  EXPECT_TRUE(0 == memcmp(kExpectedData, output_data, sizeof(kExpectedData)));
+  EXPECT_EQ(4u, *(decompressor->DecompressedNextForTest()));
+}
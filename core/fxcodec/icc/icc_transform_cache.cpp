@@ -0,0 +1,82 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/icc/icc_transform_cache.h"
+
+#include <utility>
+
+#include "core/fdrm/fx_crypt.h"
+#include "core/fxcodec/icc/iccmodule.h"
+
+namespace fxcodec {
+
+// static
+IccTransformCache* IccTransformCache::GetInstance() {
+  static pdfium::base::NoDestructor<IccTransformCache> s;
+  return s.get();
+}
+
+IccTransformCache::IccTransformCache() = default;
+
+IccTransformCache::~IccTransformCache() = default;
+
+std::shared_ptr<CLcmsCmm> IccTransformCache::GetTransformSRGB(
+    pdfium::span<const uint8_t> span) {
+  Digest digest;
+  CRYPT_SHA256Generate(span.data(), span.size(), digest.data());
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    auto it = index_.find(digest);
+    if (it != index_.end()) {
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return it->second->transform;
+    }
+  }
+
+  // Creating the transform is the expensive part, so do not block other
+  // threads while doing it. If another thread wins the race, use its result.
+  std::shared_ptr<CLcmsCmm> transform = IccModule::CreateTransformSRGB(span);
+
+  std::lock_guard<std::mutex> lock(lock_);
+  auto it = index_.find(digest);
+  if (it != index_.end()) {
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->transform;
+  }
+  entries_.push_front({digest, transform});
+  index_[digest] = entries_.begin();
+  TrimToMaxEntries();
+  return transform;
+}
+
+size_t IccTransformCache::GetMaxEntries() const {
+  std::lock_guard<std::mutex> lock(lock_);
+  return max_entries_;
+}
+
+void IccTransformCache::SetMaxEntries(size_t max_entries) {
+  std::lock_guard<std::mutex> lock(lock_);
+  max_entries_ = max_entries;
+  TrimToMaxEntries();
+}
+
+size_t IccTransformCache::GetEntryCount() const {
+  std::lock_guard<std::mutex> lock(lock_);
+  return entries_.size();
+}
+
+void IccTransformCache::Clear() {
+  std::lock_guard<std::mutex> lock(lock_);
+  index_.clear();
+  entries_.clear();
+}
+
+void IccTransformCache::TrimToMaxEntries() {
+  while (entries_.size() > max_entries_) {
+    index_.erase(entries_.back().digest);
+    entries_.pop_back();
+  }
+}
+
+}  // namespace fxcodec
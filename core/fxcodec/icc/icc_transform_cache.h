@@ -0,0 +1,74 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCODEC_ICC_ICC_TRANSFORM_CACHE_H_
+#define CORE_FXCODEC_ICC_ICC_TRANSFORM_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "third_party/base/no_destructor.h"
+#include "third_party/base/span.h"
+
+namespace fxcodec {
+
+class CLcmsCmm;
+
+// Process-wide cache of ICC profile to sRGB transforms, so documents that
+// embed the same profile share one transform instead of each building its
+// own. Entries are keyed by the SHA-256 digest of the profile data and
+// evicted least recently used first once there are more than
+// GetMaxEntries() of them. All methods may be called from any thread.
+class IccTransformCache {
+ public:
+  static constexpr size_t kDefaultMaxEntries = 32;
+
+  static IccTransformCache* GetInstance();
+
+  // Returns the transform for the profile in |span|, creating it if needed.
+  // Returns nullptr if the profile cannot be used. Evicting an entry only
+  // drops the cache's reference, so returned transforms stay valid for as
+  // long as the caller holds on to them.
+  std::shared_ptr<CLcmsCmm> GetTransformSRGB(pdfium::span<const uint8_t> span);
+
+  size_t GetMaxEntries() const;
+  void SetMaxEntries(size_t max_entries);
+  size_t GetEntryCount() const;
+  void Clear();
+
+ private:
+  friend pdfium::base::NoDestructor<IccTransformCache>;
+
+  using Digest = std::array<uint8_t, 32>;
+
+  struct Entry {
+    Digest digest;
+    // Null when the profile is not supported, so it is not parsed again.
+    std::shared_ptr<CLcmsCmm> transform;
+  };
+
+  IccTransformCache();
+  ~IccTransformCache();
+
+  // Caller must hold |lock_|.
+  void TrimToMaxEntries();
+
+  mutable std::mutex lock_;
+  size_t max_entries_ = kDefaultMaxEntries;
+  // Most recently used first.
+  std::list<Entry> entries_;
+  std::map<Digest, std::list<Entry>::iterator> index_;
+};
+
+}  // namespace fxcodec
+
+using IccTransformCache = fxcodec::IccTransformCache;
+
+#endif  // CORE_FXCODEC_ICC_ICC_TRANSFORM_CACHE_H_
@@ -0,0 +1,121 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/icc/icc_transform_cache.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "core/fxcodec/icc/iccmodule.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+std::vector<uint8_t> SaveProfile(cmsHPROFILE profile) {
+  std::vector<uint8_t> data;
+  cmsUInt32Number size = 0;
+  if (cmsSaveProfileToMem(profile, nullptr, &size)) {
+    data.resize(size);
+    if (!cmsSaveProfileToMem(profile, data.data(), &size))
+      data.clear();
+  }
+  cmsCloseProfile(profile);
+  return data;
+}
+
+std::vector<uint8_t> CreateSRGBProfileData() {
+  return SaveProfile(cmsCreate_sRGBProfile());
+}
+
+std::vector<uint8_t> CreateGrayProfileData() {
+  cmsToneCurve* curve = cmsBuildGamma(nullptr, 2.2);
+  std::vector<uint8_t> data =
+      SaveProfile(cmsCreateGrayProfile(cmsD50_xyY(), curve));
+  cmsFreeToneCurve(curve);
+  return data;
+}
+
+class IccTransformCacheTest : public testing::Test {
+ public:
+  void SetUp() override {
+    cache_ = IccTransformCache::GetInstance();
+    cache_->Clear();
+    cache_->SetMaxEntries(IccTransformCache::kDefaultMaxEntries);
+  }
+
+  void TearDown() override {
+    cache_->Clear();
+    cache_->SetMaxEntries(IccTransformCache::kDefaultMaxEntries);
+  }
+
+ protected:
+  IccTransformCache* cache_ = nullptr;
+};
+
+}  // namespace
+
+TEST_F(IccTransformCacheTest, SameProfileSharesTransform) {
+  std::vector<uint8_t> srgb1 = CreateSRGBProfileData();
+  std::vector<uint8_t> srgb2 = srgb1;
+  ASSERT_FALSE(srgb1.empty());
+
+  std::shared_ptr<CLcmsCmm> transform1 = cache_->GetTransformSRGB(srgb1);
+  ASSERT_TRUE(transform1);
+  EXPECT_EQ(3, transform1->components());
+
+  // A copy of the same data at a different address hits the cache.
+  std::shared_ptr<CLcmsCmm> transform2 = cache_->GetTransformSRGB(srgb2);
+  EXPECT_EQ(transform1, transform2);
+  EXPECT_EQ(1u, cache_->GetEntryCount());
+}
+
+TEST_F(IccTransformCacheTest, DifferentProfiles) {
+  std::vector<uint8_t> srgb = CreateSRGBProfileData();
+  std::vector<uint8_t> gray = CreateGrayProfileData();
+  ASSERT_FALSE(srgb.empty());
+  ASSERT_FALSE(gray.empty());
+
+  std::shared_ptr<CLcmsCmm> srgb_transform = cache_->GetTransformSRGB(srgb);
+  std::shared_ptr<CLcmsCmm> gray_transform = cache_->GetTransformSRGB(gray);
+  ASSERT_TRUE(srgb_transform);
+  ASSERT_TRUE(gray_transform);
+  EXPECT_NE(srgb_transform, gray_transform);
+  EXPECT_EQ(1, gray_transform->components());
+  EXPECT_EQ(2u, cache_->GetEntryCount());
+}
+
+TEST_F(IccTransformCacheTest, UnsupportedProfile) {
+  const uint8_t kBadData[] = {0, 1, 2, 3, 4, 5, 6, 7};
+  EXPECT_FALSE(cache_->GetTransformSRGB(kBadData));
+  EXPECT_EQ(1u, cache_->GetEntryCount());
+  EXPECT_FALSE(cache_->GetTransformSRGB(kBadData));
+  EXPECT_EQ(1u, cache_->GetEntryCount());
+}
+
+TEST_F(IccTransformCacheTest, EvictLeastRecentlyUsed) {
+  std::vector<uint8_t> srgb = CreateSRGBProfileData();
+  std::vector<uint8_t> gray = CreateGrayProfileData();
+  const uint8_t kBadData[] = {0, 1, 2, 3, 4, 5, 6, 7};
+
+  cache_->SetMaxEntries(2);
+  std::shared_ptr<CLcmsCmm> srgb_transform = cache_->GetTransformSRGB(srgb);
+  std::shared_ptr<CLcmsCmm> gray_transform = cache_->GetTransformSRGB(gray);
+  ASSERT_TRUE(srgb_transform);
+
+  // Touch sRGB so the gray profile becomes the least recently used one.
+  EXPECT_EQ(srgb_transform, cache_->GetTransformSRGB(srgb));
+  cache_->GetTransformSRGB(kBadData);
+  EXPECT_EQ(2u, cache_->GetEntryCount());
+  EXPECT_EQ(srgb_transform, cache_->GetTransformSRGB(srgb));
+
+  // The evicted transform stays usable by its holder, but the next lookup
+  // builds a new one.
+  EXPECT_EQ(1, gray_transform->components());
+  EXPECT_NE(gray_transform, cache_->GetTransformSRGB(gray));
+
+  cache_->SetMaxEntries(0);
+  EXPECT_EQ(0u, cache_->GetEntryCount());
+}
@@ -148,4 +148,19 @@ void IccModule::TranslateScanline(CLcmsCmm* pTransform,
     cmsDoTransform(pTransform->transform(), pSrc, pDest, pixels);
 }
 
+// static
+void IccModule::TranslateImage(CLcmsCmm* pTransform,
+                               uint8_t* pDest,
+                               uint32_t dest_pitch,
+                               const uint8_t* pSrc,
+                               uint32_t src_pitch,
+                               int width,
+                               int height) {
+  if (!pTransform || width <= 0 || height <= 0)
+    return;
+
+  cmsDoTransformLineStride(pTransform->transform(), pSrc, pDest, width, height,
+                           src_pitch, dest_pitch, 0, 0);
+}
+
 }  // namespace fxcodec
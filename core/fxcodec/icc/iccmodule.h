@@ -55,6 +55,16 @@ class IccModule {
                                 const uint8_t* pSrc,
                                 int pixels);
 
+  // Translates |height| rows of |width| pixels. Rows start every |src_pitch|
+  // bytes in |pSrc| and every |dest_pitch| bytes in |pDest|.
+  static void TranslateImage(CLcmsCmm* pTransform,
+                             uint8_t* pDest,
+                             uint32_t dest_pitch,
+                             const uint8_t* pSrc,
+                             uint32_t src_pitch,
+                             int width,
+                             int height);
+
   IccModule() = delete;
   IccModule(const IccModule&) = delete;
   IccModule& operator=(const IccModule&) = delete;
@@ -0,0 +1,58 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/icc/iccmodule.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+std::unique_ptr<CLcmsCmm> CreateSRGBTransform() {
+  cmsHPROFILE profile = cmsCreate_sRGBProfile();
+  cmsUInt32Number size = 0;
+  std::vector<uint8_t> data;
+  if (cmsSaveProfileToMem(profile, nullptr, &size)) {
+    data.resize(size);
+    if (!cmsSaveProfileToMem(profile, data.data(), &size))
+      data.clear();
+  }
+  cmsCloseProfile(profile);
+  return IccModule::CreateTransformSRGB(data);
+}
+
+}  // namespace
+
+TEST(IccModule, TranslateImageMatchesTranslateScanline) {
+  std::unique_ptr<CLcmsCmm> transform = CreateSRGBTransform();
+  ASSERT_TRUE(transform);
+
+  // Each row has padding at the end that must be left alone.
+  constexpr int kWidth = 100;
+  constexpr int kHeight = 61;
+  constexpr uint32_t kSrcPitch = kWidth * 3 + 5;
+  constexpr uint32_t kDestPitch = kWidth * 3 + 7;
+  std::vector<uint8_t> src(kSrcPitch * kHeight);
+  for (size_t i = 0; i < src.size(); ++i)
+    src[i] = static_cast<uint8_t>(i * 7 + i / 3);
+
+  std::vector<uint8_t> dest(kDestPitch * kHeight, 0xcd);
+  IccModule::TranslateImage(transform.get(), dest.data(), kDestPitch,
+                            src.data(), kSrcPitch, kWidth, kHeight);
+
+  std::vector<uint8_t> expected(kWidth * 3);
+  for (int row = 0; row < kHeight; ++row) {
+    IccModule::TranslateScanline(transform.get(), expected.data(),
+                                 &src[row * kSrcPitch], kWidth);
+    const uint8_t* dest_row = &dest[row * kDestPitch];
+    for (int i = 0; i < kWidth * 3; ++i)
+      ASSERT_EQ(expected[i], dest_row[i]) << row << " " << i;
+    for (uint32_t i = kWidth * 3; i < kDestPitch; ++i)
+      ASSERT_EQ(0xcd, dest_row[i]) << row << " " << i;
+  }
+}
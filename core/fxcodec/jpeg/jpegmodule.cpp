@@ -121,7 +121,8 @@ class JpegDecoder final : public ScanlineDecoder {
               uint32_t width,
               uint32_t height,
               int nComps,
-              bool ColorTransform);
+              bool ColorTransform,
+              uint32_t scale_denom);
 
   // ScanlineDecoder:
   bool v_Rewind() override;
@@ -142,6 +143,7 @@ class JpegDecoder final : public ScanlineDecoder {
 
  private:
   void CalcPitch();
+  bool CalcOutputSize();
   void InitDecompressSrc();
 
   // Can only be called inside a jpeg_read_header() setjmp handler.
@@ -164,6 +166,7 @@ class JpegDecoder final : public ScanlineDecoder {
   static constexpr size_t kSofMarkerByteOffset = 5;
 
   uint32_t m_nDefaultScaleDenom = 1;
+  uint32_t m_nScaleDenom = 1;
 };
 
 JpegDecoder::JpegDecoder() {
@@ -232,7 +235,8 @@ bool JpegDecoder::Create(pdfium::span<const uint8_t> src_span,
                          uint32_t width,
                          uint32_t height,
                          int nComps,
-                         bool ColorTransform) {
+                         bool ColorTransform,
+                         uint32_t scale_denom) {
   m_SrcSpan = JpegScanSOI(src_span);
   if (m_SrcSpan.size() < 2)
     return false;
@@ -261,6 +265,10 @@ bool JpegDecoder::Create(pdfium::span<const uint8_t> src_span,
   if (m_Cinfo.image_width < width)
     return false;
 
+  m_nScaleDenom = scale_denom;
+  if (m_nScaleDenom != 1 && !CalcOutputSize())
+    return false;
+
   CalcPitch();
   m_pScanlineBuf.reset(FX_Alloc(uint8_t, m_Pitch));
   m_nComps = m_Cinfo.num_components;
@@ -279,7 +287,7 @@ bool JpegDecoder::v_Rewind() {
   if (setjmp(m_JmpBuf) == -1) {
     return false;
   }
-  m_Cinfo.scale_denom = m_nDefaultScaleDenom;
+  m_Cinfo.scale_denom = m_nDefaultScaleDenom * m_nScaleDenom;
   m_OutputWidth = m_OrigWidth;
   m_OutputHeight = m_OrigHeight;
   if (!jpeg_start_decompress(&m_Cinfo)) {
@@ -290,6 +298,10 @@ bool JpegDecoder::v_Rewind() {
     NOTREACHED();
     return false;
   }
+  if (m_nScaleDenom != 1) {
+    m_OutputWidth = m_Cinfo.output_width;
+    m_OutputHeight = m_Cinfo.output_height;
+  }
   m_bStarted = true;
   return true;
 }
@@ -314,6 +326,17 @@ void JpegDecoder::CalcPitch() {
   m_Pitch *= 4;
 }
 
+bool JpegDecoder::CalcOutputSize() {
+  if (setjmp(m_JmpBuf) == -1)
+    return false;
+
+  m_Cinfo.scale_denom = m_nDefaultScaleDenom * m_nScaleDenom;
+  jpeg_calc_output_dimensions(&m_Cinfo);
+  m_OutputWidth = m_Cinfo.output_width;
+  m_OutputHeight = m_Cinfo.output_height;
+  return true;
+}
+
 void JpegDecoder::InitDecompressSrc() {
   m_Cinfo.src = &m_Src;
   m_Src.bytes_in_buffer = m_SrcSpan.size();
@@ -381,11 +404,27 @@ std::unique_ptr<ScanlineDecoder> JpegModule::CreateDecoder(
     uint32_t height,
     int nComps,
     bool ColorTransform) {
+  return CreateScaledDecoder(src_span, width, height, nComps, ColorTransform,
+                             /*scale_denom=*/1);
+}
+
+// static
+std::unique_ptr<ScanlineDecoder> JpegModule::CreateScaledDecoder(
+    pdfium::span<const uint8_t> src_span,
+    uint32_t width,
+    uint32_t height,
+    int nComps,
+    bool ColorTransform,
+    uint32_t scale_denom) {
   DCHECK(!src_span.empty());
+  DCHECK(scale_denom == 1 || scale_denom == 2 || scale_denom == 4 ||
+         scale_denom == 8);
 
   auto pDecoder = std::make_unique<JpegDecoder>();
-  if (!pDecoder->Create(src_span, width, height, nComps, ColorTransform))
+  if (!pDecoder->Create(src_span, width, height, nComps, ColorTransform,
+                        scale_denom)) {
     return nullptr;
+  }
 
   return std::move(pDecoder);
 }
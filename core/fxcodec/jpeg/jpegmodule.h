@@ -42,6 +42,17 @@ class JpegModule {
       int nComps,
       bool ColorTransform);
 
+  // Like CreateDecoder(), but decodes at 1 / |scale_denom| of the size, which
+  // libjpeg does much faster than a full decode. |scale_denom| is 1, 2, 4 or
+  // 8. The decoder's GetWidth() and GetHeight() give the reduced size.
+  static std::unique_ptr<ScanlineDecoder> CreateScaledDecoder(
+      pdfium::span<const uint8_t> src_span,
+      uint32_t width,
+      uint32_t height,
+      int nComps,
+      bool ColorTransform,
+      uint32_t scale_denom);
+
   static Optional<ImageInfo> LoadInfo(pdfium::span<const uint8_t> src_span);
 
 #if defined(OS_WIN)
@@ -0,0 +1,80 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/jpeg/jpegmodule.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/fxcodec/scanlinedecoder.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/utils/file_util.h"
+#include "testing/utils/path_service.h"
+#include "third_party/base/span.h"
+
+namespace fxcodec {
+
+namespace {
+
+std::vector<uint8_t> ReadTestJpeg() {
+  std::string file_name;
+  if (!PathService::GetTestFilePath("mona_lisa.jpg", &file_name))
+    return {};
+
+  size_t file_length = 0;
+  std::unique_ptr<char, pdfium::FreeDeleter> file_contents =
+      GetFileContents(file_name.c_str(), &file_length);
+  if (!file_contents)
+    return {};
+
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(file_contents.get());
+  return std::vector<uint8_t>(data, data + file_length);
+}
+
+}  // namespace
+
+TEST(JpegModule, CreateScaledDecoder) {
+  const std::vector<uint8_t> jpeg = ReadTestJpeg();
+  ASSERT_FALSE(jpeg.empty());
+
+  Optional<JpegModule::ImageInfo> info = JpegModule::LoadInfo(jpeg);
+  ASSERT_TRUE(info.has_value());
+  ASSERT_EQ(120u, info->width);
+  ASSERT_EQ(120u, info->height);
+  ASSERT_EQ(3, info->num_components);
+
+  for (uint32_t scale_denom : {1, 2, 4, 8}) {
+    SCOPED_TRACE(scale_denom);
+    std::unique_ptr<ScanlineDecoder> decoder = JpegModule::CreateScaledDecoder(
+        jpeg, info->width, info->height, info->num_components,
+        info->color_transform, scale_denom);
+    ASSERT_TRUE(decoder);
+    const int width = static_cast<int>(info->width / scale_denom);
+    const int height = static_cast<int>(info->height / scale_denom);
+    EXPECT_EQ(width, decoder->GetWidth());
+    EXPECT_EQ(height, decoder->GetHeight());
+    EXPECT_EQ(3, decoder->CountComps());
+
+    const size_t row_size = width * 3;
+    const uint8_t* scan = decoder->GetScanline(0);
+    ASSERT_TRUE(scan);
+    const std::vector<uint8_t> first_row(scan, scan + row_size);
+    for (int row = 1; row < height; ++row)
+      ASSERT_TRUE(decoder->GetScanline(row));
+    EXPECT_FALSE(decoder->GetScanline(height));
+
+    // Going back to the first row rewinds the decoder, which has to keep
+    // decoding at the reduced size.
+    scan = decoder->GetScanline(0);
+    ASSERT_TRUE(scan);
+    EXPECT_EQ(width, decoder->GetWidth());
+    EXPECT_EQ(height, decoder->GetHeight());
+    EXPECT_EQ(first_row, std::vector<uint8_t>(scan, scan + row_size));
+  }
+}
+
+}  // namespace fxcodec
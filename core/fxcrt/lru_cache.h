@@ -0,0 +1,152 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCRT_LRU_CACHE_H_
+#define CORE_FXCRT_LRU_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <iterator>
+#include <list>
+#include <map>
+#include <utility>
+
+#include "third_party/base/check.h"
+
+namespace fxcrt {
+
+// Least recently used cache of values that take up a given number of bytes
+// each, holding at most GetMaxBytes() of them in total. Keys are ordered by
+// operator<. Values larger than 1 / |max_value_share| of the budget are not
+// cached, so one of them cannot flush the rest.
+template <typename KeyT, typename ValueT>
+class LruCache {
+ public:
+  using Key = KeyT;
+  using Value = ValueT;
+
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t bytes = 0;
+    size_t entries = 0;
+  };
+
+  LruCache(size_t max_bytes, size_t max_value_share)
+      : m_MaxBytes(max_bytes), m_MaxValueShare(max_value_share) {
+    DCHECK(m_MaxValueShare > 0);
+  }
+  LruCache(const LruCache&) = delete;
+  LruCache& operator=(const LruCache&) = delete;
+  ~LruCache() = default;
+
+  // Copies the value cached for |key| into |value|. Returns false and counts
+  // a miss if |key| is not cached.
+  bool Lookup(const Key& key, Value* value) {
+    auto it = m_Index.find(key);
+    if (it == m_Index.end()) {
+      ++m_Misses;
+      return false;
+    }
+    ++m_Hits;
+    m_Entries.splice(m_Entries.begin(), m_Entries, it->second);
+    *value = it->second->value;
+    return true;
+  }
+
+  // Whether a value of |bytes| is cached by Add().
+  bool CanCache(size_t bytes) const {
+    return bytes > 0 && bytes <= m_MaxBytes / m_MaxValueShare;
+  }
+
+  // Caches |value|, which takes up |bytes|, for |key| if CanCache() allows
+  // it. Evicts the least recently used values to stay within GetMaxBytes().
+  void Add(const Key& key, Value value, size_t bytes) {
+    auto it = m_Index.find(key);
+    if (it != m_Index.end())
+      RemoveEntry(it->second);
+
+    if (!CanCache(bytes))
+      return;
+
+    m_Bytes += bytes;
+    m_Entries.push_front({key, std::move(value), bytes});
+    m_Index[key] = m_Entries.begin();
+    Trim();
+  }
+
+  // Removes the values of all keys that |pred| returns true for.
+  template <typename Pred>
+  void RemoveIf(Pred pred) {
+    for (auto it = m_Entries.begin(); it != m_Entries.end();) {
+      auto next = std::next(it);
+      if (pred(it->key))
+        RemoveEntry(it);
+      it = next;
+    }
+  }
+
+  size_t GetMaxBytes() const { return m_MaxBytes; }
+  void SetMaxBytes(size_t max_bytes) {
+    m_MaxBytes = max_bytes;
+    Trim();
+  }
+
+  Stats GetStats() const {
+    Stats stats;
+    stats.hits = m_Hits;
+    stats.misses = m_Misses;
+    stats.evictions = m_Evictions;
+    stats.bytes = m_Bytes;
+    stats.entries = m_Entries.size();
+    return stats;
+  }
+
+  // Resets the hit, miss and eviction counters.
+  void ResetCounters() {
+    m_Hits = 0;
+    m_Misses = 0;
+    m_Evictions = 0;
+  }
+
+ private:
+  struct Entry {
+    Key key;
+    Value value;
+    size_t bytes;
+  };
+  using EntryList = std::list<Entry>;
+
+  void RemoveEntry(typename EntryList::iterator it) {
+    DCHECK(m_Bytes >= it->bytes);
+    m_Bytes -= it->bytes;
+    m_Index.erase(it->key);
+    m_Entries.erase(it);
+  }
+
+  void Trim() {
+    while (m_Bytes > m_MaxBytes) {
+      RemoveEntry(std::prev(m_Entries.end()));
+      ++m_Evictions;
+    }
+  }
+
+  size_t m_MaxBytes;
+  const size_t m_MaxValueShare;
+  size_t m_Bytes = 0;
+  uint64_t m_Hits = 0;
+  uint64_t m_Misses = 0;
+  uint64_t m_Evictions = 0;
+  // Most recently used first.
+  EntryList m_Entries;
+  std::map<Key, typename EntryList::iterator> m_Index;
+};
+
+}  // namespace fxcrt
+
+using fxcrt::LruCache;
+
+#endif  // CORE_FXCRT_LRU_CACHE_H_
@@ -0,0 +1,94 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/lru_cache.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+TEST(LruCache, LookupAndAdd) {
+  LruCache<int, int> cache(4000, 4);
+  int value = 0;
+  EXPECT_FALSE(cache.Lookup(1, &value));
+
+  cache.Add(1, 10, 400);
+  EXPECT_TRUE(cache.Lookup(1, &value));
+  EXPECT_EQ(10, value);
+  EXPECT_FALSE(cache.Lookup(2, &value));
+
+  // Adding a key again replaces its value.
+  cache.Add(1, 11, 500);
+  EXPECT_TRUE(cache.Lookup(1, &value));
+  EXPECT_EQ(11, value);
+
+  LruCache<int, int>::Stats stats = cache.GetStats();
+  EXPECT_EQ(2u, stats.hits);
+  EXPECT_EQ(2u, stats.misses);
+  EXPECT_EQ(0u, stats.evictions);
+  EXPECT_EQ(500u, stats.bytes);
+  EXPECT_EQ(1u, stats.entries);
+
+  cache.ResetCounters();
+  stats = cache.GetStats();
+  EXPECT_EQ(0u, stats.hits);
+  EXPECT_EQ(0u, stats.misses);
+  EXPECT_EQ(500u, stats.bytes);
+  EXPECT_EQ(1u, stats.entries);
+}
+
+TEST(LruCache, EvictLeastRecentlyUsed) {
+  LruCache<int, int> cache(1200, 4);
+  int value = 0;
+  for (int i = 0; i < 4; ++i)
+    cache.Add(i, i, 300);
+
+  // Touch the first value, so the second one is evicted next.
+  EXPECT_TRUE(cache.Lookup(0, &value));
+  cache.Add(4, 4, 300);
+  LruCache<int, int>::Stats stats = cache.GetStats();
+  EXPECT_EQ(1u, stats.evictions);
+  EXPECT_EQ(1200u, stats.bytes);
+  EXPECT_EQ(4u, stats.entries);
+  EXPECT_TRUE(cache.Lookup(0, &value));
+  EXPECT_FALSE(cache.Lookup(1, &value));
+
+  // Empty values and values over a quarter of the budget are not cached.
+  EXPECT_TRUE(cache.CanCache(300));
+  EXPECT_FALSE(cache.CanCache(301));
+  EXPECT_FALSE(cache.CanCache(0));
+  cache.Add(1, 1, 301);
+  EXPECT_FALSE(cache.Lookup(1, &value));
+
+  cache.SetMaxBytes(0);
+  stats = cache.GetStats();
+  EXPECT_EQ(5u, stats.evictions);
+  EXPECT_EQ(0u, stats.bytes);
+  EXPECT_EQ(0u, stats.entries);
+}
+
+TEST(LruCache, RemoveIf) {
+  LruCache<int, int> cache(4000, 4);
+  for (int i = 0; i < 6; ++i)
+    cache.Add(i, i, 100);
+
+  cache.RemoveIf([](int key) { return key % 2 == 0; });
+  LruCache<int, int>::Stats stats = cache.GetStats();
+  EXPECT_EQ(0u, stats.evictions);
+  EXPECT_EQ(300u, stats.bytes);
+  EXPECT_EQ(3u, stats.entries);
+  int value = 0;
+  EXPECT_FALSE(cache.Lookup(0, &value));
+  EXPECT_TRUE(cache.Lookup(1, &value));
+  EXPECT_FALSE(cache.Lookup(4, &value));
+  EXPECT_TRUE(cache.Lookup(5, &value));
+}
+
+TEST(LruCache, MaxValueShare) {
+  LruCache<int, int> whole_budget(1000, 1);
+  EXPECT_TRUE(whole_budget.CanCache(1000));
+  EXPECT_FALSE(whole_budget.CanCache(1001));
+
+  LruCache<int, int> half_budget(1000, 2);
+  EXPECT_TRUE(half_budget.CanCache(500));
+  EXPECT_FALSE(half_budget.CanCache(501));
+}
@@ -10,15 +10,21 @@
 
 #include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "build/build_config.h"
+#include "core/fxcrt/fx_safe_types.h"
 #include "core/fxge/cfx_cliprgn.h"
+#include "core/fxge/cfx_clipruns.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
+#include "core/fxge/cfx_glyphbitmap.h"
 #include "core/fxge/cfx_graphstatedata.h"
 #include "core/fxge/cfx_path.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
 #include "core/fxge/dib/cfx_imagerenderer.h"
 #include "core/fxge/dib/cfx_imagestretcher.h"
+#include "core/fxge/dib/cfx_scanlinecompositor.h"
+#include "core/fxge/text_glyph_pos.h"
 #include "third_party/base/check.h"
 #include "third_party/base/check_op.h"
 #include "third_party/base/cxx17_backports.h"
@@ -35,7 +41,6 @@
 #include "third_party/agg23/agg_conv_stroke.h"
 #include "third_party/agg23/agg_curves.h"
 #include "third_party/agg23/agg_path_storage.h"
-#include "third_party/agg23/agg_pixfmt_gray.h"
 #include "third_party/agg23/agg_rasterizer_scanline_aa.h"
 #include "third_party/agg23/agg_renderer_scanline.h"
 #include "third_party/agg23/agg_scanline_u.h"
@@ -295,8 +300,14 @@ agg::filling_rule_e GetAlternateOrWindingFillType(
              : agg::fill_even_odd;
 }
 
+RetainPtr<const CFX_ClipRuns> GetClipRunsFromRegion(const CFX_ClipRgn* r) {
+  return (r && r->GetType() == CFX_ClipRgn::kMaskF) ? r->GetRuns() : nullptr;
+}
+
 RetainPtr<CFX_DIBitmap> GetClipMaskFromRegion(const CFX_ClipRgn* r) {
-  return (r && r->GetType() == CFX_ClipRgn::kMaskF) ? r->GetMask() : nullptr;
+  if (!r || r->GetType() != CFX_ClipRgn::kMaskF || r->GetRuns())
+    return nullptr;
+  return r->GetMask();
 }
 
 FX_RECT GetClipBoxFromRegion(const RetainPtr<CFX_DIBitmap>& device,
@@ -383,6 +394,15 @@ class CFX_Renderer {
                         uint8_t* clip_scan,
                         uint8_t* dest_extra_alpha_scan);
 
+  // Points |*clip_pos| at the clip coverage of the span of |len| pixels at
+  // |x| on row |y|, or at nullptr if it is fully covered. Returns false if
+  // the span can be skipped.
+  bool GetClipScanFromRuns(int y,
+                           int x,
+                           int len,
+                           bool bBackdrop,
+                           uint8_t** clip_pos);
+
   void CompositeSpan1bppHelper(uint8_t* dest_scan,
                                int col_start,
                                int col_end,
@@ -432,9 +452,12 @@ class CFX_Renderer {
   const FX_RECT m_ClipBox;
   RetainPtr<CFX_DIBitmap> const m_pBackdropDevice;
   RetainPtr<CFX_DIBitmap> const m_pClipMask;
+  RetainPtr<const CFX_ClipRuns> const m_pClipRuns;
   RetainPtr<CFX_DIBitmap> const m_pDevice;
   UnownedPtr<const CFX_ClipRgn> m_pClipRgn;
   const CompositeSpanFunc m_CompositeSpanFunc;
+  // Coverage of the current span, decoded from |m_pClipRuns|.
+  std::vector<uint8_t> m_ClipScan;
 };
 
 void CFX_Renderer::CompositeSpan(uint8_t* dest_scan,
@@ -823,6 +846,7 @@ CFX_Renderer::CFX_Renderer(const RetainPtr<CFX_DIBitmap>& pDevice,
       m_ClipBox(GetClipBoxFromRegion(pDevice, pClipRgn)),
       m_pBackdropDevice(pBackdropDevice),
       m_pClipMask(GetClipMaskFromRegion(pClipRgn)),
+      m_pClipRuns(GetClipRunsFromRegion(pClipRgn)),
       m_pDevice(pDevice),
       m_pClipRgn(pClipRgn),
       m_CompositeSpanFunc(GetCompositeSpanFunc(m_pDevice)) {
@@ -882,6 +906,14 @@ void CFX_Renderer::render(const Scanline& sl) {
       clip_pos = m_pClipMask->GetBuffer() +
                  (y - m_ClipBox.top) * m_pClipMask->GetPitch() + x -
                  m_ClipBox.left;
+    } else if (m_pClipRuns &&
+               !GetClipScanFromRuns(y, x, span->len, !!backdrop_pos,
+                                    &clip_pos)) {
+      if (--num_spans == 0)
+        break;
+
+      ++span;
+      continue;
     }
     if (backdrop_pos) {
       CompositeSpan(dest_pos, backdrop_pos, Bpp, bDestAlpha, x, span->len,
@@ -898,6 +930,32 @@ void CFX_Renderer::render(const Scanline& sl) {
   }
 }
 
+bool CFX_Renderer::GetClipScanFromRuns(int y,
+                                       int x,
+                                       int len,
+                                       bool bBackdrop,
+                                       uint8_t** clip_pos) {
+  int left = std::max(x, m_ClipBox.left);
+  int right = std::min(x + len, m_ClipBox.right);
+  if (left >= right)
+    return false;
+
+  Optional<uint8_t> coverage = m_pClipRuns->GetSolidCoverage(y, left, right);
+  if (coverage == 255) {
+    *clip_pos = nullptr;
+    return true;
+  }
+  // Clipped out pixels still take the backdrop when there is one.
+  if (coverage == 0 && !bBackdrop)
+    return false;
+
+  m_ClipScan.resize(m_ClipBox.Width());
+  m_pClipRuns->GetCoverage(y, left, right,
+                           m_ClipScan.data() + (left - m_ClipBox.left));
+  *clip_pos = m_ClipScan.data() + (x - m_ClipBox.left);
+  return true;
+}
+
 void CFX_Renderer::CompositeSpan1bppHelper(uint8_t* dest_scan,
                                            int col_start,
                                            int col_end,
@@ -926,15 +984,11 @@ void CFX_Renderer::CompositeSpan1bppHelper(uint8_t* dest_scan,
   }
 }
 
-template <class BaseRenderer>
-class RendererScanLineAaOffset {
+// Collects rendered scanlines into |runs|, with the coverage that blending
+// agg::gray8(255) onto a cleared agg::pixfmt_gray8 would produce.
+class ClipRunsRenderer {
  public:
-  typedef BaseRenderer base_ren_type;
-  typedef typename base_ren_type::color_type color_type;
-  RendererScanLineAaOffset(base_ren_type& ren, unsigned left, unsigned top)
-      : m_ren(&ren), m_left(left), m_top(top) {}
-  void color(const color_type& c) { m_color = c; }
-  const color_type& color() const { return m_color; }
+  explicit ClipRunsRenderer(CFX_ClipRuns* runs) : m_pRuns(runs) {}
   void prepare(unsigned) {}
   template <class Scanline>
   void render(const Scanline& sl) {
@@ -944,11 +998,19 @@ class RendererScanLineAaOffset {
     while (1) {
       int x = span->x;
       if (span->len > 0) {
-        m_ren->blend_solid_hspan(x - m_left, y - m_top, (unsigned)span->len,
-                                 m_color, span->covers);
+        int run_left = x;
+        uint8_t run_coverage = GetCoverage(span->covers[0]);
+        for (int i = 1; i < span->len; ++i) {
+          uint8_t coverage = GetCoverage(span->covers[i]);
+          if (coverage == run_coverage)
+            continue;
+          m_pRuns->AppendRun(y, run_left, x + i, run_coverage);
+          run_left = x + i;
+          run_coverage = coverage;
+        }
+        m_pRuns->AppendRun(y, run_left, x + span->len, run_coverage);
       } else {
-        m_ren->blend_hline(x - m_left, y - m_top, (unsigned)(x - span->len - 1),
-                           m_color, *(span->covers));
+        m_pRuns->AppendRun(y, x, x - span->len, GetCoverage(*span->covers));
       }
       if (--num_spans == 0)
         break;
@@ -958,10 +1020,12 @@ class RendererScanLineAaOffset {
   }
 
  private:
-  base_ren_type* m_ren;
-  color_type m_color;
-  unsigned m_left;
-  unsigned m_top;
+  static uint8_t GetCoverage(uint8_t cover) {
+    unsigned alpha = (255 * (cover + 1)) >> 8;
+    return alpha == 255 ? 255 : (255 * alpha) >> 8;
+  }
+
+  UnownedPtr<CFX_ClipRuns> const m_pRuns;
 };
 
 // Note: BuildAggPath() has to take |agg_path| as an out-parameter. If it
@@ -1011,6 +1075,34 @@ void BuildAggPath(const CFX_Path* pPath,
   }
 }
 
+void UnpremultiplyArgbRect(const RetainPtr<CFX_DIBitmap>& pBitmap,
+                           const FX_RECT& rect) {
+  for (int row = rect.top; row < rect.bottom; ++row) {
+    uint8_t* pixel = pBitmap->GetWritableScanline(row) + rect.left * 4;
+    for (int col = rect.left; col < rect.right; ++col, pixel += 4) {
+      const int alpha = pixel[3];
+      if (alpha == 0 || alpha == 255)
+        continue;
+      for (int i = 0; i < 3; ++i)
+        pixel[i] = std::min(255, (pixel[i] * 255 + alpha / 2) / alpha);
+    }
+  }
+}
+
+void PremultiplyArgbRect(const RetainPtr<CFX_DIBitmap>& pBitmap,
+                         const FX_RECT& rect) {
+  for (int row = rect.top; row < rect.bottom; ++row) {
+    uint8_t* pixel = pBitmap->GetWritableScanline(row) + rect.left * 4;
+    for (int col = rect.left; col < rect.right; ++col, pixel += 4) {
+      const int alpha = pixel[3];
+      if (alpha == 255)
+        continue;
+      for (int i = 0; i < 3; ++i)
+        pixel[i] = (pixel[i] * alpha + 127) / 255;
+    }
+  }
+}
+
 }  // namespace
 
 CFX_AggDeviceDriver::CFX_AggDeviceDriver(
@@ -1028,6 +1120,23 @@ CFX_AggDeviceDriver::CFX_AggDeviceDriver(
 
 CFX_AggDeviceDriver::~CFX_AggDeviceDriver() {
   DestroyPlatform();
+  if (!m_UnpremultipliedRect.IsEmpty())
+    PremultiplyArgbRect(m_pBitmap, m_UnpremultipliedRect);
+}
+
+void CFX_AggDeviceDriver::UnpremultiplyRect(const FX_RECT& rect) {
+  DCHECK(m_UnpremultipliedRect.IsEmpty());
+  if (!m_pBitmap->IsPremultiplied() ||
+      m_pBitmap->GetFormat() != FXDIB_Format::kArgb ||
+      !m_pBitmap->GetBuffer()) {
+    return;
+  }
+
+  m_UnpremultipliedRect = rect;
+  m_UnpremultipliedRect.Intersect(
+      FX_RECT(0, 0, m_pBitmap->GetWidth(), m_pBitmap->GetHeight()));
+  if (!m_UnpremultipliedRect.IsEmpty())
+    UnpremultiplyArgbRect(m_pBitmap, m_UnpremultipliedRect);
 }
 
 #if !defined(OS_APPLE)
@@ -1106,22 +1215,12 @@ void CFX_AggDeviceDriver::SetClipMask(agg::rasterizer_scanline_aa& rasterizer) {
   FX_RECT path_rect(rasterizer.min_x(), rasterizer.min_y(),
                     rasterizer.max_x() + 1, rasterizer.max_y() + 1);
   path_rect.Intersect(m_pClipRgn->GetBox());
-  auto pThisLayer = pdfium::MakeRetain<CFX_DIBitmap>();
-  pThisLayer->Create(path_rect.Width(), path_rect.Height(),
-                     FXDIB_Format::k8bppMask);
-  pThisLayer->Clear(0);
-  agg::rendering_buffer raw_buf(pThisLayer->GetBuffer(), pThisLayer->GetWidth(),
-                                pThisLayer->GetHeight(),
-                                pThisLayer->GetPitch());
-  agg::pixfmt_gray8 pixel_buf(raw_buf);
-  agg::renderer_base<agg::pixfmt_gray8> base_buf(pixel_buf);
-  RendererScanLineAaOffset<agg::renderer_base<agg::pixfmt_gray8>> final_render(
-      base_buf, path_rect.left, path_rect.top);
-  final_render.color(agg::gray8(255));
+  auto pThisLayer = pdfium::MakeRetain<CFX_ClipRuns>(path_rect);
+  ClipRunsRenderer final_render(pThisLayer.Get());
   agg::scanline_u8 scanline;
   agg::render_scanlines(rasterizer, scanline, final_render,
                         m_FillOptions.aliased_path);
-  m_pClipRgn->IntersectMaskF(path_rect.left, path_rect.top, pThisLayer);
+  m_pClipRgn->IntersectRuns(pThisLayer);
 }
 
 bool CFX_AggDeviceDriver::SetClip_PathFill(
@@ -1183,6 +1282,77 @@ int CFX_AggDeviceDriver::GetDriverType() const {
   return 1;
 }
 
+bool CFX_AggDeviceDriver::DrawGlyphRun(pdfium::span<const TextGlyphPos> glyphs,
+                                       const FX_RECT& bbox,
+                                       uint32_t color) {
+  // The caller otherwise composites the glyphs onto a copy of |bbox| and
+  // copies it back. Only skip that where it gives the same result: a plain
+  // 24 or 32 bpp bitmap with at most a rectangular clip.
+  if (!m_pBitmap->GetBuffer() || m_pBitmap->GetBPP() < 24 ||
+      m_pBitmap->IsAlphaFormat() || m_pBitmap->HasAlphaMask() ||
+      m_pBackdropBitmap || m_bRgbByteOrder) {
+    return false;
+  }
+  if (m_pClipRgn && m_pClipRgn->GetType() != CFX_ClipRgn::kRectI)
+    return false;
+
+  for (const TextGlyphPos& glyph : glyphs) {
+    if (glyph.m_pGlyph && glyph.m_pGlyph->GetBitmap()->GetBuffer() &&
+        glyph.m_pGlyph->GetBitmap()->GetFormat() != FXDIB_Format::k8bppMask) {
+      return false;
+    }
+  }
+
+  FX_RECT clip_box = bbox;
+  clip_box.Intersect(0, 0, m_pBitmap->GetWidth(), m_pBitmap->GetHeight());
+  if (clip_box.IsEmpty() || FXARGB_A(color) == 0)
+    return true;
+
+  CFX_ScanlineCompositor compositor;
+  if (!compositor.Init(m_pBitmap->GetFormat(), FXDIB_Format::k8bppMask,
+                       clip_box.Width(), {}, color, BlendMode::kNormal,
+                       /*bClip=*/false, /*bRgbByteOrder=*/false)) {
+    return false;
+  }
+
+  const int Bpp = m_pBitmap->GetBPP() / 8;
+  for (const TextGlyphPos& glyph : glyphs) {
+    if (!glyph.m_pGlyph)
+      continue;
+
+    Optional<CFX_Point> point = glyph.GetOrigin({0, 0});
+    if (!point.has_value())
+      continue;
+
+    const RetainPtr<CFX_DIBitmap>& pGlyph = glyph.m_pGlyph->GetBitmap();
+    if (!pGlyph->GetBuffer())
+      continue;
+
+    FX_SAFE_INT32 right = point->x;
+    right += pGlyph->GetWidth();
+    FX_SAFE_INT32 bottom = point->y;
+    bottom += pGlyph->GetHeight();
+    if (!right.IsValid() || !bottom.IsValid())
+      continue;
+
+    FX_RECT glyph_rect(point->x, point->y, right.ValueOrDie(),
+                       bottom.ValueOrDie());
+    glyph_rect.Intersect(clip_box);
+    if (glyph_rect.IsEmpty())
+      continue;
+
+    for (int row = glyph_rect.top; row < glyph_rect.bottom; ++row) {
+      const uint8_t* src_scan =
+          pGlyph->GetScanline(row - point->y) + (glyph_rect.left - point->x);
+      uint8_t* dest_scan =
+          m_pBitmap->GetWritableScanline(row) + glyph_rect.left * Bpp;
+      compositor.CompositeByteMaskLine(dest_scan, src_scan, glyph_rect.Width(),
+                                       nullptr, nullptr);
+    }
+  }
+  return true;
+}
+
 void CFX_AggDeviceDriver::RenderRasterizer(
     agg::rasterizer_scanline_aa& rasterizer,
     uint32_t color,
@@ -1315,7 +1485,7 @@ bool CFX_AggDeviceDriver::GetDIBits(const RetainPtr<CFX_DIBitmap>& pBitmap,
                                     int left,
                                     int top) {
   if (!m_pBitmap->GetBuffer())
-    return true;
+    return false;
 
   FX_RECT rect(left, top, left + pBitmap->GetWidth(),
                top + pBitmap->GetHeight());
@@ -1323,14 +1493,14 @@ bool CFX_AggDeviceDriver::GetDIBits(const RetainPtr<CFX_DIBitmap>& pBitmap,
   if (m_pBackdropBitmap) {
     pBack = m_pBackdropBitmap->Clone(&rect);
     if (!pBack)
-      return true;
+      return false;
 
     pBack->CompositeBitmap(0, 0, pBack->GetWidth(), pBack->GetHeight(),
                            m_pBitmap, 0, 0, BlendMode::kNormal, nullptr, false);
   } else {
     pBack = m_pBitmap->Clone(&rect);
     if (!pBack)
-      return true;
+      return false;
   }
 
   left = std::min(left, 0);
@@ -1439,11 +1609,29 @@ bool CFX_DefaultRenderDevice::Attach(
     return false;
 
   SetBitmap(pBitmap);
-  SetDeviceDriver(std::make_unique<pdfium::CFX_AggDeviceDriver>(
-      pBitmap, bRgbByteOrder, pBackdropBitmap, bGroupKnockout));
+  auto pDriver = std::make_unique<pdfium::CFX_AggDeviceDriver>(
+      pBitmap, bRgbByteOrder, pBackdropBitmap, bGroupKnockout);
+  pDriver->UnpremultiplyRect(
+      FX_RECT(0, 0, pBitmap->GetWidth(), pBitmap->GetHeight()));
+  SetDeviceDriver(std::move(pDriver));
   return true;
 }
 
+bool CFX_DefaultRenderDevice::AttachToRect(
+    const RetainPtr<CFX_DIBitmap>& pBitmap,
+    bool bRgbByteOrder,
+    const FX_RECT& rect) {
+  if (!pBitmap)
+    return false;
+
+  SetBitmap(pBitmap);
+  auto pDriver = std::make_unique<pdfium::CFX_AggDeviceDriver>(
+      pBitmap, bRgbByteOrder, nullptr, false);
+  pDriver->UnpremultiplyRect(rect);
+  SetDeviceDriver(std::move(pDriver));
+  return SetClip_Rect(rect);
+}
+
 bool CFX_DefaultRenderDevice::Create(
     int width,
     int height,
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "build/build_config.h"
+#include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxge/cfx_fillrenderoptions.h"
 #include "core/fxge/renderdevicedriver_iface.h"
@@ -34,6 +35,10 @@ class CFX_AggDeviceDriver final : public RenderDeviceDriverIface {
                       bool bGroupKnockout);
   ~CFX_AggDeviceDriver() override;
 
+  // Converts |rect| of a premultiplied kArgb bitmap to the unpremultiplied
+  // colors compositing works on. The destructor converts it back.
+  void UnpremultiplyRect(const FX_RECT& rect);
+
   void InitPlatform();
   void DestroyPlatform();
 
@@ -95,6 +100,9 @@ class CFX_AggDeviceDriver final : public RenderDeviceDriverIface {
                       uint32_t color,
                       const CFX_TextRenderOptions& options) override;
   int GetDriverType() const override;
+  bool DrawGlyphRun(pdfium::span<const TextGlyphPos> glyphs,
+                    const FX_RECT& bbox,
+                    uint32_t color) override;
 
  private:
   void RenderRasterizer(pdfium::agg::rasterizer_scanline_aa& rasterizer,
@@ -113,6 +121,7 @@ class CFX_AggDeviceDriver final : public RenderDeviceDriverIface {
   CFX_FillRenderOptions m_FillOptions;
   const bool m_bRgbByteOrder;
   const bool m_bGroupKnockout;
+  FX_RECT m_UnpremultipliedRect;
   RetainPtr<CFX_DIBitmap> m_pBackdropBitmap;
 };
 
@@ -10,6 +10,7 @@
 
 #include <utility>
 
+#include "core/fxge/cfx_clipruns.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
 #include "third_party/base/check_op.h"
 #include "third_party/base/notreached.h"
@@ -20,11 +21,25 @@ CFX_ClipRgn::CFX_ClipRgn(const CFX_ClipRgn& src) = default;
 
 CFX_ClipRgn::~CFX_ClipRgn() = default;
 
+RetainPtr<CFX_DIBitmap> CFX_ClipRgn::GetMask() const {
+  if (!m_Mask && m_Runs)
+    m_Mask = m_Runs->ToMask();
+  return m_Mask;
+}
+
+RetainPtr<const CFX_ClipRuns> CFX_ClipRgn::GetRuns() const {
+  return m_Runs;
+}
+
 void CFX_ClipRgn::IntersectRect(const FX_RECT& rect) {
   if (m_Type == kRectI) {
     m_Box.Intersect(rect);
     return;
   }
+  if (m_Runs) {
+    SetRuns(m_Runs->Crop(rect));
+    return;
+  }
   IntersectMaskRect(rect, m_Box, m_Mask);
 }
 
@@ -69,22 +84,80 @@ void CFX_ClipRgn::IntersectMaskF(int left,
   new_box.Intersect(mask_box);
   if (new_box.IsEmpty()) {
     m_Type = kRectI;
+    m_Runs = nullptr;
     m_Mask = nullptr;
     m_Box = new_box;
     return;
   }
   auto new_dib = pdfium::MakeRetain<CFX_DIBitmap>();
-  new_dib->Create(new_box.Width(), new_box.Height(), FXDIB_Format::k8bppMask);
+  if (!new_dib->Create(new_box.Width(), new_box.Height(),
+                       FXDIB_Format::k8bppMask)) {
+    return;
+  }
+  const int width = new_box.Width();
   for (int row = new_box.top; row < new_box.bottom; row++) {
-    const uint8_t* old_scan = m_Mask->GetScanline(row - m_Box.top);
     const uint8_t* mask_scan = pMask->GetScanline(row - top);
     uint8_t* new_scan =
         new_dib->GetBuffer() + (row - new_box.top) * new_dib->GetPitch();
+    // Regions kept as runs are read directly, without building their mask.
+    if (m_Mask) {
+      memcpy(new_scan,
+             m_Mask->GetScanline(row - m_Box.top) + new_box.left - m_Box.left,
+             width);
+    } else {
+      m_Runs->GetCoverage(row, new_box.left, new_box.right, new_scan);
+    }
     for (int col = new_box.left; col < new_box.right; col++) {
       new_scan[col - new_box.left] =
-          old_scan[col - m_Box.left] * mask_scan[col - left] / 255;
+          new_scan[col - new_box.left] * mask_scan[col - left] / 255;
     }
   }
   m_Box = new_box;
+  m_Runs = nullptr;
   m_Mask = std::move(new_dib);
 }
+
+void CFX_ClipRgn::IntersectRuns(const RetainPtr<const CFX_ClipRuns>& pRuns) {
+  if (m_Type == kRectI) {
+    if (pRuns->GetBox() == m_Box)
+      SetRuns(pRuns);
+    else
+      SetRuns(pRuns->Crop(m_Box));
+    return;
+  }
+  if (m_Runs) {
+    SetRuns(m_Runs->Intersect(*pRuns));
+    return;
+  }
+  // A region that is only a mask stays one.
+  FX_RECT new_box = m_Box;
+  new_box.Intersect(pRuns->GetBox());
+  if (new_box.IsEmpty()) {
+    m_Type = kRectI;
+    m_Mask = nullptr;
+    m_Box = new_box;
+    return;
+  }
+  RetainPtr<CFX_DIBitmap> pMask = pRuns->ToMask();
+  if (pMask)
+    IntersectMaskF(pRuns->GetBox().left, pRuns->GetBox().top, pMask);
+}
+
+void CFX_ClipRgn::SetRuns(const RetainPtr<const CFX_ClipRuns>& pRuns) {
+  m_Box = pRuns->GetBox();
+  m_Mask = nullptr;
+  if (m_Box.IsEmpty()) {
+    m_Type = kRectI;
+    m_Runs = nullptr;
+    return;
+  }
+  m_Type = kMaskF;
+  m_Runs = pRuns;
+  // Coverage that is fractional nearly everywhere is smaller as a mask.
+  if (m_Runs->GetMemorySize() <=
+      static_cast<size_t>(m_Box.Width()) * m_Box.Height()) {
+    return;
+  }
+  if (GetMask())
+    m_Runs = nullptr;
+}
@@ -10,6 +10,7 @@
 #include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/retain_ptr.h"
 
+class CFX_ClipRuns;
 class CFX_DIBitmap;
 
 class CFX_ClipRgn {
@@ -22,19 +23,29 @@ class CFX_ClipRgn {
 
   ClipType GetType() const { return m_Type; }
   const FX_RECT& GetBox() const { return m_Box; }
-  RetainPtr<CFX_DIBitmap> GetMask() const { return m_Mask; }
+  // For kMaskF regions, returns the coverage over GetBox(). Regions kept as
+  // runs only build the mask on the first call.
+  RetainPtr<CFX_DIBitmap> GetMask() const;
+  // For kMaskF regions, returns the coverage as runs, or nullptr if the
+  // region is only available as a mask.
+  RetainPtr<const CFX_ClipRuns> GetRuns() const;
 
   void IntersectRect(const FX_RECT& rect);
   void IntersectMaskF(int left, int top, const RetainPtr<CFX_DIBitmap>& Mask);
+  void IntersectRuns(const RetainPtr<const CFX_ClipRuns>& pRuns);
 
  private:
   void IntersectMaskRect(FX_RECT rect,
                          FX_RECT mask_rect,
                          const RetainPtr<CFX_DIBitmap>& Mask);
+  void SetRuns(const RetainPtr<const CFX_ClipRuns>& pRuns);
 
   ClipType m_Type = kRectI;
   FX_RECT m_Box;
-  RetainPtr<CFX_DIBitmap> m_Mask;
+  // A kMaskF region has |m_Runs| with the same box as |m_Box|, |m_Mask|, or
+  // both once GetMask() has built the mask from the runs.
+  RetainPtr<const CFX_ClipRuns> m_Runs;
+  mutable RetainPtr<CFX_DIBitmap> m_Mask;
 };
 
 #endif  // CORE_FXGE_CFX_CLIPRGN_H_
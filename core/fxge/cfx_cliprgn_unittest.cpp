@@ -0,0 +1,94 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/cfx_cliprgn.h"
+
+#include <algorithm>
+
+#include "core/fxge/cfx_clipruns.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// A diamond with anti-aliased edges inside |box|.
+RetainPtr<CFX_ClipRuns> CreateDiamond(const FX_RECT& box) {
+  auto runs = pdfium::MakeRetain<CFX_ClipRuns>(box);
+  int center = (box.left + box.right) / 2;
+  for (int y = box.top; y < box.bottom; ++y) {
+    int half = std::min(y - box.top, box.bottom - 1 - y);
+    runs->AppendRun(y, center - half - 1, center - half, 100);
+    runs->AppendRun(y, center - half, center + half, 255);
+    runs->AppendRun(y, center + half, center + half + 1, 100);
+  }
+  return runs;
+}
+
+void ExpectSameMask(const RetainPtr<CFX_DIBitmap>& expected,
+                    const RetainPtr<CFX_DIBitmap>& actual) {
+  ASSERT_TRUE(expected);
+  ASSERT_TRUE(actual);
+  ASSERT_EQ(expected->GetWidth(), actual->GetWidth());
+  ASSERT_EQ(expected->GetHeight(), actual->GetHeight());
+  for (int row = 0; row < expected->GetHeight(); ++row) {
+    for (int col = 0; col < expected->GetWidth(); ++col) {
+      EXPECT_EQ(expected->GetScanline(row)[col], actual->GetScanline(row)[col])
+          << row << ", " << col;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(CFX_ClipRgn, IntersectRunsMatchesMasks) {
+  RetainPtr<CFX_ClipRuns> first = CreateDiamond(FX_RECT(5, 5, 205, 205));
+  RetainPtr<CFX_ClipRuns> second = CreateDiamond(FX_RECT(100, 50, 300, 250));
+
+  CFX_ClipRgn by_runs(250, 250);
+  by_runs.IntersectRuns(first);
+  by_runs.IntersectRect(FX_RECT(0, 0, 180, 250));
+  by_runs.IntersectRuns(second);
+  EXPECT_EQ(CFX_ClipRgn::kMaskF, by_runs.GetType());
+  ASSERT_TRUE(by_runs.GetRuns());
+
+  CFX_ClipRgn by_masks(250, 250);
+  by_masks.IntersectMaskF(5, 5, first->ToMask());
+  by_masks.IntersectRect(FX_RECT(0, 0, 180, 250));
+  by_masks.IntersectMaskF(100, 50, second->ToMask());
+  EXPECT_EQ(CFX_ClipRgn::kMaskF, by_masks.GetType());
+  EXPECT_FALSE(by_masks.GetRuns());
+
+  EXPECT_EQ(by_masks.GetBox(), by_runs.GetBox());
+  ExpectSameMask(by_masks.GetMask(), by_runs.GetMask());
+
+  // Mixing in a mask drops the runs.
+  CFX_ClipRgn copy(by_runs);
+  copy.IntersectMaskF(0, 0, first->ToMask());
+  EXPECT_FALSE(copy.GetRuns());
+  EXPECT_TRUE(by_runs.GetRuns());
+  by_masks.IntersectMaskF(0, 0, first->ToMask());
+  EXPECT_EQ(by_masks.GetBox(), copy.GetBox());
+  ExpectSameMask(by_masks.GetMask(), copy.GetMask());
+}
+
+TEST(CFX_ClipRgn, IntersectRunsEmpty) {
+  CFX_ClipRgn clip(50, 50);
+  clip.IntersectRuns(CreateDiamond(FX_RECT(60, 0, 70, 10)));
+  EXPECT_EQ(CFX_ClipRgn::kRectI, clip.GetType());
+  EXPECT_TRUE(clip.GetBox().IsEmpty());
+}
+
+TEST(CFX_ClipRgn, IntersectRunsFallsBackToMask) {
+  // Every pixel has its own coverage, so a mask is smaller.
+  auto runs = pdfium::MakeRetain<CFX_ClipRuns>(FX_RECT(0, 0, 16, 16));
+  for (int y = 0; y < 16; ++y) {
+    for (int x = 0; x < 16; ++x)
+      runs->AppendRun(y, x, x + 1, (x + y * 16) % 254 + 1);
+  }
+  CFX_ClipRgn clip(50, 50);
+  clip.IntersectRuns(runs);
+  EXPECT_EQ(CFX_ClipRgn::kMaskF, clip.GetType());
+  EXPECT_FALSE(clip.GetRuns());
+  ExpectSameMask(runs->ToMask(), clip.GetMask());
+}
@@ -0,0 +1,144 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/cfx_clipruns.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "third_party/base/check.h"
+#include "third_party/base/numerics/safe_conversions.h"
+
+CFX_ClipRuns::CFX_ClipRuns(const FX_RECT& box)
+    : m_Box(box), m_Rows(std::max(box.Height(), 0)) {}
+
+CFX_ClipRuns::~CFX_ClipRuns() = default;
+
+size_t CFX_ClipRuns::GetMemorySize() const {
+  return m_Rows.size() * sizeof(Row) + m_Runs.size() * sizeof(Run);
+}
+
+void CFX_ClipRuns::AppendRun(int y, int left, int right, uint8_t coverage) {
+  if (y < m_Box.top || y >= m_Box.bottom || coverage == 0)
+    return;
+
+  left = std::max(left, m_Box.left);
+  right = std::min(right, m_Box.right);
+  if (left >= right)
+    return;
+
+  Row& row = m_Rows[y - m_Box.top];
+  if (row.begin == row.end) {
+    row.begin = pdfium::base::checked_cast<uint32_t>(m_Runs.size());
+    row.end = row.begin;
+  }
+  DCHECK(row.end == m_Runs.size());
+  if (row.end > row.begin) {
+    Run& last = m_Runs.back();
+    DCHECK(left >= last.right);
+    if (last.right == left && last.coverage == coverage) {
+      last.right = right;
+      return;
+    }
+  }
+  m_Runs.push_back({left, right, coverage});
+  row.end = pdfium::base::checked_cast<uint32_t>(m_Runs.size());
+}
+
+pdfium::span<const CFX_ClipRuns::Run> CFX_ClipRuns::GetRow(int y) const {
+  if (y < m_Box.top || y >= m_Box.bottom)
+    return pdfium::span<const Run>();
+
+  const Row& row = m_Rows[y - m_Box.top];
+  return pdfium::make_span(m_Runs).subspan(row.begin, row.end - row.begin);
+}
+
+Optional<uint8_t> CFX_ClipRuns::GetSolidCoverage(int y,
+                                                 int left,
+                                                 int right) const {
+  pdfium::span<const Run> runs = GetRow(y);
+  // Runs are disjoint and sorted, so their right edges are sorted as well.
+  auto it = std::upper_bound(
+      runs.begin(), runs.end(), left,
+      [](int x, const Run& run) { return x < run.right; });
+  if (it == runs.end() || it->left >= right)
+    return 0;
+  if (it->left <= left && it->right >= right)
+    return it->coverage;
+  return pdfium::nullopt;
+}
+
+void CFX_ClipRuns::GetCoverage(int y,
+                               int left,
+                               int right,
+                               uint8_t* dest) const {
+  memset(dest, 0, right - left);
+  for (const Run& run : GetRow(y)) {
+    if (run.right <= left)
+      continue;
+    if (run.left >= right)
+      break;
+    int start = std::max(run.left, left);
+    int end = std::min(run.right, right);
+    memset(dest + start - left, run.coverage, end - start);
+  }
+}
+
+RetainPtr<CFX_ClipRuns> CFX_ClipRuns::Crop(const FX_RECT& rect) const {
+  FX_RECT box = m_Box;
+  box.Intersect(rect);
+  auto pCropped = pdfium::MakeRetain<CFX_ClipRuns>(box);
+  if (box.IsEmpty())
+    return pCropped;
+
+  for (int y = box.top; y < box.bottom; ++y) {
+    for (const Run& run : GetRow(y))
+      pCropped->AppendRun(y, run.left, run.right, run.coverage);
+  }
+  return pCropped;
+}
+
+RetainPtr<CFX_ClipRuns> CFX_ClipRuns::Intersect(
+    const CFX_ClipRuns& other) const {
+  FX_RECT box = m_Box;
+  box.Intersect(other.m_Box);
+  auto pResult = pdfium::MakeRetain<CFX_ClipRuns>(box);
+  if (box.IsEmpty())
+    return pResult;
+
+  for (int y = box.top; y < box.bottom; ++y) {
+    pdfium::span<const Run> runs = GetRow(y);
+    pdfium::span<const Run> other_runs = other.GetRow(y);
+    size_t i = 0;
+    size_t j = 0;
+    while (i < runs.size() && j < other_runs.size()) {
+      const Run& a = runs[i];
+      const Run& b = other_runs[j];
+      int left = std::max(a.left, b.left);
+      int right = std::min(a.right, b.right);
+      if (left < right)
+        pResult->AppendRun(y, left, right, a.coverage * b.coverage / 255);
+      if (a.right < b.right)
+        ++i;
+      else
+        ++j;
+    }
+  }
+  return pResult;
+}
+
+RetainPtr<CFX_DIBitmap> CFX_ClipRuns::ToMask() const {
+  auto pMask = pdfium::MakeRetain<CFX_DIBitmap>();
+  if (!pMask->Create(m_Box.Width(), m_Box.Height(), FXDIB_Format::k8bppMask))
+    return nullptr;
+
+  for (int y = m_Box.top; y < m_Box.bottom; ++y) {
+    uint8_t* dest_scan =
+        pMask->GetBuffer() + pMask->GetPitch() * (y - m_Box.top);
+    GetCoverage(y, m_Box.left, m_Box.right, dest_scan);
+  }
+  return pMask;
+}
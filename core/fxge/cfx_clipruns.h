@@ -0,0 +1,74 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXGE_CFX_CLIPRUNS_H_
+#define CORE_FXGE_CFX_CLIPRUNS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "core/fxcrt/fx_coordinates.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "third_party/base/optional.h"
+#include "third_party/base/span.h"
+
+class CFX_DIBitmap;
+
+// Run-length encoded 8-bit clip coverage over a device rect. Each row is a
+// sorted list of disjoint runs of constant, non-zero coverage; pixels outside
+// the runs are clipped out. Most clip paths have fractional coverage only
+// along their edges, so this is far smaller than the equivalent mask.
+class CFX_ClipRuns final : public Retainable {
+ public:
+  CONSTRUCT_VIA_MAKE_RETAIN;
+
+  struct Run {
+    int left;
+    int right;
+    uint8_t coverage;
+  };
+
+  const FX_RECT& GetBox() const { return m_Box; }
+  size_t GetRunCount() const { return m_Runs.size(); }
+  // Approximate heap usage, to compare against a k8bppMask of GetBox().
+  size_t GetMemorySize() const;
+
+  // Adds [left, right) of row |y| with |coverage|, clamped to GetBox(). The
+  // runs of a row must be added left to right, before starting another row.
+  void AppendRun(int y, int left, int right, uint8_t coverage);
+
+  pdfium::span<const Run> GetRow(int y) const;
+
+  // Returns the coverage of [left, right) on row |y| if it is the same for
+  // all of those pixels, or nullopt if it varies.
+  Optional<uint8_t> GetSolidCoverage(int y, int left, int right) const;
+
+  // Writes the coverage of [left, right) on row |y| to |dest|.
+  void GetCoverage(int y, int left, int right, uint8_t* dest) const;
+
+  RetainPtr<CFX_ClipRuns> Crop(const FX_RECT& rect) const;
+
+  // Multiplies the coverage of both, like CFX_ClipRgn::IntersectMaskF().
+  RetainPtr<CFX_ClipRuns> Intersect(const CFX_ClipRuns& other) const;
+
+  // Returns a k8bppMask of GetBox(), or nullptr if it cannot be allocated.
+  RetainPtr<CFX_DIBitmap> ToMask() const;
+
+ private:
+  struct Row {
+    uint32_t begin = 0;
+    uint32_t end = 0;
+  };
+
+  explicit CFX_ClipRuns(const FX_RECT& box);
+  ~CFX_ClipRuns() override;
+
+  const FX_RECT m_Box;
+  std::vector<Row> m_Rows;
+  std::vector<Run> m_Runs;
+};
+
+#endif  // CORE_FXGE_CFX_CLIPRUNS_H_
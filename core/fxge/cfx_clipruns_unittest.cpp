@@ -0,0 +1,82 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/cfx_clipruns.h"
+
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+TEST(CFX_ClipRuns, AppendRun) {
+  auto runs = pdfium::MakeRetain<CFX_ClipRuns>(FX_RECT(10, 20, 30, 40));
+  // Clamped to the box, and adjacent runs with the same coverage merge.
+  runs->AppendRun(20, 0, 15, 255);
+  runs->AppendRun(20, 15, 18, 255);
+  runs->AppendRun(20, 18, 19, 0);
+  runs->AppendRun(20, 19, 50, 128);
+  runs->AppendRun(25, 12, 14, 64);
+  runs->AppendRun(40, 12, 14, 64);
+  EXPECT_EQ(3u, runs->GetRunCount());
+
+  pdfium::span<const CFX_ClipRuns::Run> row = runs->GetRow(20);
+  ASSERT_EQ(2u, row.size());
+  EXPECT_EQ(10, row[0].left);
+  EXPECT_EQ(18, row[0].right);
+  EXPECT_EQ(255, row[0].coverage);
+  EXPECT_EQ(19, row[1].left);
+  EXPECT_EQ(30, row[1].right);
+  EXPECT_EQ(128, row[1].coverage);
+  EXPECT_TRUE(runs->GetRow(21).empty());
+  EXPECT_EQ(1u, runs->GetRow(25).size());
+  EXPECT_TRUE(runs->GetRow(40).empty());
+
+  EXPECT_EQ(255, runs->GetSolidCoverage(20, 10, 18));
+  EXPECT_EQ(128, runs->GetSolidCoverage(20, 25, 30));
+  EXPECT_EQ(0, runs->GetSolidCoverage(20, 18, 19));
+  EXPECT_EQ(0, runs->GetSolidCoverage(21, 10, 30));
+  EXPECT_FALSE(runs->GetSolidCoverage(20, 17, 19).has_value());
+  EXPECT_FALSE(runs->GetSolidCoverage(20, 17, 20).has_value());
+
+  uint8_t coverage[5];
+  runs->GetCoverage(20, 16, 21, coverage);
+  const uint8_t kExpected[5] = {255, 255, 0, 128, 128};
+  for (size_t i = 0; i < 5; ++i)
+    EXPECT_EQ(kExpected[i], coverage[i]);
+}
+
+TEST(CFX_ClipRuns, CropAndIntersect) {
+  auto runs = pdfium::MakeRetain<CFX_ClipRuns>(FX_RECT(0, 0, 10, 2));
+  runs->AppendRun(0, 0, 10, 255);
+  runs->AppendRun(1, 2, 4, 100);
+  runs->AppendRun(1, 6, 8, 255);
+
+  RetainPtr<CFX_ClipRuns> cropped = runs->Crop(FX_RECT(3, 1, 20, 2));
+  EXPECT_EQ(FX_RECT(3, 1, 10, 2), cropped->GetBox());
+  ASSERT_EQ(2u, cropped->GetRow(1).size());
+  EXPECT_EQ(3, cropped->GetRow(1)[0].left);
+  EXPECT_EQ(4, cropped->GetRow(1)[0].right);
+  EXPECT_TRUE(runs->Crop(FX_RECT(10, 0, 20, 2))->GetBox().IsEmpty());
+
+  auto other = pdfium::MakeRetain<CFX_ClipRuns>(FX_RECT(1, 0, 12, 2));
+  other->AppendRun(0, 1, 5, 128);
+  other->AppendRun(1, 3, 7, 128);
+  RetainPtr<CFX_ClipRuns> result = runs->Intersect(*other);
+  EXPECT_EQ(FX_RECT(1, 0, 10, 2), result->GetBox());
+  EXPECT_EQ(3u, result->GetRunCount());
+  EXPECT_EQ(128, result->GetSolidCoverage(0, 1, 5));
+  EXPECT_EQ(0, result->GetSolidCoverage(0, 5, 10));
+  EXPECT_EQ(100 * 128 / 255, result->GetSolidCoverage(1, 3, 4));
+  EXPECT_EQ(0, result->GetSolidCoverage(1, 4, 6));
+  EXPECT_EQ(128, result->GetSolidCoverage(1, 6, 7));
+
+  RetainPtr<CFX_DIBitmap> mask = result->ToMask();
+  ASSERT_TRUE(mask);
+  EXPECT_EQ(FXDIB_Format::k8bppMask, mask->GetFormat());
+  EXPECT_EQ(9, mask->GetWidth());
+  EXPECT_EQ(2, mask->GetHeight());
+  EXPECT_EQ(128, mask->GetScanline(0)[0]);
+  EXPECT_EQ(0, mask->GetScanline(0)[4]);
+  EXPECT_EQ(100 * 128 / 255, mask->GetScanline(1)[2]);
+  EXPECT_EQ(128, mask->GetScanline(1)[5]);
+  EXPECT_EQ(0, mask->GetScanline(1)[6]);
+}
@@ -22,6 +22,13 @@ class CFX_DefaultRenderDevice final : public CFX_RenderDevice {
               bool bRgbByteOrder,
               const RetainPtr<CFX_DIBitmap>& pBackdropBitmap,
               bool bGroupKnockout);
+
+  // Like Attach() without a backdrop, but clips drawing to |rect|. A
+  // premultiplied |pBitmap| then has only |rect| converted to unpremultiplied
+  // colors while attached, instead of all of it.
+  bool AttachToRect(const RetainPtr<CFX_DIBitmap>& pBitmap,
+                    bool bRgbByteOrder,
+                    const FX_RECT& rect);
   bool Create(int width,
               int height,
               FXDIB_Format format,
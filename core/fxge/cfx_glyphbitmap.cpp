@@ -9,4 +9,9 @@
 CFX_GlyphBitmap::CFX_GlyphBitmap(int left, int top)
     : m_Left(left), m_Top(top), m_pBitmap(pdfium::MakeRetain<CFX_DIBitmap>()) {}
 
+CFX_GlyphBitmap::CFX_GlyphBitmap(int left,
+                                 int top,
+                                 const RetainPtr<CFX_DIBitmap>& pBitmap)
+    : m_Left(left), m_Top(top), m_pBitmap(pBitmap) {}
+
 CFX_GlyphBitmap::~CFX_GlyphBitmap() = default;
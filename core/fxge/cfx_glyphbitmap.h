@@ -14,6 +14,8 @@ class CFX_DIBitmap;
 class CFX_GlyphBitmap {
  public:
   CFX_GlyphBitmap(int left, int top);
+  // Shares |pBitmap|, which must not be modified afterwards.
+  CFX_GlyphBitmap(int left, int top, const RetainPtr<CFX_DIBitmap>& pBitmap);
   ~CFX_GlyphBitmap();
 
   CFX_GlyphBitmap(const CFX_GlyphBitmap&) = delete;
@@ -24,6 +24,7 @@
 #include "core/fxge/dib/cfx_dibitmap.h"
 #include "core/fxge/fx_freetype.h"
 #include "core/fxge/scoped_font_transform.h"
+#include "third_party/base/check.h"
 #include "third_party/base/numerics/safe_math.h"
 
 #if defined(_SKIA_SUPPORT_) || defined(_SKIA_SUPPORT_PATHS_)
@@ -98,11 +99,32 @@ void GenKey(UniqueKeyGen* pKeyGen,
   }
 }
 
+size_t GetGlyphBitmapBytes(const CFX_GlyphBitmap* pGlyphBitmap) {
+  if (!pGlyphBitmap)
+    return 0;
+
+  const RetainPtr<CFX_DIBitmap>& pBitmap = pGlyphBitmap->GetBitmap();
+  return sizeof(CFX_GlyphBitmap) + sizeof(CFX_DIBitmap) +
+         pBitmap->GetPitch() * pBitmap->GetHeight();
+}
+
 }  // namespace
 
+CFX_GlyphCache::CachedGlyph::CachedGlyph() = default;
+
+CFX_GlyphCache::CachedGlyph::CachedGlyph(CachedGlyph&& that) = default;
+
+CFX_GlyphCache::CachedGlyph::~CachedGlyph() = default;
+
 CFX_GlyphCache::CFX_GlyphCache(RetainPtr<CFX_Face> face) : m_Face(face) {}
 
-CFX_GlyphCache::~CFX_GlyphCache() = default;
+CFX_GlyphCache::~CFX_GlyphCache() {
+  CFX_GlyphCacheBudget* pBudget = CFX_GlyphCacheBudget::GetInstance();
+  for (const auto& size_cache : m_SizeMap) {
+    for (const auto& glyph : size_cache.second)
+      pBudget->RemoveEntry(glyph.second.budget_entry);
+  }
+}
 
 std::unique_ptr<CFX_GlyphBitmap> CFX_GlyphCache::RenderGlyph(
     const CFX_Font* pFont,
@@ -274,34 +296,21 @@ const CFX_GlyphBitmap* CFX_GlyphCache::LoadGlyphBitmap(
 
 #if defined(OS_APPLE) && !defined(_SKIA_SUPPORT_) && \
     !defined(_SKIA_SUPPORT_PATHS_)
-  std::unique_ptr<CFX_GlyphBitmap> pGlyphBitmap;
   auto it = m_SizeMap.find(FaceGlyphsKey);
   if (it != m_SizeMap.end()) {
-    SizeGlyphCache* pSizeCache = &(it->second);
-    auto it2 = pSizeCache->find(glyph_index);
-    if (it2 != pSizeCache->end())
-      return it2->second.get();
-
-    pGlyphBitmap = RenderGlyph_Nativetext(pFont, glyph_index, matrix,
-                                          dest_width, anti_alias);
-    if (pGlyphBitmap) {
-      CFX_GlyphBitmap* pResult = pGlyphBitmap.get();
-      (*pSizeCache)[glyph_index] = std::move(pGlyphBitmap);
-      return pResult;
-    }
-  } else {
-    pGlyphBitmap = RenderGlyph_Nativetext(pFont, glyph_index, matrix,
-                                          dest_width, anti_alias);
-    if (pGlyphBitmap) {
-      CFX_GlyphBitmap* pResult = pGlyphBitmap.get();
-
-      SizeGlyphCache cache;
-      cache[glyph_index] = std::move(pGlyphBitmap);
-
-      m_SizeMap[FaceGlyphsKey] = std::move(cache);
-      return pResult;
+    auto it2 = it->second.find(glyph_index);
+    if (it2 != it->second.end()) {
+      CFX_GlyphCacheBudget::GetInstance()->TouchEntry(
+          it2->second.budget_entry);
+      return it2->second.bitmap.get();
     }
   }
+  std::unique_ptr<CFX_GlyphBitmap> pGlyphBitmap = RenderGlyph_Nativetext(
+      pFont, glyph_index, matrix, dest_width, anti_alias);
+  if (pGlyphBitmap) {
+    return InsertGlyph(FaceGlyphsKey, &m_SizeMap[FaceGlyphsKey], glyph_index,
+                       std::move(pGlyphBitmap));
+  }
   GenKey(&keygen, pFont, matrix, dest_width, anti_alias, /*bNative=*/false);
   ByteString FaceGlyphsKey2(keygen.key_, keygen.key_len_);
   text_options->native_text = false;
@@ -351,12 +360,38 @@ CFX_GlyphBitmap* CFX_GlyphCache::LookUpGlyphBitmap(
   }
 
   auto it2 = pSizeCache->find(glyph_index);
-  if (it2 != pSizeCache->end())
-    return it2->second.get();
-
-  std::unique_ptr<CFX_GlyphBitmap> pGlyphBitmap = RenderGlyph(
-      pFont, glyph_index, bFontStyle, matrix, dest_width, anti_alias);
-  CFX_GlyphBitmap* pResult = pGlyphBitmap.get();
-  (*pSizeCache)[glyph_index] = std::move(pGlyphBitmap);
-  return pResult;
+  if (it2 != pSizeCache->end()) {
+    CFX_GlyphCacheBudget::GetInstance()->TouchEntry(it2->second.budget_entry);
+    return it2->second.bitmap.get();
+  }
+
+  return InsertGlyph(FaceGlyphsKey, pSizeCache, glyph_index,
+                     RenderGlyph(pFont, glyph_index, bFontStyle, matrix,
+                                 dest_width, anti_alias));
+}
+
+CFX_GlyphBitmap* CFX_GlyphCache::InsertGlyph(
+    const ByteString& FaceGlyphsKey,
+    SizeGlyphCache* pSizeCache,
+    uint32_t glyph_index,
+    std::unique_ptr<CFX_GlyphBitmap> pGlyphBitmap) {
+  CachedGlyph& glyph = (*pSizeCache)[glyph_index];
+  // Also account for glyphs that failed to render, as they are cached too.
+  glyph.budget_entry = CFX_GlyphCacheBudget::GetInstance()->AddEntry(
+      this, FaceGlyphsKey, glyph_index,
+      sizeof(CachedGlyph) + GetGlyphBitmapBytes(pGlyphBitmap.get()));
+  glyph.bitmap = std::move(pGlyphBitmap);
+  return glyph.bitmap.get();
+}
+
+void CFX_GlyphCache::EvictGlyph(const ByteString& FaceGlyphsKey,
+                                uint32_t glyph_index) {
+  auto it = m_SizeMap.find(FaceGlyphsKey);
+  DCHECK(it != m_SizeMap.end());
+  auto it2 = it->second.find(glyph_index);
+  DCHECK(it2 != it->second.end());
+  CFX_GlyphCacheBudget::GetInstance()->RemoveEntry(it2->second.budget_entry);
+  it->second.erase(it2);
+  if (it->second.empty())
+    m_SizeMap.erase(it);
 }
@@ -15,6 +15,7 @@
 #include "core/fxcrt/observed_ptr.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxge/cfx_face.h"
+#include "core/fxge/cfx_glyphcachebudget.h"
 
 #if defined(_SKIA_SUPPORT_) || defined(_SKIA_SUPPORT_PATHS_)
 #include "core/fxge/fx_font.h"
@@ -51,9 +52,20 @@ class CFX_GlyphCache : public Retainable, public Observable {
 #endif
 
  private:
+  friend class CFX_GlyphCacheBudget;
+
+  struct CachedGlyph {
+    CachedGlyph();
+    CachedGlyph(CachedGlyph&& that);
+    ~CachedGlyph();
+
+    std::unique_ptr<CFX_GlyphBitmap> bitmap;
+    CFX_GlyphCacheBudget::EntryList::iterator budget_entry;
+  };
+
   explicit CFX_GlyphCache(RetainPtr<CFX_Face> face);
 
-  using SizeGlyphCache = std::map<uint32_t, std::unique_ptr<CFX_GlyphBitmap>>;
+  using SizeGlyphCache = std::map<uint32_t, CachedGlyph>;
   // <glyph_index, width, weight, angle, vertical>
   using PathMapKey = std::tuple<uint32_t, int, int, int, bool>;
 
@@ -76,6 +88,12 @@ class CFX_GlyphCache : public Retainable, public Observable {
                                      bool bFontStyle,
                                      int dest_width,
                                      int anti_alias);
+  CFX_GlyphBitmap* InsertGlyph(const ByteString& FaceGlyphsKey,
+                               SizeGlyphCache* pSizeCache,
+                               uint32_t glyph_index,
+                               std::unique_ptr<CFX_GlyphBitmap> pGlyphBitmap);
+  // Called by CFX_GlyphCacheBudget::Trim().
+  void EvictGlyph(const ByteString& FaceGlyphsKey, uint32_t glyph_index);
   void InitPlatform();
   void DestroyPlatform();
 
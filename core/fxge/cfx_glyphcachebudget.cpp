@@ -0,0 +1,77 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/cfx_glyphcachebudget.h"
+
+#include <utility>
+
+#include "core/fxge/cfx_glyphcache.h"
+#include "third_party/base/check.h"
+
+// static
+CFX_GlyphCacheBudget* CFX_GlyphCacheBudget::GetInstance() {
+  static pdfium::base::NoDestructor<CFX_GlyphCacheBudget> s;
+  return s.get();
+}
+
+CFX_GlyphCacheBudget::CFX_GlyphCacheBudget() = default;
+
+CFX_GlyphCacheBudget::~CFX_GlyphCacheBudget() = default;
+
+void CFX_GlyphCacheBudget::SetMaxBytes(size_t max_bytes) {
+  m_MaxBytes = max_bytes;
+  Trim();
+}
+
+CFX_GlyphCacheBudget::Stats CFX_GlyphCacheBudget::GetStats() const {
+  Stats stats;
+  stats.hits = m_Hits;
+  stats.misses = m_Misses;
+  stats.evictions = m_Evictions;
+  stats.bytes = m_Bytes;
+  stats.entries = m_Entries.size();
+  return stats;
+}
+
+void CFX_GlyphCacheBudget::ResetCounters() {
+  m_Hits = 0;
+  m_Misses = 0;
+  m_Evictions = 0;
+}
+
+void CFX_GlyphCacheBudget::Trim() {
+  while (m_Bytes > m_MaxBytes) {
+    // Copy the key, as EvictGlyph() removes the entry.
+    Entry entry = m_Entries.back();
+    entry.cache->EvictGlyph(entry.size_key, entry.glyph_index);
+    ++m_Evictions;
+  }
+}
+
+CFX_GlyphCacheBudget::EntryList::iterator CFX_GlyphCacheBudget::AddEntry(
+    CFX_GlyphCache* cache,
+    const ByteString& size_key,
+    uint32_t glyph_index,
+    size_t bytes) {
+  ++m_Misses;
+  m_Bytes += bytes;
+  Entry entry;
+  entry.cache = cache;
+  entry.size_key = size_key;
+  entry.glyph_index = glyph_index;
+  entry.bytes = bytes;
+  m_Entries.push_front(std::move(entry));
+  return m_Entries.begin();
+}
+
+void CFX_GlyphCacheBudget::TouchEntry(EntryList::iterator it) {
+  ++m_Hits;
+  m_Entries.splice(m_Entries.begin(), m_Entries, it);
+}
+
+void CFX_GlyphCacheBudget::RemoveEntry(EntryList::iterator it) {
+  DCHECK(m_Bytes >= it->bytes);
+  m_Bytes -= it->bytes;
+  m_Entries.erase(it);
+}
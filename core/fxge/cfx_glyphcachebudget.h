@@ -0,0 +1,80 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXGE_CFX_GLYPHCACHEBUDGET_H_
+#define CORE_FXGE_CFX_GLYPHCACHEBUDGET_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <list>
+
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/unowned_ptr.h"
+#include "third_party/base/no_destructor.h"
+
+class CFX_GlyphCache;
+
+// Process-wide byte budget for the glyph bitmaps held by all CFX_GlyphCache
+// instances. Once the glyphs take up more than GetMaxBytes(), the least
+// recently used ones are evicted. Eviction only happens in Trim(), so glyph
+// bitmaps returned by CFX_GlyphCache stay valid until the next Trim() call.
+// Like the glyph caches themselves, this is not thread-safe.
+class CFX_GlyphCacheBudget {
+ public:
+  struct Entry {
+    UnownedPtr<CFX_GlyphCache> cache;
+    ByteString size_key;
+    uint32_t glyph_index;
+    size_t bytes;
+  };
+  using EntryList = std::list<Entry>;
+
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t bytes = 0;
+    size_t entries = 0;
+  };
+
+  static constexpr size_t kDefaultMaxBytes = 64 * 1024 * 1024;
+
+  static CFX_GlyphCacheBudget* GetInstance();
+
+  size_t GetMaxBytes() const { return m_MaxBytes; }
+  void SetMaxBytes(size_t max_bytes);
+
+  Stats GetStats() const;
+  // Resets the hit, miss and eviction counters.
+  void ResetCounters();
+
+  // Evicts least recently used glyphs until the budget is met. Callers must
+  // not hold on to glyph bitmaps across this call.
+  void Trim();
+
+  // For CFX_GlyphCache to report lookups and to track its glyphs.
+  EntryList::iterator AddEntry(CFX_GlyphCache* cache,
+                               const ByteString& size_key,
+                               uint32_t glyph_index,
+                               size_t bytes);
+  void TouchEntry(EntryList::iterator it);
+  void RemoveEntry(EntryList::iterator it);
+
+ private:
+  friend pdfium::base::NoDestructor<CFX_GlyphCacheBudget>;
+
+  CFX_GlyphCacheBudget();
+  ~CFX_GlyphCacheBudget();
+
+  size_t m_MaxBytes = kDefaultMaxBytes;
+  size_t m_Bytes = 0;
+  uint64_t m_Hits = 0;
+  uint64_t m_Misses = 0;
+  uint64_t m_Evictions = 0;
+  // Most recently used first.
+  EntryList m_Entries;
+};
+
+#endif  // CORE_FXGE_CFX_GLYPHCACHEBUDGET_H_
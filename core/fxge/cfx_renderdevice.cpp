@@ -22,6 +22,7 @@
 #include "core/fxge/cfx_gemodule.h"
 #include "core/fxge/cfx_glyphbitmap.h"
 #include "core/fxge/cfx_glyphcache.h"
+#include "core/fxge/cfx_glyphcachebudget.h"
 #include "core/fxge/cfx_graphstatedata.h"
 #include "core/fxge/cfx_path.h"
 #include "core/fxge/cfx_textrenderoptions.h"
@@ -552,16 +553,18 @@ bool CFX_RenderDevice::CreateCompatibleBitmap(
     const RetainPtr<CFX_DIBitmap>& pDIB,
     int width,
     int height) const {
+  return pDIB->Create(width, height, GetCompatibleBitmapFormat());
+}
+
+FXDIB_Format CFX_RenderDevice::GetCompatibleBitmapFormat() const {
   if (m_RenderCaps & FXRC_BYTEMASK_OUTPUT)
-    return pDIB->Create(width, height, FXDIB_Format::k8bppMask);
+    return FXDIB_Format::k8bppMask;
 #if defined(_SKIA_SUPPORT_PATHS_)
   constexpr FXDIB_Format kFormat = FXDIB_Format::kRgb32;
 #else
   constexpr FXDIB_Format kFormat = CFX_DIBBase::kPlatformRGBFormat;
 #endif
-  return pDIB->Create(
-      width, height,
-      m_RenderCaps & FXRC_ALPHA_OUTPUT ? FXDIB_Format::kArgb : kFormat);
+  return m_RenderCaps & FXRC_ALPHA_OUTPUT ? FXDIB_Format::kArgb : kFormat;
 }
 
 void CFX_RenderDevice::SetBaseClip(const FX_RECT& rect) {
@@ -1094,6 +1097,10 @@ bool CFX_RenderDevice::DrawNormalText(int nChars,
                           path_options);
     }
   }
+  // Glyph bitmaps are only evicted here, so the ones loaded below stay valid
+  // until this call is done with them.
+  CFX_GlyphCacheBudget::GetInstance()->Trim();
+
   std::vector<TextGlyphPos> glyphs(nChars);
   CFX_Matrix deviceCtm = char2device;
 
@@ -1130,6 +1137,11 @@ bool CFX_RenderDevice::DrawNormalText(int nChars,
   if (bmp_rect.IsEmpty())
     return true;
 
+  if (anti_alias == FT_RENDER_MODE_NORMAL &&
+      m_pDeviceDriver->DrawGlyphRun(glyphs, bmp_rect, fill_color)) {
+    return true;
+  }
+
   int pixel_width = bmp_rect.Width();
   int pixel_height = bmp_rect.Height();
   int pixel_left = bmp_rect.left;
@@ -0,0 +1,131 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/dib/cfx_bitmappool.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "core/fxcrt/fx_memory_wrappers.h"
+#include "core/fxcrt/fx_safe_types.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+
+namespace {
+
+constexpr size_t kMinSizeClassStep = 4096;
+
+}  // namespace
+
+CFX_BitmapPool::Entry::Entry() = default;
+
+CFX_BitmapPool::Entry::Entry(Entry&& that) noexcept = default;
+
+CFX_BitmapPool::Entry& CFX_BitmapPool::Entry::operator=(Entry&& that) noexcept =
+    default;
+
+CFX_BitmapPool::Entry::~Entry() = default;
+
+bool CFX_BitmapPool::Entry::IsIdle() const {
+  return bitmap->HasOneRef();
+}
+
+CFX_BitmapPool::CFX_BitmapPool() = default;
+
+CFX_BitmapPool::~CFX_BitmapPool() = default;
+
+RetainPtr<CFX_DIBitmap> CFX_BitmapPool::Create(int width,
+                                               int height,
+                                               FXDIB_Format format) {
+  Optional<CFX_DIBitmap::PitchAndSize> pitch_size =
+      CFX_DIBitmap::CalculatePitchAndSize(width, height, format, /*pitch=*/0);
+  if (!pitch_size.has_value())
+    return nullptr;
+
+  // Same slack as CFX_DIBitmap::Create() allocates.
+  FX_SAFE_SIZE_T safe_size = pitch_size.value().size;
+  safe_size += 4;
+  if (!safe_size.IsValid())
+    return nullptr;
+
+  const size_t capacity = GetSizeClass(safe_size.ValueOrDie());
+  std::unique_ptr<uint8_t, FxFreeDeleter> pBuffer;
+  auto it = std::find_if(m_Entries.begin(), m_Entries.end(),
+                         [capacity](const Entry& entry) {
+                           return entry.capacity == capacity && entry.IsIdle();
+                         });
+  if (it != m_Entries.end()) {
+    // Only take back buffers the bitmap still has as it was created.
+    const CFX_DIBitmap* pOld = it->bitmap.Get();
+    if (pOld->GetBuffer() == it->buffer && pOld->GetWidth() == it->width &&
+        pOld->GetHeight() == it->height && pOld->GetFormat() == it->format) {
+      pBuffer = it->bitmap->ReleaseBuffer();
+      // Callers rely on the zeroed pixels of a new bitmap, e.g. where
+      // CFX_RenderDevice::GetDIBits() fails to fill a backdrop.
+      memset(pBuffer.get(), 0, safe_size.ValueOrDie());
+    }
+    m_Entries.erase(it);
+  }
+  if (!pBuffer) {
+    pBuffer.reset(FX_TryAlloc(uint8_t, capacity));
+    if (!pBuffer)
+      return nullptr;
+  }
+
+  Entry entry;
+  entry.capacity = capacity;
+  entry.buffer = pBuffer.get();
+  entry.width = width;
+  entry.height = height;
+  entry.format = format;
+  entry.bitmap = pdfium::MakeRetain<CFX_DIBitmap>();
+  if (!entry.bitmap->CreateWithOwnedBuffer(width, height, format,
+                                           std::move(pBuffer), capacity)) {
+    return nullptr;
+  }
+
+  RetainPtr<CFX_DIBitmap> pBitmap = entry.bitmap;
+  m_Entries.push_back(std::move(entry));
+  Trim();
+  return pBitmap;
+}
+
+size_t CFX_BitmapPool::GetIdleBytes() const {
+  size_t bytes = 0;
+  for (const Entry& entry : m_Entries) {
+    if (entry.IsIdle())
+      bytes += entry.capacity;
+  }
+  return bytes;
+}
+
+void CFX_BitmapPool::SetMaxIdleBytes(size_t max_bytes) {
+  m_MaxIdleBytes = max_bytes;
+  Trim();
+}
+
+// static
+size_t CFX_BitmapPool::GetSizeClass(size_t size) {
+  // Steps of roughly an eighth of |size| keep the waste per buffer small,
+  // while letting bitmaps of similar sizes share buffers.
+  size_t step = kMinSizeClassStep;
+  while (step < size / 8)
+    step *= 2;
+  return (size + step - 1) / step * step;
+}
+
+void CFX_BitmapPool::Trim() {
+  size_t idle_bytes = GetIdleBytes();
+  auto it = m_Entries.begin();
+  while (idle_bytes > m_MaxIdleBytes && it != m_Entries.end()) {
+    if (!it->IsIdle()) {
+      ++it;
+      continue;
+    }
+    idle_bytes -= it->capacity;
+    it = m_Entries.erase(it);
+  }
+}
@@ -0,0 +1,64 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXGE_DIB_CFX_BITMAPPOOL_H_
+#define CORE_FXGE_DIB_CFX_BITMAPPOOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxge/dib/fx_dib.h"
+
+class CFX_DIBitmap;
+
+// Recycles the pixel buffers of short-lived scratch bitmaps, such as
+// transparency group backings and soft masks. The pool keeps a reference to
+// every bitmap it creates, and reuses its buffer once that is the last one.
+class CFX_BitmapPool {
+ public:
+  static constexpr size_t kDefaultMaxIdleBytes = 16 * 1024 * 1024;
+
+  CFX_BitmapPool();
+  ~CFX_BitmapPool();
+
+  // Returns a zeroed bitmap like CFX_DIBitmap::Create() does, or nullptr on
+  // failure. Its buffer may be larger than needed, rounded up to a size
+  // class.
+  RetainPtr<CFX_DIBitmap> Create(int width, int height, FXDIB_Format format);
+
+  // Bytes held by buffers that are not in use.
+  size_t GetIdleBytes() const;
+  void SetMaxIdleBytes(size_t max_bytes);
+
+  static size_t GetSizeClass(size_t size);
+
+ private:
+  struct Entry {
+    Entry();
+    Entry(Entry&& that) noexcept;
+    Entry& operator=(Entry&& that) noexcept;
+    ~Entry();
+
+    bool IsIdle() const;
+
+    RetainPtr<CFX_DIBitmap> bitmap;
+    size_t capacity = 0;
+    // What |bitmap| was created with, to notice bitmaps changed in place.
+    const uint8_t* buffer = nullptr;
+    int width = 0;
+    int height = 0;
+    FXDIB_Format format = FXDIB_Format::kInvalid;
+  };
+
+  void Trim();
+
+  size_t m_MaxIdleBytes = kDefaultMaxIdleBytes;
+  // Least recently created first.
+  std::vector<Entry> m_Entries;
+};
+
+#endif  // CORE_FXGE_DIB_CFX_BITMAPPOOL_H_
@@ -0,0 +1,72 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/dib/cfx_bitmappool.h"
+
+#include <algorithm>
+
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+TEST(CFX_BitmapPool, SizeClass) {
+  EXPECT_EQ(4096u, CFX_BitmapPool::GetSizeClass(1));
+  EXPECT_EQ(4096u, CFX_BitmapPool::GetSizeClass(4096));
+  EXPECT_EQ(8192u, CFX_BitmapPool::GetSizeClass(4097));
+  EXPECT_EQ(32768u, CFX_BitmapPool::GetSizeClass(32768));
+  EXPECT_EQ(36864u, CFX_BitmapPool::GetSizeClass(32769));
+  EXPECT_EQ(1024u * 1024, CFX_BitmapPool::GetSizeClass(1000 * 1000));
+}
+
+TEST(CFX_BitmapPool, ReuseBuffers) {
+  CFX_BitmapPool pool;
+  RetainPtr<CFX_DIBitmap> pBitmap = pool.Create(100, 100, FXDIB_Format::kArgb);
+  ASSERT_TRUE(pBitmap);
+  EXPECT_EQ(100, pBitmap->GetWidth());
+  EXPECT_EQ(100, pBitmap->GetHeight());
+  EXPECT_EQ(FXDIB_Format::kArgb, pBitmap->GetFormat());
+  EXPECT_EQ(0u, pool.GetIdleBytes());
+
+  // Still in use, so a new buffer is needed.
+  RetainPtr<CFX_DIBitmap> pOther = pool.Create(100, 100, FXDIB_Format::kArgb);
+  ASSERT_TRUE(pOther);
+  EXPECT_NE(pBitmap->GetBuffer(), pOther->GetBuffer());
+  pOther.Reset();
+
+  // Done with, so a bitmap of another format and a similar size gets it,
+  // zeroed again.
+  const uint8_t* buffer = pBitmap->GetBuffer();
+  pBitmap->Clear(0xFFFFFFFF);
+  pBitmap.Reset();
+  size_t capacity = CFX_BitmapPool::GetSizeClass(100 * 100 * 4 + 4);
+  EXPECT_EQ(2 * capacity, pool.GetIdleBytes());
+  RetainPtr<CFX_DIBitmap> pMask =
+      pool.Create(200, 196, FXDIB_Format::k8bppMask);
+  ASSERT_TRUE(pMask);
+  EXPECT_EQ(buffer, pMask->GetBuffer());
+  EXPECT_EQ(FXDIB_Format::k8bppMask, pMask->GetFormat());
+  for (int row = 0; row < pMask->GetHeight(); ++row) {
+    const uint8_t* scanline = pMask->GetScanline(row);
+    EXPECT_TRUE(std::all_of(scanline, scanline + pMask->GetWidth(),
+                            [](uint8_t value) { return value == 0; }))
+        << row;
+  }
+  EXPECT_EQ(capacity, pool.GetIdleBytes());
+
+  pool.SetMaxIdleBytes(0);
+  EXPECT_EQ(0u, pool.GetIdleBytes());
+  EXPECT_EQ(200, pMask->GetWidth());
+}
+
+TEST(CFX_BitmapPool, SkipChangedBitmaps) {
+  CFX_BitmapPool pool;
+  RetainPtr<CFX_DIBitmap> pBitmap = pool.Create(64, 64, FXDIB_Format::kRgb);
+  ASSERT_TRUE(pBitmap);
+  ASSERT_TRUE(pBitmap->ConvertFormat(FXDIB_Format::kArgb));
+  const uint8_t* buffer = pBitmap->GetBuffer();
+  pBitmap.Reset();
+
+  RetainPtr<CFX_DIBitmap> pNew = pool.Create(64, 64, FXDIB_Format::kRgb);
+  ASSERT_TRUE(pNew);
+  EXPECT_NE(buffer, pNew->GetBuffer());
+}
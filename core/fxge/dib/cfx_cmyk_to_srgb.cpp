@@ -7,6 +7,7 @@
 #include "core/fxge/dib/cfx_cmyk_to_srgb.h"
 
 #include <algorithm>
+#include <array>
 #include <tuple>
 
 #include "core/fxcrt/fx_system.h"
@@ -1660,6 +1661,44 @@ constexpr uint8_t kCMYK[81 * 81][3] = {
     {0, 0, 0},
 };
 
+// Per-channel interpolation parameters, as computed by AdobeCMYK_to_sRGB1().
+struct AxisStep {
+  // Offset of the nearest grid point in |kCMYK|.
+  int16_t pos;
+  // Offset from the nearest grid point to the neighbor interpolated against.
+  int16_t neighbor;
+  int16_t rate;
+};
+
+using AxisTable = std::array<AxisStep, 256>;
+
+constexpr AxisTable BuildAxisTable(int stride) {
+  AxisTable table = {};
+  for (int value = 0; value < 256; ++value) {
+    const int fix = value << 8;
+    const int index = (fix + 4096) >> 13;
+    int index1 = fix >> 13;
+    if (index1 == index)
+      index1 = index1 == 8 ? index1 - 1 : index1 + 1;
+    table[value].pos = index * stride;
+    table[value].neighbor = (index1 - index) * stride;
+    table[value].rate = (fix - (index << 13)) * (index - index1);
+  }
+  return table;
+}
+
+constexpr AxisTable kCTable = BuildAxisTable(9 * 9 * 9);
+constexpr AxisTable kMTable = BuildAxisTable(9 * 9);
+constexpr AxisTable kYTable = BuildAxisTable(9);
+constexpr AxisTable kKTable = BuildAxisTable(1);
+
+void AddAxisDelta(int pos, const AxisStep& step, int* fix_rgb) {
+  const uint8_t* base = kCMYK[pos];
+  const uint8_t* neighbor = kCMYK[pos + step.neighbor];
+  for (int i = 0; i < 3; ++i)
+    fix_rgb[i] += (base[i] - neighbor[i]) * step.rate / 32;
+}
+
 }  // namespace
 
 std::tuple<uint8_t, uint8_t, uint8_t> AdobeCMYK_to_sRGB1(uint8_t c,
@@ -1722,6 +1761,29 @@ std::tuple<uint8_t, uint8_t, uint8_t> AdobeCMYK_to_sRGB1(uint8_t c,
   return std::make_tuple(fix_r >> 8, fix_g >> 8, fix_b >> 8);
 }
 
+void AdobeCMYK_to_sRGB1_Line(const uint8_t* src_cmyk,
+                             uint8_t* dest_bgr,
+                             int pixels) {
+  for (int i = 0; i < pixels; ++i) {
+    const AxisStep& c = kCTable[src_cmyk[0]];
+    const AxisStep& m = kMTable[src_cmyk[1]];
+    const AxisStep& y = kYTable[src_cmyk[2]];
+    const AxisStep& k = kKTable[src_cmyk[3]];
+    const int pos = c.pos + m.pos + y.pos + k.pos;
+    int fix_rgb[3] = {kCMYK[pos][0] << 8, kCMYK[pos][1] << 8,
+                      kCMYK[pos][2] << 8};
+    AddAxisDelta(pos, c, fix_rgb);
+    AddAxisDelta(pos, m, fix_rgb);
+    AddAxisDelta(pos, y, fix_rgb);
+    AddAxisDelta(pos, k, fix_rgb);
+    dest_bgr[0] = std::max(fix_rgb[2], 0) >> 8;
+    dest_bgr[1] = std::max(fix_rgb[1], 0) >> 8;
+    dest_bgr[2] = std::max(fix_rgb[0], 0) >> 8;
+    src_cmyk += 4;
+    dest_bgr += 3;
+  }
+}
+
 std::tuple<float, float, float> AdobeCMYK_to_sRGB(float c,
                                                   float m,
                                                   float y,
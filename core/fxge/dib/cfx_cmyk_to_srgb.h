@@ -22,9 +22,17 @@ std::tuple<uint8_t, uint8_t, uint8_t> AdobeCMYK_to_sRGB1(uint8_t c,
                                                          uint8_t y,
                                                          uint8_t k);
 
+// Converts |pixels| 4-byte CMYK pixels from |src_cmyk| to 3-byte BGR pixels in
+// |dest_bgr|. Gives the same results as calling AdobeCMYK_to_sRGB1() on each
+// pixel, but looks up the interpolation parameters from precomputed tables.
+void AdobeCMYK_to_sRGB1_Line(const uint8_t* src_cmyk,
+                             uint8_t* dest_bgr,
+                             int pixels);
+
 }  // namespace fxge
 
 using fxge::AdobeCMYK_to_sRGB;
 using fxge::AdobeCMYK_to_sRGB1;
+using fxge::AdobeCMYK_to_sRGB1_Line;
 
 #endif  // CORE_FXGE_DIB_CFX_CMYK_TO_SRGB_H_
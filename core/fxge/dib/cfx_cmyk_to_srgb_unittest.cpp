@@ -4,6 +4,11 @@
 
 #include "core/fxge/dib/cfx_cmyk_to_srgb.h"
 
+#include <stdint.h>
+
+#include <tuple>
+#include <vector>
+
 #include "testing/gtest/include/gtest/gtest.h"
 
 union Float_t {
@@ -30,3 +35,43 @@ TEST(fxge, CMYK_Rounding) {
   // Check various other 'special' numbers.
   std::tie(R, G, B) = AdobeCMYK_to_sRGB(0.0f, 0.25f, 0.5f, 1.0f);
 }
+
+TEST(fxge, CMYK_Line) {
+  // Step through each channel, including both ends of the range, and check
+  // every pixel against the single pixel conversion.
+  constexpr int kStep = 15;
+  std::vector<uint8_t> src;
+  for (int c = 0; c < 256; c += kStep) {
+    for (int m = 0; m < 256; m += kStep) {
+      for (int y = 0; y < 256; y += kStep) {
+        for (int k = 0; k < 256; k += kStep) {
+          src.push_back(c);
+          src.push_back(m);
+          src.push_back(y);
+          src.push_back(k);
+        }
+      }
+    }
+  }
+  // Values next to grid points and midpoints between them.
+  for (uint8_t value : {1, 31, 32, 33, 95, 96, 97, 223, 224, 254}) {
+    src.push_back(value);
+    src.push_back(255 - value);
+    src.push_back(value / 2);
+    src.push_back(value);
+  }
+
+  const int pixels = src.size() / 4;
+  std::vector<uint8_t> dest(pixels * 3);
+  AdobeCMYK_to_sRGB1_Line(src.data(), dest.data(), pixels);
+  for (int i = 0; i < pixels; ++i) {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    std::tie(r, g, b) = AdobeCMYK_to_sRGB1(src[i * 4], src[i * 4 + 1],
+                                           src[i * 4 + 2], src[i * 4 + 3]);
+    EXPECT_EQ(b, dest[i * 3]) << i;
+    EXPECT_EQ(g, dest[i * 3 + 1]) << i;
+    EXPECT_EQ(r, dest[i * 3 + 2]) << i;
+  }
+}
@@ -75,6 +75,36 @@ bool CFX_DIBitmap::Create(int width,
   return false;
 }
 
+bool CFX_DIBitmap::CreateWithOwnedBuffer(
+    int width,
+    int height,
+    FXDIB_Format format,
+    std::unique_ptr<uint8_t, FxFreeDeleter> pBuffer,
+    size_t buffer_size) {
+  Optional<PitchAndSize> pitch_size =
+      CalculatePitchAndSize(width, height, format, /*pitch=*/0);
+  if (!pBuffer || !pitch_size.has_value() ||
+      buffer_size < pitch_size.value().size) {
+    return false;
+  }
+  if (!Create(width, height, format, pBuffer.get(), /*pitch=*/0))
+    return false;
+
+  m_pBuffer.Reset(std::move(pBuffer));
+  return true;
+}
+
+std::unique_ptr<uint8_t, FxFreeDeleter> CFX_DIBitmap::ReleaseBuffer() {
+  if (!m_pBuffer.IsOwned())
+    return nullptr;
+
+  m_Width = 0;
+  m_Height = 0;
+  m_Pitch = 0;
+  m_pAlphaMask = nullptr;
+  return m_pBuffer.ReleaseAndClear();
+}
+
 bool CFX_DIBitmap::Copy(const RetainPtr<CFX_DIBBase>& pSrc) {
   if (m_pBuffer)
     return false;
@@ -7,6 +7,8 @@
 #ifndef CORE_FXGE_DIB_CFX_DIBITMAP_H_
 #define CORE_FXGE_DIB_CFX_DIBITMAP_H_
 
+#include <memory>
+
 #include "core/fxcrt/fx_memory_wrappers.h"
 #include "core/fxcrt/maybe_owned.h"
 #include "core/fxcrt/retain_ptr.h"
@@ -29,9 +31,27 @@ class CFX_DIBitmap : public CFX_DIBBase {
               FXDIB_Format format,
               uint8_t* pBuffer,
               uint32_t pitch);
+  // Like Create(), but takes ownership of |pBuffer|, which must hold at least
+  // |buffer_size| bytes.
+  bool CreateWithOwnedBuffer(int width,
+                             int height,
+                             FXDIB_Format format,
+                             std::unique_ptr<uint8_t, FxFreeDeleter> pBuffer,
+                             size_t buffer_size);
+
+  // Returns the pixel buffer if the bitmap owns it, leaving the bitmap empty.
+  std::unique_ptr<uint8_t, FxFreeDeleter> ReleaseBuffer();
 
   bool Copy(const RetainPtr<CFX_DIBBase>& pSrc);
 
+  // Whether the owner of a kArgb bitmap keeps its colors premultiplied by
+  // alpha. Render devices work on unpremultiplied colors, so
+  // CFX_DefaultRenderDevice converts the attached area of such bitmaps.
+  bool IsPremultiplied() const { return m_bPremultiplied; }
+  void SetPremultiplied(bool premultiplied) {
+    m_bPremultiplied = premultiplied;
+  }
+
   // CFX_DIBBase
   uint8_t* GetBuffer() const override;
   const uint8_t* GetScanline(int line) const override;
@@ -154,6 +174,8 @@ class CFX_DIBitmap : public CFX_DIBBase {
                                   const RetainPtr<CFX_DIBBase>& pSrcBitmap,
                                   int src_left,
                                   int src_top);
+
+  bool m_bPremultiplied = false;
 };
 
 #endif  // CORE_FXGE_DIB_CFX_DIBITMAP_H_
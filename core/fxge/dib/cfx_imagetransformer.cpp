@@ -7,6 +7,8 @@
 #include "core/fxge/dib/cfx_imagetransformer.h"
 
 #include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
 
 #include <memory>
 #include <utility>
@@ -45,6 +47,26 @@ uint8_t BilinearInterpolate(const uint8_t* buf,
   return (r_pos_0 * (255 - data.res_y) + r_pos_1 * data.res_y) >> 8;
 }
 
+// Same as calling BilinearInterpolate() for channels 0 to |kChannels| - 1,
+// but computes the source positions and weights only once.
+template <int kChannels>
+void BilinearInterpolateChannels(const uint8_t* buf,
+                                 const CFX_ImageTransformer::BilinearData& data,
+                                 int bpp,
+                                 uint8_t* channels) {
+  int i_resx = 255 - data.res_x;
+  int i_resy = 255 - data.res_y;
+  const uint8_t* src_pos0 = buf + data.row_offset_l + data.src_col_l * bpp;
+  const uint8_t* src_pos1 = buf + data.row_offset_l + data.src_col_r * bpp;
+  const uint8_t* src_pos2 = buf + data.row_offset_r + data.src_col_l * bpp;
+  const uint8_t* src_pos3 = buf + data.row_offset_r + data.src_col_r * bpp;
+  for (int i = 0; i < kChannels; ++i) {
+    uint8_t r_pos_0 = (src_pos0[i] * i_resx + src_pos1[i] * data.res_x) >> 8;
+    uint8_t r_pos_1 = (src_pos2[i] * i_resx + src_pos3[i] * data.res_x) >> 8;
+    channels[i] = (r_pos_0 * i_resy + r_pos_1 * data.res_y) >> 8;
+  }
+}
+
 class CFX_BilinearMatrix {
  public:
   explicit CFX_BilinearMatrix(const CFX_Matrix& src)
@@ -55,6 +77,41 @@ class CFX_BilinearMatrix {
         e(FXSYS_roundf(src.e * kBase)),
         f(FXSYS_roundf(src.f * kBase)) {}
 
+  // Whether Transform() is exact for all 0 <= |x| < |width| and
+  // 0 <= |y| < |height|, which is the case when every intermediate value fits
+  // in a float mantissa. Then it can instead be done incrementally with
+  // integers using GetRowStart() and StepCol().
+  bool IsExactForSize(int width, int height) const {
+    constexpr int64_t kMaxExact = int64_t{1} << 24;
+    int64_t max_x = std::abs(int64_t{a}) * width +
+                    std::abs(int64_t{c}) * height + std::abs(int64_t{e}) +
+                    kBase / 2;
+    int64_t max_y = std::abs(int64_t{b}) * width +
+                    std::abs(int64_t{d}) * height + std::abs(int64_t{f}) +
+                    kBase / 2;
+    return max_x < kMaxExact && max_y < kMaxExact;
+  }
+
+  // Sets |fixed_x| and |fixed_y| to the fixed-point source position of (0, y).
+  void GetRowStart(int y, int* fixed_x, int* fixed_y) const {
+    *fixed_x = c * y + e + kBase / 2;
+    *fixed_y = d * y + f + kBase / 2;
+  }
+
+  // Advances a fixed-point source position by one column.
+  void StepCol(int* fixed_x, int* fixed_y) const {
+    *fixed_x += a;
+    *fixed_y += b;
+  }
+
+  // Splits a fixed-point position the same way Transform() does.
+  static void Split(int fixed, int* pos, int* res) {
+    *pos = fixed / kBase;
+    *res = fixed % kBase;
+    if (*res < 0)
+      *res += kBase;
+  }
+
   void Transform(int x, int y, int* x1, int* y1, int* res_x, int* res_y) const {
     CFX_PointF val = TransformInternal(CFX_PointF(x, y));
     *x1 = pdfium::base::saturated_cast<int>(val.x / kBase);
@@ -95,6 +152,23 @@ void AdjustCoords(const FX_RECT& clip_rect, int* col, int* row) {
     src_row--;
 }
 
+template <typename F>
+void DoBilinearPixel(const CFX_ImageTransformer::CalcData& calc_data,
+                     const FX_RECT& clip_rect,
+                     CFX_ImageTransformer::BilinearData& d,
+                     uint8_t* dest,
+                     const F& func) {
+  if (LIKELY(InStretchBounds(clip_rect, d.src_col_l, d.src_row_l))) {
+    AdjustCoords(clip_rect, &d.src_col_l, &d.src_row_l);
+    d.src_col_r = d.src_col_l + 1;
+    d.src_row_r = d.src_row_l + 1;
+    AdjustCoords(clip_rect, &d.src_col_r, &d.src_row_r);
+    d.row_offset_l = d.src_row_l * calc_data.pitch;
+    d.row_offset_r = d.src_row_r * calc_data.pitch;
+    func(d, dest);
+  }
+}
+
 // Let the compiler deduce the type for |func|, which cheaper than specifying it
 // with std::function.
 template <typename F>
@@ -104,25 +178,37 @@ void DoBilinearLoop(const CFX_ImageTransformer::CalcData& calc_data,
                     int increment,
                     const F& func) {
   CFX_BilinearMatrix matrix_fix(calc_data.matrix);
-  for (int row = 0; row < result_rect.Height(); row++) {
+  const int width = result_rect.Width();
+  const int height = result_rect.Height();
+  CFX_ImageTransformer::BilinearData d;
+  if (matrix_fix.IsExactForSize(width, height)) {
+    // Step along each row instead of transforming every pixel.
+    for (int row = 0; row < height; row++) {
+      uint8_t* dest = calc_data.bitmap->GetWritableScanline(row);
+      int fixed_x;
+      int fixed_y;
+      matrix_fix.GetRowStart(row, &fixed_x, &fixed_y);
+      for (int col = 0; col < width; col++) {
+        CFX_BilinearMatrix::Split(fixed_x, &d.src_col_l, &d.res_x);
+        CFX_BilinearMatrix::Split(fixed_y, &d.src_row_l, &d.res_y);
+        DoBilinearPixel(calc_data, clip_rect, d, dest, func);
+        matrix_fix.StepCol(&fixed_x, &fixed_y);
+        dest += increment;
+      }
+    }
+    return;
+  }
+
+  for (int row = 0; row < height; row++) {
     uint8_t* dest = calc_data.bitmap->GetWritableScanline(row);
-    for (int col = 0; col < result_rect.Width(); col++) {
-      CFX_ImageTransformer::BilinearData d;
+    for (int col = 0; col < width; col++) {
       d.res_x = 0;
       d.res_y = 0;
       d.src_col_l = 0;
       d.src_row_l = 0;
       matrix_fix.Transform(col, row, &d.src_col_l, &d.src_row_l, &d.res_x,
                            &d.res_y);
-      if (LIKELY(InStretchBounds(clip_rect, d.src_col_l, d.src_row_l))) {
-        AdjustCoords(clip_rect, &d.src_col_l, &d.src_row_l);
-        d.src_col_r = d.src_col_l + 1;
-        d.src_row_r = d.src_row_l + 1;
-        AdjustCoords(clip_rect, &d.src_col_r, &d.src_row_r);
-        d.row_offset_l = d.src_row_l * calc_data.pitch;
-        d.row_offset_r = d.src_row_r * calc_data.pitch;
-        func(d, dest);
-      }
+      DoBilinearPixel(calc_data, clip_rect, d, dest, func);
       dest += increment;
     }
   }
@@ -326,10 +412,10 @@ void CFX_ImageTransformer::CalcColor(const CalcData& calc_data,
   const int destBpp = calc_data.bitmap->GetBPP() / 8;
   if (!m_Storer.GetBitmap()->IsAlphaFormat()) {
     auto func = [&calc_data, Bpp](const BilinearData& data, uint8_t* dest) {
-      uint8_t b = BilinearInterpolate(calc_data.buf, data, Bpp, 0);
-      uint8_t g = BilinearInterpolate(calc_data.buf, data, Bpp, 1);
-      uint8_t r = BilinearInterpolate(calc_data.buf, data, Bpp, 2);
-      *reinterpret_cast<uint32_t*>(dest) = ArgbEncode(kOpaqueAlpha, r, g, b);
+      uint8_t bgr[3];
+      BilinearInterpolateChannels<3>(calc_data.buf, data, Bpp, bgr);
+      *reinterpret_cast<uint32_t*>(dest) =
+          ArgbEncode(kOpaqueAlpha, bgr[2], bgr[1], bgr[0]);
     };
     DoBilinearLoop(calc_data, m_result, m_StretchClip, destBpp, func);
     return;
@@ -337,22 +423,20 @@ void CFX_ImageTransformer::CalcColor(const CalcData& calc_data,
 
   if (format == FXDIB_Format::kArgb) {
     auto func = [&calc_data, Bpp](const BilinearData& data, uint8_t* dest) {
-      uint8_t b = BilinearInterpolate(calc_data.buf, data, Bpp, 0);
-      uint8_t g = BilinearInterpolate(calc_data.buf, data, Bpp, 1);
-      uint8_t r = BilinearInterpolate(calc_data.buf, data, Bpp, 2);
-      uint8_t alpha = BilinearInterpolate(calc_data.buf, data, Bpp, 3);
-      *reinterpret_cast<uint32_t*>(dest) = ArgbEncode(alpha, r, g, b);
+      uint8_t bgra[4];
+      BilinearInterpolateChannels<4>(calc_data.buf, data, Bpp, bgra);
+      *reinterpret_cast<uint32_t*>(dest) =
+          ArgbEncode(bgra[3], bgra[2], bgra[1], bgra[0]);
     };
     DoBilinearLoop(calc_data, m_result, m_StretchClip, destBpp, func);
     return;
   }
 
   auto func = [&calc_data, Bpp](const BilinearData& data, uint8_t* dest) {
-    uint8_t c = BilinearInterpolate(calc_data.buf, data, Bpp, 0);
-    uint8_t m = BilinearInterpolate(calc_data.buf, data, Bpp, 1);
-    uint8_t y = BilinearInterpolate(calc_data.buf, data, Bpp, 2);
-    uint8_t k = BilinearInterpolate(calc_data.buf, data, Bpp, 3);
-    *reinterpret_cast<uint32_t*>(dest) = FXCMYK_TODIB(CmykEncode(c, m, y, k));
+    uint8_t cmyk[4];
+    BilinearInterpolateChannels<4>(calc_data.buf, data, Bpp, cmyk);
+    *reinterpret_cast<uint32_t*>(dest) =
+        FXCMYK_TODIB(CmykEncode(cmyk[0], cmyk[1], cmyk[2], cmyk[3]));
   };
   DoBilinearLoop(calc_data, m_result, m_StretchClip, destBpp, func);
 }
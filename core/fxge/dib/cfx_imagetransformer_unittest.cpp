@@ -0,0 +1,64 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/dib/cfx_imagetransformer.h"
+
+#include <stdint.h>
+
+#include "core/fxcrt/fx_coordinates.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "core/fxge/dib/fx_dib.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr FX_ARGB kColor = 0xff4080c0;
+
+// Transforms a solid |kColor| bitmap rotated by 30 degrees, scaled to |size|
+// and clipped to a 16x16 square at its center, and checks that the result
+// is |kColor| apart from bilinear rounding.
+void CheckRotatedSolidColor(float size) {
+  auto pSrc = pdfium::MakeRetain<CFX_DIBitmap>();
+  ASSERT_TRUE(pSrc->Create(8, 8, FXDIB_Format::kRgb));
+  pSrc->Clear(kColor);
+
+  constexpr float kCos30 = 0.8660254f;
+  constexpr float kSin30 = 0.5f;
+  CFX_Matrix matrix(size * kCos30, size * kSin30, -size * kSin30,
+                    size * kCos30, 0, 0);
+  CFX_PointF center = matrix.Transform(CFX_PointF(0.5f, 0.5f));
+  FX_RECT clip(center.x - 8, center.y - 8, center.x + 8, center.y + 8);
+  CFX_ImageTransformer transformer(pSrc, matrix, FXDIB_ResampleOptions(),
+                                   &clip);
+  transformer.Continue(nullptr);
+  EXPECT_EQ(clip, transformer.result());
+
+  RetainPtr<CFX_DIBitmap> pResult = transformer.DetachBitmap();
+  ASSERT_TRUE(pResult);
+  ASSERT_EQ(FXDIB_Format::kArgb, pResult->GetFormat());
+  ASSERT_EQ(16, pResult->GetWidth());
+  ASSERT_EQ(16, pResult->GetHeight());
+  for (int row = 0; row < pResult->GetHeight(); ++row) {
+    const uint8_t* scan = pResult->GetScanline(row);
+    for (int col = 0; col < pResult->GetWidth(); ++col) {
+      FX_ARGB argb = reinterpret_cast<const uint32_t*>(scan)[col];
+      EXPECT_EQ(0xff, FXARGB_A(argb));
+      EXPECT_NEAR(FXARGB_R(kColor), FXARGB_R(argb), 2);
+      EXPECT_NEAR(FXARGB_G(kColor), FXARGB_G(argb), 2);
+      EXPECT_NEAR(FXARGB_B(kColor), FXARGB_B(argb), 2);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(CFX_ImageTransformer, RotatedSolidColor) {
+  CheckRotatedSolidColor(100);
+}
+
+TEST(CFX_ImageTransformer, RotatedSolidColorLarge) {
+  // Far enough from the image origin that the fixed-point source positions
+  // no longer fit in a float mantissa.
+  CheckRotatedSolidColor(200000);
+}
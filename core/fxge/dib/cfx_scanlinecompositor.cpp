@@ -463,6 +463,41 @@ void CompositeRow_Argb2Argb(uint8_t* dest_scan,
   }
 }
 
+// Same as CompositeRow_Argb2Argb() with BlendMode::kNormal, no clip and no
+// separate alpha channels. Compositing an opaque source pixel gives the source
+// pixel, so runs of them are copied with a single memcpy().
+void CompositeRow_Argb2Argb_NoBlend_NoClip(uint8_t* dest_scan,
+                                           const uint8_t* src_scan,
+                                           int pixel_count) {
+  int col = 0;
+  while (col < pixel_count) {
+    int run_end = col;
+    while (run_end < pixel_count && src_scan[run_end * 4 + 3] == 255)
+      ++run_end;
+    if (run_end > col) {
+      memcpy(dest_scan + col * 4, src_scan + col * 4, (run_end - col) * 4);
+      col = run_end;
+      continue;
+    }
+    const uint8_t* src = src_scan + col * 4;
+    uint8_t* dest = dest_scan + col * 4;
+    uint8_t src_alpha = src[3];
+    uint8_t back_alpha = dest[3];
+    if (back_alpha == 0) {
+      memcpy(dest, src, 4);
+    } else if (src_alpha != 0) {
+      uint8_t dest_alpha =
+          back_alpha + src_alpha - back_alpha * src_alpha / 255;
+      int alpha_ratio = src_alpha * 255 / dest_alpha;
+      dest[0] = FXDIB_ALPHA_MERGE(dest[0], src[0], alpha_ratio);
+      dest[1] = FXDIB_ALPHA_MERGE(dest[1], src[1], alpha_ratio);
+      dest[2] = FXDIB_ALPHA_MERGE(dest[2], src[2], alpha_ratio);
+      dest[3] = dest_alpha;
+    }
+    ++col;
+  }
+}
+
 void CompositeRow_Rgb2Argb_Blend_NoClip(uint8_t* dest_scan,
                                         const uint8_t* src_scan,
                                         int width,
@@ -1559,6 +1594,38 @@ void CompositeRow_ByteMask2Argb(uint8_t* dest_scan,
   }
 }
 
+// Same as CompositeRow_ByteMask2Argb() with BlendMode::kNormal and no clip.
+void CompositeRow_ByteMask2Argb_NoBlend_NoClip(uint8_t* dest_scan,
+                                               const uint8_t* src_scan,
+                                               int mask_alpha,
+                                               int src_r,
+                                               int src_g,
+                                               int src_b,
+                                               int pixel_count) {
+  const FX_ARGB opaque_argb = ArgbEncode(255, src_r, src_g, src_b);
+  for (int col = 0; col < pixel_count; ++col, dest_scan += 4) {
+    int src_alpha = mask_alpha * src_scan[col] / 255;
+    if (src_alpha == 255) {
+      FXARGB_SETDIB(dest_scan, opaque_argb);
+      continue;
+    }
+    uint8_t back_alpha = dest_scan[3];
+    if (back_alpha == 0) {
+      FXARGB_SETDIB(dest_scan, ArgbEncode(src_alpha, src_r, src_g, src_b));
+      continue;
+    }
+    if (src_alpha == 0)
+      continue;
+
+    uint8_t dest_alpha = back_alpha + src_alpha - back_alpha * src_alpha / 255;
+    int alpha_ratio = src_alpha * 255 / dest_alpha;
+    dest_scan[0] = FXDIB_ALPHA_MERGE(dest_scan[0], src_b, alpha_ratio);
+    dest_scan[1] = FXDIB_ALPHA_MERGE(dest_scan[1], src_g, alpha_ratio);
+    dest_scan[2] = FXDIB_ALPHA_MERGE(dest_scan[2], src_r, alpha_ratio);
+    dest_scan[3] = dest_alpha;
+  }
+}
+
 void CompositeRow_ByteMask2Rgb(uint8_t* dest_scan,
                                const uint8_t* src_scan,
                                int mask_alpha,
@@ -1606,6 +1673,32 @@ void CompositeRow_ByteMask2Rgb(uint8_t* dest_scan,
   }
 }
 
+// Same as CompositeRow_ByteMask2Rgb() with BlendMode::kNormal and no clip.
+void CompositeRow_ByteMask2Rgb_NoBlend_NoClip(uint8_t* dest_scan,
+                                              const uint8_t* src_scan,
+                                              int mask_alpha,
+                                              int src_r,
+                                              int src_g,
+                                              int src_b,
+                                              int pixel_count,
+                                              int Bpp) {
+  for (int col = 0; col < pixel_count; ++col, dest_scan += Bpp) {
+    int src_alpha = mask_alpha * src_scan[col] / 255;
+    if (src_alpha == 0)
+      continue;
+
+    if (src_alpha == 255) {
+      dest_scan[0] = src_b;
+      dest_scan[1] = src_g;
+      dest_scan[2] = src_r;
+      continue;
+    }
+    dest_scan[0] = FXDIB_ALPHA_MERGE(dest_scan[0], src_b, src_alpha);
+    dest_scan[1] = FXDIB_ALPHA_MERGE(dest_scan[1], src_g, src_alpha);
+    dest_scan[2] = FXDIB_ALPHA_MERGE(dest_scan[2], src_r, src_alpha);
+  }
+}
+
 void CompositeRow_ByteMask2Mask(uint8_t* dest_scan,
                                 const uint8_t* src_scan,
                                 int mask_alpha,
@@ -2870,6 +2963,11 @@ void CFX_ScanlineCompositor::CompositeRgbBitmapLine(
       case 4:
       case 8:
       case 4 + 8: {
+        if (m_BlendType == BlendMode::kNormal && !clip_scan &&
+            !dst_extra_alpha && !src_extra_alpha) {
+          CompositeRow_Argb2Argb_NoBlend_NoClip(dest_scan, src_scan, width);
+          break;
+        }
         CompositeRow_Argb2Argb(dest_scan, src_scan, width, m_BlendType,
                                clip_scan, dst_extra_alpha, src_extra_alpha);
       } break;
@@ -3047,14 +3145,26 @@ void CFX_ScanlineCompositor::CompositeByteMaskLine(uint8_t* dest_scan,
           width, m_BlendType, GetCompsFromFormat(m_DestFormat), clip_scan);
     }
   } else if (m_DestFormat == FXDIB_Format::kArgb) {
-    CompositeRow_ByteMask2Argb(dest_scan, src_scan, m_MaskAlpha, m_MaskRed,
-                               m_MaskGreen, m_MaskBlue, width, m_BlendType,
-                               clip_scan);
+    if (m_BlendType == BlendMode::kNormal && !clip_scan) {
+      CompositeRow_ByteMask2Argb_NoBlend_NoClip(dest_scan, src_scan,
+                                                m_MaskAlpha, m_MaskRed,
+                                                m_MaskGreen, m_MaskBlue, width);
+    } else {
+      CompositeRow_ByteMask2Argb(dest_scan, src_scan, m_MaskAlpha, m_MaskRed,
+                                 m_MaskGreen, m_MaskBlue, width, m_BlendType,
+                                 clip_scan);
+    }
   } else if (m_DestFormat == FXDIB_Format::kRgb ||
              m_DestFormat == FXDIB_Format::kRgb32) {
-    CompositeRow_ByteMask2Rgb(dest_scan, src_scan, m_MaskAlpha, m_MaskRed,
-                              m_MaskGreen, m_MaskBlue, width, m_BlendType,
-                              GetCompsFromFormat(m_DestFormat), clip_scan);
+    if (m_BlendType == BlendMode::kNormal && !clip_scan) {
+      CompositeRow_ByteMask2Rgb_NoBlend_NoClip(
+          dest_scan, src_scan, m_MaskAlpha, m_MaskRed, m_MaskGreen, m_MaskBlue,
+          width, GetCompsFromFormat(m_DestFormat));
+    } else {
+      CompositeRow_ByteMask2Rgb(dest_scan, src_scan, m_MaskAlpha, m_MaskRed,
+                                m_MaskGreen, m_MaskBlue, width, m_BlendType,
+                                GetCompsFromFormat(m_DestFormat), clip_scan);
+    }
   }
 }
 
@@ -0,0 +1,100 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/dib/cfx_scanlinecompositor.h"
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr int kWidth = 97;
+
+// Mixes runs of transparent, opaque and partially transparent values, which
+// the unclipped normal blend paths handle separately.
+std::vector<uint8_t> MakeScanline(size_t size, uint32_t seed) {
+  std::vector<uint8_t> result(size);
+  for (size_t i = 0; i < size; ++i) {
+    seed = seed * 1103515245 + 12345;
+    uint8_t value = seed >> 16;
+    switch ((i / 24) % 4) {
+      case 0:
+        result[i] = value & 1 ? 255 : value;
+        break;
+      case 1:
+        result[i] = 255;
+        break;
+      case 2:
+        result[i] = value & 1 ? 0 : value;
+        break;
+      default:
+        result[i] = value;
+        break;
+    }
+  }
+  return result;
+}
+
+// Compositing without a clip must give the same result as compositing with a
+// clip that lets everything through, which takes the general code path.
+void CheckRgbBitmapLine(FXDIB_Format dest_format, FXDIB_Format src_format) {
+  const int dest_Bpp = GetCompsFromFormat(dest_format);
+  const int src_Bpp = GetCompsFromFormat(src_format);
+  const std::vector<uint8_t> src = MakeScanline(kWidth * src_Bpp, 1);
+  const std::vector<uint8_t> clip(kWidth, 255);
+  for (uint32_t seed : {2, 3}) {
+    std::vector<uint8_t> dest = MakeScanline(kWidth * dest_Bpp, seed);
+    std::vector<uint8_t> expected = dest;
+
+    CFX_ScanlineCompositor compositor;
+    ASSERT_TRUE(compositor.Init(dest_format, src_format, kWidth, {}, 0,
+                                BlendMode::kNormal, false, false));
+    compositor.CompositeRgbBitmapLine(dest.data(), src.data(), kWidth, nullptr,
+                                      nullptr, nullptr);
+
+    CFX_ScanlineCompositor clipped;
+    ASSERT_TRUE(clipped.Init(dest_format, src_format, kWidth, {}, 0,
+                             BlendMode::kNormal, true, false));
+    clipped.CompositeRgbBitmapLine(expected.data(), src.data(), kWidth,
+                                   clip.data(), nullptr, nullptr);
+    EXPECT_EQ(expected, dest);
+  }
+}
+
+void CheckByteMaskLine(FXDIB_Format dest_format, uint32_t mask_color) {
+  const int dest_Bpp = GetCompsFromFormat(dest_format);
+  const std::vector<uint8_t> src = MakeScanline(kWidth, 4);
+  const std::vector<uint8_t> clip(kWidth, 255);
+  for (uint32_t seed : {5, 6}) {
+    std::vector<uint8_t> dest = MakeScanline(kWidth * dest_Bpp, seed);
+    std::vector<uint8_t> expected = dest;
+
+    CFX_ScanlineCompositor compositor;
+    ASSERT_TRUE(compositor.Init(dest_format, FXDIB_Format::k8bppMask, kWidth,
+                                {}, mask_color, BlendMode::kNormal, false,
+                                false));
+    compositor.CompositeByteMaskLine(dest.data(), src.data(), kWidth, nullptr,
+                                     nullptr);
+    compositor.CompositeByteMaskLine(expected.data(), src.data(), kWidth,
+                                     clip.data(), nullptr);
+    EXPECT_EQ(expected, dest);
+  }
+}
+
+}  // namespace
+
+TEST(CFX_ScanlineCompositor, ArgbToArgbNormal) {
+  CheckRgbBitmapLine(FXDIB_Format::kArgb, FXDIB_Format::kArgb);
+}
+
+TEST(CFX_ScanlineCompositor, ByteMaskNormal) {
+  for (uint32_t mask_color : {0xff102030u, 0x80405060u, 0x00ffffffu}) {
+    CheckByteMaskLine(FXDIB_Format::kArgb, mask_color);
+    CheckByteMaskLine(FXDIB_Format::kRgb, mask_color);
+    CheckByteMaskLine(FXDIB_Format::kRgb32, mask_color);
+  }
+}
@@ -10,6 +10,9 @@
 #include <math.h>
 
 #include <algorithm>
+#include <list>
+#include <mutex>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -22,6 +25,8 @@
 #include "core/fxge/dib/scanlinecomposer_iface.h"
 #include "third_party/base/check.h"
 #include "third_party/base/cxx17_backports.h"
+#include "third_party/base/no_destructor.h"
+#include "third_party/base/notreached.h"
 
 static_assert(
     std::is_trivially_destructible<CStretchEngine::PixelWeight>::value,
@@ -29,6 +34,25 @@ static_assert(
 
 namespace {
 
+// Larger tables are for huge destinations, which are not worth keeping.
+constexpr size_t kMaxSharedWeightTableBytes = 1024 * 1024;
+constexpr size_t kMaxSharedWeightTables = 8;
+
+using WeightTableKey = std::tuple<int, int, int, int, int, int, bool, bool>;
+
+struct SharedWeightTables {
+  std::mutex lock;
+  // Most recently used first.
+  std::list<std::pair<WeightTableKey,
+                      std::shared_ptr<const CStretchEngine::WeightTable>>>
+      entries;
+};
+
+SharedWeightTables* GetSharedWeightTables() {
+  static pdfium::base::NoDestructor<SharedWeightTables> s;
+  return s.get();
+}
+
 int GetPitchRoundUpTo4Bytes(int bits_per_pixel) {
   return (bits_per_pixel + 31) / 32 * 4;
 }
@@ -48,6 +72,46 @@ size_t CStretchEngine::PixelWeight::TotalBytesForWeightCount(
   return total_bytes.ValueOrDie();
 }
 
+// static
+std::shared_ptr<const CStretchEngine::WeightTable>
+CStretchEngine::WeightTable::GetShared(int dest_len,
+                                       int dest_min,
+                                       int dest_max,
+                                       int src_len,
+                                       int src_min,
+                                       int src_max,
+                                       const FXDIB_ResampleOptions& options) {
+  // CalculateWeights() only looks at these options.
+  const WeightTableKey key(dest_len, dest_min, dest_max, src_len, src_min,
+                           src_max, options.bNoSmoothing,
+                           options.bInterpolateBilinear);
+  SharedWeightTables* shared = GetSharedWeightTables();
+  {
+    std::lock_guard<std::mutex> lock(shared->lock);
+    auto it = std::find_if(shared->entries.begin(), shared->entries.end(),
+                           [&key](const auto& entry) {
+                             return entry.first == key;
+                           });
+    if (it != shared->entries.end()) {
+      shared->entries.splice(shared->entries.begin(), shared->entries, it);
+      return it->second;
+    }
+  }
+
+  auto table = std::make_shared<WeightTable>();
+  if (!table->CalculateWeights(dest_len, dest_min, dest_max, src_len, src_min,
+                               src_max, options)) {
+    return nullptr;
+  }
+  if (table->GetSizeBytes() <= kMaxSharedWeightTableBytes) {
+    std::lock_guard<std::mutex> lock(shared->lock);
+    shared->entries.emplace_front(key, table);
+    if (shared->entries.size() > kMaxSharedWeightTables)
+      shared->entries.pop_back();
+  }
+  return table;
+}
+
 CStretchEngine::WeightTable::WeightTable() = default;
 
 CStretchEngine::WeightTable::~WeightTable() = default;
@@ -278,11 +342,12 @@ bool CStretchEngine::StartStretchHorz() {
     m_ExtraAlphaBuf.resize(m_SrcClip.Height(), m_ExtraMaskPitch);
     m_DestMaskScanline.resize(m_ExtraMaskPitch);
   }
-  if (!m_WeightTable.CalculateWeights(
-          m_DestWidth, m_DestClip.left, m_DestClip.right, m_SrcWidth,
-          m_SrcClip.left, m_SrcClip.right, m_ResampleOptions)) {
+  m_pWeightTable = WeightTable::GetShared(
+      m_DestWidth, m_DestClip.left, m_DestClip.right, m_SrcWidth,
+      m_SrcClip.left, m_SrcClip.right, m_ResampleOptions);
+  if (!m_pWeightTable)
     return false;
-  }
+
   m_CurRow = m_SrcClip.top;
   m_State = State::kHorizontal;
   return true;
@@ -320,7 +385,7 @@ bool CStretchEngine::ContinueStretchHorz(PauseIndicatorIface* pPause) {
       case TransformMethod::k1BppTo8Bpp:
       case TransformMethod::k1BppToManyBpp: {
         for (int col = m_DestClip.left; col < m_DestClip.right; ++col) {
-          PixelWeight* pWeights = m_WeightTable.GetPixelWeight(col);
+          const PixelWeight* pWeights = m_pWeightTable->GetPixelWeight(col);
           uint32_t dest_a = 0;
           for (int j = pWeights->m_SrcStart; j <= pWeights->m_SrcEnd; ++j) {
             uint32_t pixel_weight = pWeights->GetWeightForPosition(j);
@@ -333,19 +398,19 @@ bool CStretchEngine::ContinueStretchHorz(PauseIndicatorIface* pPause) {
       }
       case TransformMethod::k8BppTo8Bpp: {
         for (int col = m_DestClip.left; col < m_DestClip.right; ++col) {
-          PixelWeight* pWeights = m_WeightTable.GetPixelWeight(col);
+          const PixelWeight* pWeights = m_pWeightTable->GetPixelWeight(col);
+          const uint8_t* src_pixel = src_scan + pWeights->m_SrcStart;
+          const int count = pWeights->m_SrcEnd - pWeights->m_SrcStart + 1;
           uint32_t dest_a = 0;
-          for (int j = pWeights->m_SrcStart; j <= pWeights->m_SrcEnd; ++j) {
-            uint32_t pixel_weight = pWeights->GetWeightForPosition(j);
-            dest_a += pixel_weight * src_scan[j];
-          }
+          for (int i = 0; i < count; ++i)
+            dest_a += pWeights->m_Weights[i] * src_pixel[i];
           *dest_scan++ = PixelFromFixed(dest_a);
         }
         break;
       }
       case TransformMethod::k8BppTo8BppWithAlpha: {
         for (int col = m_DestClip.left; col < m_DestClip.right; ++col) {
-          PixelWeight* pWeights = m_WeightTable.GetPixelWeight(col);
+          const PixelWeight* pWeights = m_pWeightTable->GetPixelWeight(col);
           uint32_t dest_a = 0;
           uint32_t dest_r = 0;
           for (int j = pWeights->m_SrcStart; j <= pWeights->m_SrcEnd; ++j) {
@@ -361,7 +426,7 @@ bool CStretchEngine::ContinueStretchHorz(PauseIndicatorIface* pPause) {
       }
       case TransformMethod::k8BppToManyBpp: {
         for (int col = m_DestClip.left; col < m_DestClip.right; ++col) {
-          PixelWeight* pWeights = m_WeightTable.GetPixelWeight(col);
+          const PixelWeight* pWeights = m_pWeightTable->GetPixelWeight(col);
           uint32_t dest_r = 0;
           uint32_t dest_g = 0;
           uint32_t dest_b = 0;
@@ -386,7 +451,7 @@ bool CStretchEngine::ContinueStretchHorz(PauseIndicatorIface* pPause) {
       }
       case TransformMethod::k8BppToManyBppWithAlpha: {
         for (int col = m_DestClip.left; col < m_DestClip.right; ++col) {
-          PixelWeight* pWeights = m_WeightTable.GetPixelWeight(col);
+          const PixelWeight* pWeights = m_pWeightTable->GetPixelWeight(col);
           uint32_t dest_a = 0;
           uint32_t dest_r = 0;
           uint32_t dest_g = 0;
@@ -409,16 +474,17 @@ bool CStretchEngine::ContinueStretchHorz(PauseIndicatorIface* pPause) {
       }
       case TransformMethod::kManyBpptoManyBpp: {
         for (int col = m_DestClip.left; col < m_DestClip.right; ++col) {
-          PixelWeight* pWeights = m_WeightTable.GetPixelWeight(col);
+          const PixelWeight* pWeights = m_pWeightTable->GetPixelWeight(col);
+          const uint8_t* src_pixel = src_scan + pWeights->m_SrcStart * Bpp;
+          const int count = pWeights->m_SrcEnd - pWeights->m_SrcStart + 1;
           uint32_t dest_r = 0;
           uint32_t dest_g = 0;
           uint32_t dest_b = 0;
-          for (int j = pWeights->m_SrcStart; j <= pWeights->m_SrcEnd; ++j) {
-            uint32_t pixel_weight = pWeights->GetWeightForPosition(j);
-            const uint8_t* src_pixel = src_scan + j * Bpp;
-            dest_b += pixel_weight * (*src_pixel++);
-            dest_g += pixel_weight * (*src_pixel++);
-            dest_r += pixel_weight * (*src_pixel);
+          for (int i = 0; i < count; ++i, src_pixel += Bpp) {
+            uint32_t pixel_weight = pWeights->m_Weights[i];
+            dest_b += pixel_weight * src_pixel[0];
+            dest_g += pixel_weight * src_pixel[1];
+            dest_r += pixel_weight * src_pixel[2];
           }
           *dest_scan++ = PixelFromFixed(dest_b);
           *dest_scan++ = PixelFromFixed(dest_g);
@@ -429,7 +495,7 @@ bool CStretchEngine::ContinueStretchHorz(PauseIndicatorIface* pPause) {
       }
       case TransformMethod::kManyBpptoManyBppWithAlpha: {
         for (int col = m_DestClip.left; col < m_DestClip.right; ++col) {
-          PixelWeight* pWeights = m_WeightTable.GetPixelWeight(col);
+          const PixelWeight* pWeights = m_pWeightTable->GetPixelWeight(col);
           uint32_t dest_a = 0;
           uint32_t dest_r = 0;
           uint32_t dest_g = 0;
@@ -468,22 +534,64 @@ void CStretchEngine::StretchVert() {
   if (m_DestHeight == 0)
     return;
 
-  WeightTable table;
-  if (!table.CalculateWeights(m_DestHeight, m_DestClip.top, m_DestClip.bottom,
-                              m_SrcHeight, m_SrcClip.top, m_SrcClip.bottom,
-                              m_ResampleOptions)) {
+  std::shared_ptr<const WeightTable> table = WeightTable::GetShared(
+      m_DestHeight, m_DestClip.top, m_DestClip.bottom, m_SrcHeight,
+      m_SrcClip.top, m_SrcClip.bottom, m_ResampleOptions);
+  if (!table)
     return;
-  }
 
   const int DestBpp = m_DestBpp / 8;
+
+  // Without alpha, every byte of an intermediate row is filtered the same
+  // way, so whole rows are accumulated at once. This walks the intermediate
+  // buffer in memory order instead of one column at a time.
+  const bool filter_rows = m_TransMethod == TransformMethod::k1BppTo8Bpp ||
+                           m_TransMethod == TransformMethod::k8BppTo8Bpp ||
+                           m_TransMethod == TransformMethod::k8BppToManyBpp ||
+                           m_TransMethod == TransformMethod::kManyBpptoManyBpp;
+  const size_t row_bytes = m_DestClip.Width() * DestBpp;
+  std::vector<uint32_t, FxAllocAllocator<uint32_t>> row_sums;
+  if (filter_rows)
+    row_sums.resize(row_bytes);
+
   for (int row = m_DestClip.top; row < m_DestClip.bottom; ++row) {
     unsigned char* dest_scan = m_DestScanline.data();
     unsigned char* dest_scan_mask = m_DestMaskScanline.data();
-    PixelWeight* pWeights = table.GetPixelWeight(row);
+    const PixelWeight* pWeights = table->GetPixelWeight(row);
+    if (filter_rows) {
+      std::fill(row_sums.begin(), row_sums.end(), 0);
+      for (int j = pWeights->m_SrcStart; j <= pWeights->m_SrcEnd; ++j) {
+        const uint32_t pixel_weight = pWeights->GetWeightForPosition(j);
+        const uint8_t* src_scan =
+            m_InterBuf.data() + (j - m_SrcClip.top) * m_InterPitch;
+        for (size_t i = 0; i < row_bytes; ++i)
+          row_sums[i] += pixel_weight * src_scan[i];
+      }
+      if (DestBpp == 1) {
+        for (size_t i = 0; i < row_bytes; ++i)
+          dest_scan[i] = PixelFromFixed(row_sums[i]);
+      } else {
+        for (size_t i = 0; i < row_bytes; i += DestBpp) {
+          dest_scan[i] = PixelFromFixed(row_sums[i]);
+          dest_scan[i + 1] = PixelFromFixed(row_sums[i + 1]);
+          dest_scan[i + 2] = PixelFromFixed(row_sums[i + 2]);
+        }
+      }
+      m_pDestBitmap->ComposeScanline(row - m_DestClip.top,
+                                     m_DestScanline.data(),
+                                     m_DestMaskScanline.data());
+      continue;
+    }
+
     switch (m_TransMethod) {
       case TransformMethod::k1BppTo8Bpp:
-      case TransformMethod::k1BppToManyBpp:
-      case TransformMethod::k8BppTo8Bpp: {
+      case TransformMethod::k8BppTo8Bpp:
+      case TransformMethod::k8BppToManyBpp:
+      case TransformMethod::kManyBpptoManyBpp:
+        // Handled by |filter_rows| above.
+        NOTREACHED();
+        break;
+      case TransformMethod::k1BppToManyBpp: {
         for (int col = m_DestClip.left; col < m_DestClip.right; ++col) {
           unsigned char* src_scan =
               m_InterBuf.data() + (col - m_DestClip.left) * DestBpp;
@@ -519,29 +627,6 @@ void CStretchEngine::StretchVert() {
         }
         break;
       }
-      case TransformMethod::k8BppToManyBpp:
-      case TransformMethod::kManyBpptoManyBpp: {
-        for (int col = m_DestClip.left; col < m_DestClip.right; ++col) {
-          unsigned char* src_scan =
-              m_InterBuf.data() + (col - m_DestClip.left) * DestBpp;
-          uint32_t dest_r = 0;
-          uint32_t dest_g = 0;
-          uint32_t dest_b = 0;
-          for (int j = pWeights->m_SrcStart; j <= pWeights->m_SrcEnd; ++j) {
-            uint32_t pixel_weight = pWeights->GetWeightForPosition(j);
-            const uint8_t* src_pixel =
-                src_scan + (j - m_SrcClip.top) * m_InterPitch;
-            dest_b += pixel_weight * (*src_pixel++);
-            dest_g += pixel_weight * (*src_pixel++);
-            dest_r += pixel_weight * (*src_pixel);
-          }
-          dest_scan[0] = PixelFromFixed(dest_b);
-          dest_scan[1] = PixelFromFixed(dest_g);
-          dest_scan[2] = PixelFromFixed(dest_r);
-          dest_scan += DestBpp;
-        }
-        break;
-      }
       case TransformMethod::k8BppToManyBppWithAlpha:
       case TransformMethod::kManyBpptoManyBppWithAlpha: {
         for (int col = m_DestClip.left; col < m_DestClip.right; ++col) {
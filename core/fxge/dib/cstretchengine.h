@@ -7,6 +7,7 @@
 #ifndef CORE_FXGE_DIB_CSTRETCHENGINE_H_
 #define CORE_FXGE_DIB_CSTRETCHENGINE_H_
 
+#include <memory>
 #include <vector>
 
 #include "core/fxcrt/fx_coordinates.h"
@@ -75,6 +76,19 @@ class CStretchEngine {
 
   class WeightTable {
    public:
+    // Returns a table calculated with CalculateWeights(), or nullptr if that
+    // fails. Tables depend only on the arguments, so recently used small
+    // tables are shared between callers passing the same arguments, e.g.
+    // when the same image is drawn again at the same size.
+    static std::shared_ptr<const WeightTable> GetShared(
+        int dest_len,
+        int dest_min,
+        int dest_max,
+        int src_len,
+        int src_min,
+        int src_max,
+        const FXDIB_ResampleOptions& options);
+
     WeightTable();
     ~WeightTable();
 
@@ -94,6 +108,8 @@ class CStretchEngine {
           static_cast<const WeightTable*>(this)->GetPixelWeight(pixel));
     }
 
+    size_t GetSizeBytes() const { return m_WeightTablesSizeBytes; }
+
    private:
     int m_DestMin = 0;
     size_t m_ItemSizeBytes = 0;
@@ -156,7 +172,7 @@ class CStretchEngine {
   TransformMethod m_TransMethod;
   State m_State = State::kInitial;
   int m_CurRow;
-  WeightTable m_WeightTable;
+  std::shared_ptr<const WeightTable> m_pWeightTable;
 };
 
 #endif  // CORE_FXGE_DIB_CSTRETCHENGINE_H_
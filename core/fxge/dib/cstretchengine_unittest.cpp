@@ -151,3 +151,26 @@ TEST(CStretchEngine, TooManyWeights) {
                                       kTooBigSrcLen, 0, kTooBigSrcLen,
                                       options));
 }
+
+TEST(CStretchEngine, SharedWeightTables) {
+  FXDIB_ResampleOptions options;
+  std::shared_ptr<const CStretchEngine::WeightTable> table =
+      CStretchEngine::WeightTable::GetShared(100, 0, 100, 300, 0, 300,
+                                             options);
+  ASSERT_TRUE(table);
+  EXPECT_EQ(table, CStretchEngine::WeightTable::GetShared(100, 0, 100, 300, 0,
+                                                          300, options));
+  EXPECT_NE(table, CStretchEngine::WeightTable::GetShared(100, 0, 50, 300, 0,
+                                                          300, options));
+
+  // Options that CalculateWeights() ignores still share the table.
+  options.bLossy = true;
+  EXPECT_EQ(table, CStretchEngine::WeightTable::GetShared(100, 0, 100, 300, 0,
+                                                          300, options));
+  options.bNoSmoothing = true;
+  EXPECT_NE(table, CStretchEngine::WeightTable::GetShared(100, 0, 100, 300, 0,
+                                                          300, options));
+
+  EXPECT_FALSE(CStretchEngine::WeightTable::GetShared(100, 50, 0, 300, 0, 300,
+                                                      options));
+}
@@ -72,6 +72,13 @@ bool RenderDeviceDriverIface::DrawShading(const CPDF_ShadingPattern* pPattern,
   return false;
 }
 
+bool RenderDeviceDriverIface::DrawGlyphRun(
+    pdfium::span<const TextGlyphPos> glyphs,
+    const FX_RECT& bbox,
+    uint32_t color) {
+  return false;
+}
+
 #if defined(_SKIA_SUPPORT_)
 bool RenderDeviceDriverIface::SetBitsWithMask(
     const RetainPtr<CFX_DIBBase>& pBitmap,
@@ -14,6 +14,7 @@
 #include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxge/dib/fx_dib.h"
+#include "third_party/base/span.h"
 
 class CFX_DIBBase;
 class CFX_DIBitmap;
@@ -25,6 +26,7 @@ class CFX_Path;
 class CPDF_ShadingPattern;
 class PauseIndicatorIface;
 class TextCharPos;
+class TextGlyphPos;
 struct CFX_FillRenderOptions;
 struct CFX_TextRenderOptions;
 struct FX_RECT;
@@ -108,6 +110,12 @@ class RenderDeviceDriverIface {
                            const FX_RECT& clip_rect,
                            int alpha,
                            bool bAlphaMode);
+  // Composites the 8-bit coverage bitmaps of |glyphs| onto the device with
+  // |color|, clipped to |bbox|. Returns false without drawing anything if the
+  // driver cannot, in which case the caller has to draw the glyphs itself.
+  virtual bool DrawGlyphRun(pdfium::span<const TextGlyphPos> glyphs,
+                            const FX_RECT& bbox,
+                            uint32_t color);
 #if defined(_SKIA_SUPPORT_)
   virtual bool SetBitsWithMask(const RetainPtr<CFX_DIBBase>& pBitmap,
                                const RetainPtr<CFX_DIBBase>& pMask,
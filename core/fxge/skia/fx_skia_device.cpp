@@ -2764,6 +2764,13 @@ bool CFX_DefaultRenderDevice::Attach(
   return true;
 }
 
+bool CFX_DefaultRenderDevice::AttachToRect(
+    const RetainPtr<CFX_DIBitmap>& pBitmap,
+    bool bRgbByteOrder,
+    const FX_RECT& rect) {
+  return Attach(pBitmap, bRgbByteOrder, nullptr, false) && SetClip_Rect(rect);
+}
+
 #if defined(_SKIA_SUPPORT_)
 bool CFX_DefaultRenderDevice::AttachRecorder(SkPictureRecorder* recorder) {
   if (!recorder)
@@ -15,6 +15,7 @@
 #include "core/fpdfdoc/cpdf_annotlist.h"
 #include "core/fpdfdoc/cpdf_interactiveform.h"
 #include "core/fxcrt/autorestorer.h"
+#include "core/fxge/cfx_renderdevice.h"
 #include "fpdfsdk/cpdfsdk_annot.h"
 #include "fpdfsdk/cpdfsdk_annotiteration.h"
 #include "fpdfsdk/cpdfsdk_formfillenvironment.h"
@@ -81,11 +82,22 @@ void CPDFSDK_PageView::PageView_OnDraw(CFX_RenderDevice* pDevice,
 #endif  // PDF_ENABLE_XFA
 
   // for pdf/static xfa.
+  CPDFSDK_AnnotHandlerMgr* pAnnotHandlerMgr =
+      m_pFormFillEnv->GetAnnotHandlerMgr();
+  const FX_RECT& clip_box = pDevice->GetClipBox();
   CPDFSDK_AnnotIteration annotIteration(this, true);
   for (const auto& pSDKAnnot : annotIteration) {
-    m_pFormFillEnv->GetAnnotHandlerMgr()->Annot_OnDraw(
-        this, pSDKAnnot.Get(), pDevice, mtUser2Device,
-        pOptions->GetDrawAnnots());
+    // Skip annotations outside the clip, as when redrawing a dirty rect.
+    CFX_FloatRect device_rect = mtUser2Device.TransformRect(
+        pAnnotHandlerMgr->Annot_OnGetViewBBox(this, pSDKAnnot.Get()));
+    device_rect.Inflate(1.0f, 1.0f);
+    FX_RECT annot_box = device_rect.GetOuterRect();
+    annot_box.Intersect(clip_box);
+    if (annot_box.IsEmpty())
+      continue;
+
+    pAnnotHandlerMgr->Annot_OnDraw(this, pSDKAnnot.Get(), pDevice,
+                                   mtUser2Device, pOptions->GetDrawAnnots());
   }
 }
 
@@ -9,6 +9,10 @@
 #include <memory>
 #include <utility>
 
+#include "core/fpdfapi/page/cpdf_dib.h"
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/render/cpdf_displaylist.h"
 #include "core/fpdfapi/render/cpdf_pagerendercache.h"
 #include "core/fpdfapi/render/cpdf_pagerendercontext.h"
 #include "core/fpdfapi/render/cpdf_progressiverenderer.h"
@@ -20,6 +24,56 @@
 
 namespace {
 
+// Returns the cached display list of |pPage|, building it first if needed,
+// or nullptr if no list could be built.
+const CPDF_DisplayList* GetDisplayList(CPDF_PageRenderContext* pContext,
+                                       CPDF_Page* pPage,
+                                       int flags) {
+  auto* pCache = static_cast<CPDF_PageRenderCache*>(pPage->GetRenderCache());
+  if (!pCache)
+    return nullptr;
+
+  CPDF_DisplayList* pList = pCache->GetDisplayList(flags);
+  if (pList && pList->IsValidFor(pPage))
+    return pList;
+
+  pCache->SetDisplayList(
+      flags, CPDF_DisplayList::Build(pContext->m_pContext.get(),
+                                     pContext->m_pDevice.get(), pPage,
+                                     *pContext->m_pOptions));
+  return pCache->GetDisplayList(flags);
+}
+
+// Draws the embedded /Thumb image of |pPage| in place of its contents.
+// Returns false if there is none, if it is much smaller than the output, or
+// if the page is not displayed upright.
+bool RenderEmbeddedThumbnail(CPDF_PageRenderContext* pContext,
+                             CPDF_Page* pPage,
+                             const CFX_Matrix& matrix) {
+  if (matrix.b != 0 || matrix.c != 0 || matrix.a <= 0 || matrix.d >= 0)
+    return false;
+
+  const CPDF_Stream* pThumb = pPage->GetDict()->GetStreamFor("Thumb");
+  if (!pThumb)
+    return false;
+
+  auto pSource = pdfium::MakeRetain<CPDF_DIB>();
+  if (pSource->StartLoadDIBBase(pPage->GetDocument(), pThumb, false, nullptr,
+                                pPage->GetPageResources(), false,
+                                CPDF_ColorSpace::Family::kUnknown,
+                                false) != CPDF_DIB::LoadState::kSuccess) {
+    return false;
+  }
+
+  const FX_RECT rect = matrix.TransformRect(pPage->GetBBox()).GetOuterRect();
+  if (pSource->GetWidth() * 2 < rect.Width() ||
+      pSource->GetHeight() * 2 < rect.Height()) {
+    return false;
+  }
+  return pContext->m_pDevice->StretchDIBits(pSource, rect.left, rect.top,
+                                            rect.Width(), rect.Height());
+}
+
 void RenderPageImpl(CPDF_PageRenderContext* pContext,
                     CPDF_Page* pPage,
                     const CFX_Matrix& matrix,
@@ -39,6 +93,8 @@ void RenderPageImpl(CPDF_PageRenderContext* pContext,
   options.bNoTextSmooth = !!(flags & FPDF_RENDER_NO_SMOOTHTEXT);
   options.bNoImageSmooth = !!(flags & FPDF_RENDER_NO_SMOOTHIMAGE);
   options.bNoPathSmooth = !!(flags & FPDF_RENDER_NO_SMOOTHPATH);
+  options.bCacheForms = !!(flags & FPDF_RENDER_CACHE_FORMS);
+  options.bThumbnail = !!(flags & FPDF_RENDER_THUMBNAIL);
 
   // Grayscale output
   if (flags & FPDF_GRAYSCALE)
@@ -62,9 +118,19 @@ void RenderPageImpl(CPDF_PageRenderContext* pContext,
       pPage->GetDocument(), pPage->GetPageResources(),
       static_cast<CPDF_PageRenderCache*>(pPage->GetRenderCache()));
 
-  pContext->m_pContext->AppendLayer(pPage, matrix);
+  // An embedded thumbnail stands for the whole page, annotations included.
+  const bool bEmbeddedThumbnail =
+      (flags & FPDF_RENDER_THUMBNAIL) && !color_scheme &&
+      RenderEmbeddedThumbnail(pContext, pPage, matrix);
+  const CPDF_DisplayList* pDisplayList = nullptr;
+  if (!bEmbeddedThumbnail && (flags & FPDF_RENDER_DISPLAY_LIST) &&
+      !color_scheme) {
+    pDisplayList = GetDisplayList(pContext, pPage, flags);
+  }
+  if (!bEmbeddedThumbnail && !pDisplayList)
+    pContext->m_pContext->AppendLayer(pPage, matrix);
 
-  if (flags & FPDF_ANNOT) {
+  if ((flags & FPDF_ANNOT) && !bEmbeddedThumbnail) {
     auto pOwnedList = std::make_unique<CPDF_AnnotList>(pPage);
     CPDF_AnnotList* pList = pOwnedList.get();
     pContext->m_pAnnots = std::move(pOwnedList);
@@ -78,6 +144,8 @@ void RenderPageImpl(CPDF_PageRenderContext* pContext,
   pContext->m_pRenderer = std::make_unique<CPDF_ProgressiveRenderer>(
       pContext->m_pContext.get(), pContext->m_pDevice.get(),
       pContext->m_pOptions.get());
+  if (pDisplayList)
+    pContext->m_pRenderer->SetDisplayList(pDisplayList, matrix);
   pContext->m_pRenderer->Start(pause);
   if (need_to_restore)
     pContext->m_pDevice->RestoreState(false);
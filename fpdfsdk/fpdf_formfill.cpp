@@ -6,6 +6,8 @@
 
 #include "public/fpdf_formfill.h"
 
+#include <string.h>
+
 #include <memory>
 #include <utility>
 
@@ -15,11 +17,15 @@
 #include "core/fpdfapi/page/cpdf_page.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdfapi/render/cpdf_pagerendercontext.h"
+#include "core/fpdfapi/render/cpdf_progressiverenderer.h"
+#include "core/fpdfapi/render/cpdf_rendercontext.h"
 #include "core/fpdfapi/render/cpdf_renderoptions.h"
 #include "core/fpdfdoc/cpdf_formcontrol.h"
 #include "core/fpdfdoc/cpdf_formfield.h"
 #include "core/fpdfdoc/cpdf_interactiveform.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
 #include "fpdfsdk/cpdfsdk_actionhandler.h"
 #include "fpdfsdk/cpdfsdk_annot.h"
 #include "fpdfsdk/cpdfsdk_baannothandler.h"
@@ -27,8 +33,10 @@
 #include "fpdfsdk/cpdfsdk_helpers.h"
 #include "fpdfsdk/cpdfsdk_interactiveform.h"
 #include "fpdfsdk/cpdfsdk_pageview.h"
+#include "fpdfsdk/cpdfsdk_renderpage.h"
 #include "fpdfsdk/cpdfsdk_widgethandler.h"
 #include "public/fpdfview.h"
+#include "third_party/base/span.h"
 
 #ifdef PDF_ENABLE_XFA
 #include "fpdfsdk/fpdfxfa/cpdfxfa_context.h"
@@ -172,6 +180,47 @@ CPDFSDK_PageView* FormHandleToPageView(FPDF_FORMHANDLE hHandle,
   return pFormFillEnv ? pFormFillEnv->GetOrCreatePageView(pPage) : nullptr;
 }
 
+void DrawFormFields(CPDFSDK_PageView* pPageView,
+                    CPDF_Document* pPDFDoc,
+                    CFX_RenderDevice* pDevice,
+                    const CFX_Matrix& matrix,
+                    const FX_RECT& clip_rect,
+                    int flags) {
+  CFX_RenderDevice::StateRestorer restorer(pDevice);
+  pDevice->SetClip_Rect(clip_rect);
+
+  CPDF_RenderOptions options;
+  options.GetOptions().bClearType = !!(flags & FPDF_LCD_TEXT);
+
+  // Grayscale output
+  if (flags & FPDF_GRAYSCALE)
+    options.SetColorMode(CPDF_RenderOptions::kGray);
+
+  options.SetDrawAnnots(flags & FPDF_ANNOT);
+  options.SetOCContext(
+      pdfium::MakeRetain<CPDF_OCContext>(pPDFDoc, CPDF_OCContext::kView));
+
+  pPageView->PageView_OnDraw(pDevice, matrix, &options, clip_rect);
+}
+
+// Replaces |rect| of |pBitmap| with |color|, rather than blending |color|
+// over what was rendered there before.
+void ClearRect(CFX_RenderDevice* pDevice,
+               const RetainPtr<CFX_DIBitmap>& pBitmap,
+               const FX_RECT& rect,
+               uint32_t color) {
+  if (pBitmap->IsAlphaFormat()) {
+    const int bytes_per_pixel = pBitmap->GetBPP() / 8;
+    for (int row = rect.top; row < rect.bottom; ++row) {
+      memset(pBitmap->GetWritableScanline(row) + rect.left * bytes_per_pixel,
+             0, rect.Width() * bytes_per_pixel);
+    }
+  } else {
+    color |= 0xFF000000;
+  }
+  pDevice->FillRect(rect, color);
+}
+
 void FFLCommon(FPDF_FORMHANDLE hHandle,
                FPDF_BITMAP bitmap,
                FPDF_RECORDER recorder,
@@ -189,6 +238,11 @@ void FFLCommon(FPDF_FORMHANDLE hHandle,
   if (!pPage)
     return;
 
+  // The render devices cannot draw into 1bpp bitmaps.
+  RetainPtr<CFX_DIBitmap> holder(CFXDIBitmapFromFPDFBitmap(bitmap));
+  if (holder && holder->GetFormat() == FXDIB_Format::k1bppRgb)
+    return;
+
   CPDF_Document* pPDFDoc = pPage->GetDocument();
   CPDFSDK_PageView* pPageView = FormHandleToPageView(hHandle, fpdf_page);
 
@@ -200,26 +254,9 @@ void FFLCommon(FPDF_FORMHANDLE hHandle,
   pDevice->AttachRecorder(static_cast<SkPictureRecorder*>(recorder));
 #endif
 
-  RetainPtr<CFX_DIBitmap> holder(CFXDIBitmapFromFPDFBitmap(bitmap));
-  pDevice->Attach(holder, !!(flags & FPDF_REVERSE_BYTE_ORDER), nullptr, false);
-  {
-    CFX_RenderDevice::StateRestorer restorer(pDevice.get());
-    pDevice->SetClip_Rect(rect);
-
-    CPDF_RenderOptions options;
-    options.GetOptions().bClearType = !!(flags & FPDF_LCD_TEXT);
-
-    // Grayscale output
-    if (flags & FPDF_GRAYSCALE)
-      options.SetColorMode(CPDF_RenderOptions::kGray);
-
-    options.SetDrawAnnots(flags & FPDF_ANNOT);
-    options.SetOCContext(
-        pdfium::MakeRetain<CPDF_OCContext>(pPDFDoc, CPDF_OCContext::kView));
-
-    if (pPageView)
-      pPageView->PageView_OnDraw(pDevice.get(), matrix, &options, rect);
-  }
+  pDevice->AttachToRect(holder, !!(flags & FPDF_REVERSE_BYTE_ORDER), rect);
+  if (pPageView)
+    DrawFormFields(pPageView, pPDFDoc, pDevice.get(), matrix, rect, flags);
 
 #if defined(_SKIA_SUPPORT_PATHS_)
   pDevice->Flush(true);
@@ -699,6 +736,81 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_FFLRecord(FPDF_FORMHANDLE hHandle,
 }
 #endif
 
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_RenderPageBitmapRects(FPDF_FORMHANDLE hHandle,
+                           FPDF_BITMAP bitmap,
+                           FPDF_PAGE page,
+                           int start_x,
+                           int start_y,
+                           int size_x,
+                           int size_y,
+                           int rotate,
+                           int flags,
+                           const FS_RECTF* rects,
+                           size_t rect_count,
+                           FPDF_DWORD fill_color) {
+  if (!bitmap || (!rects && rect_count))
+    return false;
+
+  CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
+  if (!pPage)
+    return false;
+
+  RetainPtr<CFX_DIBitmap> pBitmap(CFXDIBitmapFromFPDFBitmap(bitmap));
+  if (pBitmap->GetFormat() == FXDIB_Format::k1bppRgb)
+    return false;
+
+  const FX_RECT rect(start_x, start_y, start_x + size_x, start_y + size_y);
+  const CFX_Matrix matrix = pPage->GetDisplayMatrix(rect, rotate);
+  FX_RECT bounds = rect;
+  bounds.Intersect(FX_RECT(0, 0, pBitmap->GetWidth(), pBitmap->GetHeight()));
+  CPDFSDK_PageView* pPageView =
+      hHandle ? FormHandleToPageView(hHandle, page) : nullptr;
+
+  // One device for all the rects, so a premultiplied bitmap is converted for
+  // rendering only once.
+  auto pOwnedContext = std::make_unique<CPDF_PageRenderContext>();
+  CPDF_PageRenderContext* pContext = pOwnedContext.get();
+  CPDF_Page::RenderContextClearer clearer(pPage);
+  pPage->SetRenderContext(std::move(pOwnedContext));
+
+  auto pOwnedDevice = std::make_unique<CFX_DefaultRenderDevice>();
+  CFX_DefaultRenderDevice* pDevice = pOwnedDevice.get();
+  pContext->m_pDevice = std::move(pOwnedDevice);
+  pDevice->AttachToRect(pBitmap, !!(flags & FPDF_REVERSE_BYTE_ORDER), bounds);
+
+  for (const FS_RECTF& dirty : pdfium::make_span(rects, rect_count)) {
+    CFX_FloatRect page_rect = CFXFloatRectFromFSRectF(dirty);
+    page_rect.Normalize();
+    // Anti-aliased edges reach into the pixels around the rect.
+    CFX_FloatRect device_rect = matrix.TransformRect(page_rect);
+    device_rect.Inflate(1.0f, 1.0f);
+    FX_RECT clip_rect = device_rect.GetOuterRect();
+    clip_rect.Intersect(bounds);
+    if (clip_rect.IsEmpty())
+      continue;
+
+    // Drop what the previous rect left, in the order the context would.
+    pContext->m_pRenderer.reset();
+    pContext->m_pContext.reset();
+    pContext->m_pAnnots.reset();
+
+    ClearRect(pDevice, pBitmap, clip_rect, fill_color);
+    CPDFSDK_RenderPage(pContext, pPage, matrix, clip_rect, flags,
+                       /*color_scheme=*/nullptr);
+    if (pPageView) {
+      DrawFormFields(pPageView, pPage->GetDocument(), pDevice, matrix,
+                     clip_rect, flags);
+    }
+  }
+
+#if defined(_SKIA_SUPPORT_PATHS_)
+  pDevice->Flush(true);
+  pBitmap->UnPreMultiply();
+#endif
+  return true;
+}
+
 FPDF_EXPORT void FPDF_CALLCONV
 FPDF_SetFormFieldHighlightColor(FPDF_FORMHANDLE hHandle,
                                 int fieldType,
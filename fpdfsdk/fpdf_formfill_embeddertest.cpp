@@ -1564,6 +1564,55 @@ TEST_F(FPDFFormFillEmbedderTest, SelectAllText) {
   UnloadPage(page);
 }
 
+TEST_F(FPDFFormFillEmbedderTest, RenderPageBitmapRects) {
+  ASSERT_TRUE(OpenDocument("text_form.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+
+  // Test bad arguments.
+  ScopedFPDFBitmap bitmap = RenderLoadedPage(page);
+  const FS_RECTF field_rect = {100, 130, 200, 100};
+  EXPECT_FALSE(FPDF_RenderPageBitmapRects(form_handle(), nullptr, page, 0, 0,
+                                          300, 300, 0, 0, &field_rect, 1,
+                                          0xFFFFFFFF));
+  EXPECT_FALSE(FPDF_RenderPageBitmapRects(form_handle(), bitmap.get(), nullptr,
+                                          0, 0, 300, 300, 0, 0, &field_rect, 1,
+                                          0xFFFFFFFF));
+  EXPECT_FALSE(FPDF_RenderPageBitmapRects(form_handle(), bitmap.get(), page, 0,
+                                          0, 300, 300, 0, 0, nullptr, 1,
+                                          0xFFFFFFFF));
+  EXPECT_TRUE(FPDF_RenderPageBitmapRects(form_handle(), bitmap.get(), page, 0,
+                                         0, 300, 300, 0, 0, nullptr, 0,
+                                         0xFFFFFFFF));
+
+  // Type into the text field, and redraw only the field.
+  const std::string old_hash = HashBitmap(bitmap.get());
+  EXPECT_TRUE(FORM_OnFocus(form_handle(), page, 0, 115, 115));
+  ScopedFPDFWideString text_to_insert = GetFPDFWideString(L"Hello");
+  FORM_ReplaceSelection(form_handle(), page, text_to_insert.get());
+  ScopedFPDFBitmap expected = RenderLoadedPage(page);
+  const std::string new_hash = HashBitmap(expected.get());
+  EXPECT_NE(old_hash, new_hash);
+
+  EXPECT_TRUE(FPDF_RenderPageBitmapRects(form_handle(), bitmap.get(), page, 0,
+                                         0, 300, 300, 0, 0, &field_rect, 1,
+                                         0xFFFFFFFF));
+  EXPECT_EQ(new_hash, HashBitmap(bitmap.get()));
+
+  // Only the dirty rects get redrawn, so the scribble below them stays.
+  FPDFBitmap_FillRect(bitmap.get(), 0, 0, 300, 200, 0xFFFF0000);
+  FPDFBitmap_FillRect(bitmap.get(), 0, 210, 300, 30, 0xFFFF0000);
+  const FS_RECTF rects[] = {{0, 300, 300, 160}, {0, 160, 300, 100}};
+  EXPECT_TRUE(FPDF_RenderPageBitmapRects(form_handle(), bitmap.get(), page, 0,
+                                         0, 300, 300, 0, 0, rects,
+                                         pdfium::size(rects), 0xFFFFFFFF));
+  EXPECT_NE(new_hash, HashBitmap(bitmap.get()));
+  FPDFBitmap_FillRect(bitmap.get(), 0, 210, 300, 30, 0xFFFFFFFF);
+  EXPECT_EQ(new_hash, HashBitmap(bitmap.get()));
+
+  UnloadPage(page);
+}
+
 TEST_F(FPDFFormFillTextFormEmbedderTest, GetSelectedTextEmptyAndBasicKeyboard) {
   // Test empty selection.
   CheckFocusedFieldText(L"");
@@ -2,8 +2,11 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <stdint.h>
+
 #include <vector>
 
+#include "public/fpdf_edit.h"
 #include "public/fpdf_thumbnail.h"
 #include "public/fpdfview.h"
 #include "testing/embedder_test.h"
@@ -297,3 +300,102 @@ TEST_F(FPDFThumbnailEmbedderTest, GetThumbnailDoesNotAlterPage) {
 TEST_F(FPDFThumbnailEmbedderTest, GetThumbnailAsBitmapFromPageNullPage) {
   EXPECT_EQ(nullptr, FPDFPage_GetThumbnailAsBitmap(nullptr));
 }
+
+TEST_F(FPDFThumbnailEmbedderTest, RenderPageWithThumbnailFlag) {
+  ASSERT_TRUE(OpenDocument("simple_thumbnail.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+
+  // The page has no contents, so anything drawn comes from its thumbnail.
+  auto render = [page](int size, int rotate, int flags) {
+    ScopedFPDFBitmap bitmap(FPDFBitmap_Create(size, size, 0));
+    FPDFBitmap_FillRect(bitmap.get(), 0, 0, size, size, 0xFFFFFFFF);
+    FPDF_RenderPageBitmap(bitmap.get(), page, 0, 0, size, size, rotate,
+                          flags);
+    return HashBitmap(bitmap.get());
+  };
+  EXPECT_NE(render(100, 0, 0), render(100, 0, FPDF_RENDER_THUMBNAIL));
+
+  // Not used when it would be scaled up too much, or would need rotating.
+  EXPECT_EQ(render(400, 0, 0), render(400, 0, FPDF_RENDER_THUMBNAIL));
+  EXPECT_EQ(render(100, 1, 0), render(100, 1, FPDF_RENDER_THUMBNAIL));
+
+  UnloadPage(page);
+}
+
+TEST_F(FPDFThumbnailEmbedderTest, RenderPageWithThumbnailFlagDetailCutoff) {
+  ASSERT_TRUE(OpenDocument("thumbnail_detail_cutoff.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+  ASSERT_EQ(6, FPDFPage_CountObjects(page));
+
+  constexpr int kSize = 200;
+  auto render = [page](int flags) {
+    ScopedFPDFBitmap bitmap(FPDFBitmap_Create(kSize, kSize, 0));
+    FPDFBitmap_FillRect(bitmap.get(), 0, 0, kSize, kSize, 0xFFFFFFFF);
+    FPDF_RenderPageBitmap(bitmap.get(), page, 0, 0, kSize, kSize, 0, flags);
+    return bitmap;
+  };
+  ScopedFPDFBitmap normal = render(0);
+  ScopedFPDFBitmap thumbnail = render(FPDF_RENDER_THUMBNAIL);
+
+  // Returns the BGRA pixel at page coordinates |x|, |y|.
+  auto pixel = [](FPDF_BITMAP bitmap, int x, int y) {
+    const uint8_t* buffer =
+        static_cast<const uint8_t*>(FPDFBitmap_GetBuffer(bitmap));
+    const uint8_t* row =
+        buffer + (kSize - 1 - y) * FPDFBitmap_GetStride(bitmap);
+    return std::vector<uint8_t>(row + x * 4, row + x * 4 + 4);
+  };
+  const std::vector<uint8_t> kRed = {0x00, 0x00, 0xFF, 0xFF};
+  const std::vector<uint8_t> kBlue = {0xFF, 0x00, 0x00, 0xFF};
+  const std::vector<uint8_t> kWhite = {0xFF, 0xFF, 0xFF, 0xFF};
+
+  // The 2x2 shading and pattern fill are skipped, the large shading is not.
+  EXPECT_EQ(kRed, pixel(normal.get(), 10, 10));
+  EXPECT_EQ(kWhite, pixel(thumbnail.get(), 10, 10));
+  EXPECT_EQ(kBlue, pixel(normal.get(), 30, 10));
+  EXPECT_EQ(kWhite, pixel(thumbnail.get(), 30, 10));
+  EXPECT_EQ(kRed, pixel(normal.get(), 125, 125));
+  EXPECT_EQ(kRed, pixel(thumbnail.get(), 125, 125));
+
+  // Returns whether the two renders match within the bounds of |index|.
+  auto same_within_bounds = [&](int index) {
+    float left;
+    float bottom;
+    float right;
+    float top;
+    if (!FPDFPageObj_GetBounds(FPDFPage_GetObject(page, index), &left,
+                               &bottom, &right, &top)) {
+      return false;
+    }
+    for (int y = static_cast<int>(bottom); y < static_cast<int>(top); ++y) {
+      for (int x = static_cast<int>(left); x < static_cast<int>(right); ++x) {
+        if (pixel(normal.get(), x, y) != pixel(thumbnail.get(), x, y))
+          return false;
+      }
+    }
+    return true;
+  };
+
+  // Text with a 2 pixel em is filled as a gray bar over its bounds.
+  float left;
+  float bottom;
+  float right;
+  float top;
+  ASSERT_TRUE(FPDFPageObj_GetBounds(FPDFPage_GetObject(page, 3), &left,
+                                    &bottom, &right, &top));
+  std::vector<uint8_t> bar =
+      pixel(thumbnail.get(), static_cast<int>((left + right) / 2),
+            static_cast<int>((bottom + top) / 2));
+  EXPECT_EQ(bar[0], bar[1]);
+  EXPECT_EQ(bar[0], bar[2]);
+  EXPECT_NEAR(0x7F, bar[0], 2);
+  EXPECT_FALSE(same_within_bounds(3));
+
+  // Larger text is drawn normally, whatever the sign of its font size.
+  EXPECT_TRUE(same_within_bounds(4));
+  EXPECT_TRUE(same_within_bounds(5));
+
+  UnloadPage(page);
+}
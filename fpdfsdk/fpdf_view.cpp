@@ -6,6 +6,7 @@
 
 #include "public/fpdfview.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -24,7 +25,9 @@
 #include "core/fpdfapi/parser/cpdf_string.h"
 #include "core/fpdfapi/parser/cpdf_syntax_parser.h"
 #include "core/fpdfapi/parser/fpdf_parser_decode.h"
+#include "core/fpdfapi/render/cpdf_docimagecache.h"
 #include "core/fpdfapi/render/cpdf_docrenderdata.h"
+#include "core/fpdfapi/render/cpdf_formbitmapcache.h"
 #include "core/fpdfapi/render/cpdf_pagerendercache.h"
 #include "core/fpdfapi/render/cpdf_pagerendercontext.h"
 #include "core/fpdfapi/render/cpdf_rendercontext.h"
@@ -39,7 +42,9 @@
 #include "core/fxcrt/unowned_ptr.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
 #include "core/fxge/cfx_gemodule.h"
+#include "core/fxge/cfx_glyphcachebudget.h"
 #include "core/fxge/cfx_renderdevice.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
 #include "fpdfsdk/cpdfsdk_customaccess.h"
 #include "fpdfsdk/cpdfsdk_formfillenvironment.h"
 #include "fpdfsdk/cpdfsdk_helpers.h"
@@ -159,6 +164,69 @@ FPDF_DOCUMENT LoadDocumentImpl(
   return FPDFDocumentFromCPDFDocument(pDocument.release());
 }
 
+constexpr int kMonoBandHeight = 64;
+
+// The render devices cannot draw into 1bpp bitmaps, so render |clip_rect| of
+// |pPage| band by band into a gray scratch bitmap, and threshold each band
+// into |pBitmap| at 50%.
+void RenderPageToMonoBitmap(CPDF_Page* pPage,
+                            const RetainPtr<CFX_DIBitmap>& pBitmap,
+                            const CFX_Matrix& matrix,
+                            const FX_RECT& clip_rect,
+                            int flags) {
+  FX_RECT rect = clip_rect;
+  rect.Intersect(0, 0, pBitmap->GetWidth(), pBitmap->GetHeight());
+  if (rect.IsEmpty())
+    return;
+
+  const int band_height = std::min(kMonoBandHeight, rect.Height());
+  auto pBand = pdfium::MakeRetain<CFX_DIBitmap>();
+  if (!pBand->Create(rect.Width(), band_height, FXDIB_Format::k8bppRgb))
+    return;
+
+  for (int band_top = rect.top; band_top < rect.bottom;
+       band_top += band_height) {
+    const int rows = std::min(band_height, rect.bottom - band_top);
+    for (int row = 0; row < rows; ++row) {
+      const uint8_t* src_scan = pBitmap->GetScanline(band_top + row);
+      uint8_t* dest_scan = pBand->GetWritableScanline(row);
+      for (int col = 0; col < rect.Width(); ++col) {
+        const int x = rect.left + col;
+        dest_scan[col] = (src_scan[x / 8] & (0x80 >> (x % 8))) ? 255 : 0;
+      }
+    }
+
+    {
+      auto pOwnedContext = std::make_unique<CPDF_PageRenderContext>();
+      CPDF_PageRenderContext* pContext = pOwnedContext.get();
+      CPDF_Page::RenderContextClearer clearer(pPage);
+      pPage->SetRenderContext(std::move(pOwnedContext));
+
+      auto pOwnedDevice = std::make_unique<CFX_DefaultRenderDevice>();
+      pOwnedDevice->Attach(pBand, false, nullptr, false);
+      pContext->m_pDevice = std::move(pOwnedDevice);
+
+      CFX_Matrix band_matrix = matrix;
+      band_matrix.Translate(-rect.left, -band_top);
+      CPDFSDK_RenderPage(pContext, pPage, band_matrix,
+                         FX_RECT(0, 0, rect.Width(), rows), flags,
+                         /*color_scheme=*/nullptr);
+    }
+
+    for (int row = 0; row < rows; ++row) {
+      const uint8_t* src_scan = pBand->GetScanline(row);
+      uint8_t* dest_scan = pBitmap->GetWritableScanline(band_top + row);
+      for (int col = 0; col < rect.Width(); ++col) {
+        const int x = rect.left + col;
+        if (src_scan[col] >= 128)
+          dest_scan[x / 8] |= 0x80 >> (x % 8);
+        else
+          dest_scan[x / 8] &= ~(0x80 >> (x % 8));
+      }
+    }
+  }
+}
+
 }  // namespace
 
 FPDF_EXPORT void FPDF_CALLCONV FPDF_InitLibrary() {
@@ -206,6 +274,33 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_SetSandBoxPolicy(FPDF_DWORD policy,
   return SetPDFSandboxPolicy(policy, enable);
 }
 
+FPDF_EXPORT void FPDF_CALLCONV FPDF_SetGlyphCacheLimit(size_t max_bytes) {
+  CFX_GlyphCacheBudget::GetInstance()->SetMaxBytes(max_bytes);
+}
+
+FPDF_EXPORT size_t FPDF_CALLCONV FPDF_GetGlyphCacheLimit() {
+  return CFX_GlyphCacheBudget::GetInstance()->GetMaxBytes();
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_GetGlyphCacheStats(FPDF_GLYPH_CACHE_STATS* stats) {
+  if (!stats)
+    return false;
+
+  CFX_GlyphCacheBudget::Stats budget_stats =
+      CFX_GlyphCacheBudget::GetInstance()->GetStats();
+  stats->hits = budget_stats.hits;
+  stats->misses = budget_stats.misses;
+  stats->evictions = budget_stats.evictions;
+  stats->bytes = budget_stats.bytes;
+  stats->entries = budget_stats.entries;
+  return true;
+}
+
+FPDF_EXPORT void FPDF_CALLCONV FPDF_ResetGlyphCacheStats() {
+  CFX_GlyphCacheBudget::GetInstance()->ResetCounters();
+}
+
 #if defined(OS_WIN)
 #if defined(PDFIUM_PRINT_TEXT_WITH_GDI)
 FPDF_EXPORT void FPDF_CALLCONV
@@ -614,6 +709,14 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_RenderPageBitmap(FPDF_BITMAP bitmap,
   if (!pPage)
     return;
 
+  RetainPtr<CFX_DIBitmap> pBitmap(CFXDIBitmapFromFPDFBitmap(bitmap));
+  if (pBitmap->GetFormat() == FXDIB_Format::k1bppRgb) {
+    const FX_RECT rect(start_x, start_y, start_x + size_x, start_y + size_y);
+    RenderPageToMonoBitmap(pPage, pBitmap,
+                           pPage->GetDisplayMatrix(rect, rotate), rect, flags);
+    return;
+  }
+
   auto pOwnedContext = std::make_unique<CPDF_PageRenderContext>();
   CPDF_PageRenderContext* pContext = pOwnedContext.get();
   CPDF_Page::RenderContextClearer clearer(pPage);
@@ -623,8 +726,9 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_RenderPageBitmap(FPDF_BITMAP bitmap,
   CFX_DefaultRenderDevice* pDevice = pOwnedDevice.get();
   pContext->m_pDevice = std::move(pOwnedDevice);
 
-  RetainPtr<CFX_DIBitmap> pBitmap(CFXDIBitmapFromFPDFBitmap(bitmap));
-  pDevice->Attach(pBitmap, !!(flags & FPDF_REVERSE_BYTE_ORDER), nullptr, false);
+  pDevice->AttachToRect(
+      pBitmap, !!(flags & FPDF_REVERSE_BYTE_ORDER),
+      FX_RECT(start_x, start_y, start_x + size_x, start_y + size_y));
   CPDFSDK_RenderPageWithContext(pContext, pPage, start_x, start_y, size_x,
                                 size_y, rotate, flags, /*color_scheme=*/nullptr,
                                 /*need_to_restore=*/true,
@@ -649,18 +753,6 @@ FPDF_RenderPageBitmapWithMatrix(FPDF_BITMAP bitmap,
   if (!pPage)
     return;
 
-  auto pOwnedContext = std::make_unique<CPDF_PageRenderContext>();
-  CPDF_PageRenderContext* pContext = pOwnedContext.get();
-  CPDF_Page::RenderContextClearer clearer(pPage);
-  pPage->SetRenderContext(std::move(pOwnedContext));
-
-  auto pOwnedDevice = std::make_unique<CFX_DefaultRenderDevice>();
-  CFX_DefaultRenderDevice* pDevice = pOwnedDevice.get();
-  pContext->m_pDevice = std::move(pOwnedDevice);
-
-  RetainPtr<CFX_DIBitmap> pBitmap(CFXDIBitmapFromFPDFBitmap(bitmap));
-  pDevice->Attach(pBitmap, !!(flags & FPDF_REVERSE_BYTE_ORDER), nullptr, false);
-
   CFX_FloatRect clipping_rect;
   if (clipping)
     clipping_rect = CFXFloatRectFromFSRectF(*clipping);
@@ -670,10 +762,123 @@ FPDF_RenderPageBitmapWithMatrix(FPDF_BITMAP bitmap,
   CFX_Matrix transform_matrix = pPage->GetDisplayMatrix(rect, 0);
   if (matrix)
     transform_matrix *= CFXMatrixFromFSMatrix(*matrix);
+
+  RetainPtr<CFX_DIBitmap> pBitmap(CFXDIBitmapFromFPDFBitmap(bitmap));
+  if (pBitmap->GetFormat() == FXDIB_Format::k1bppRgb) {
+    RenderPageToMonoBitmap(pPage, pBitmap, transform_matrix, clip_rect,
+                           flags);
+    return;
+  }
+
+  auto pOwnedContext = std::make_unique<CPDF_PageRenderContext>();
+  CPDF_PageRenderContext* pContext = pOwnedContext.get();
+  CPDF_Page::RenderContextClearer clearer(pPage);
+  pPage->SetRenderContext(std::move(pOwnedContext));
+
+  auto pOwnedDevice = std::make_unique<CFX_DefaultRenderDevice>();
+  CFX_DefaultRenderDevice* pDevice = pOwnedDevice.get();
+  pContext->m_pDevice = std::move(pOwnedDevice);
+
+  pDevice->AttachToRect(pBitmap, !!(flags & FPDF_REVERSE_BYTE_ORDER),
+                        clip_rect);
   CPDFSDK_RenderPage(pContext, pPage, transform_matrix, clip_rect, flags,
                      /*color_scheme=*/nullptr);
 }
 
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_SetFormCacheLimit(FPDF_DOCUMENT document, size_t max_bytes) {
+  CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document);
+  if (!pDoc)
+    return false;
+
+  CPDF_DocRenderData::FromDocument(pDoc)->GetFormBitmapCache()->SetMaxBytes(
+      max_bytes);
+  return true;
+}
+
+FPDF_EXPORT size_t FPDF_CALLCONV
+FPDF_GetFormCacheLimit(FPDF_DOCUMENT document) {
+  CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document);
+  if (!pDoc)
+    return 0;
+
+  return CPDF_DocRenderData::FromDocument(pDoc)
+      ->GetFormBitmapCache()
+      ->GetMaxBytes();
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_GetFormCacheStats(FPDF_DOCUMENT document,
+                       FPDF_DOCUMENT_CACHE_STATS* stats) {
+  CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document);
+  if (!pDoc || !stats)
+    return false;
+
+  CPDF_FormBitmapCache::Stats cache_stats =
+      CPDF_DocRenderData::FromDocument(pDoc)->GetFormBitmapCache()->GetStats();
+  stats->hits = cache_stats.hits;
+  stats->misses = cache_stats.misses;
+  stats->evictions = cache_stats.evictions;
+  stats->bytes = cache_stats.bytes;
+  stats->entries = cache_stats.entries;
+  return true;
+}
+
+FPDF_EXPORT void FPDF_CALLCONV
+FPDF_ResetFormCacheStats(FPDF_DOCUMENT document) {
+  CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document);
+  if (!pDoc)
+    return;
+
+  CPDF_DocRenderData::FromDocument(pDoc)->GetFormBitmapCache()->ResetCounters();
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_SetImageCacheLimit(FPDF_DOCUMENT document, size_t max_bytes) {
+  CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document);
+  if (!pDoc)
+    return false;
+
+  CPDF_DocRenderData::FromDocument(pDoc)->GetImageCache()->SetMaxBytes(
+      max_bytes);
+  return true;
+}
+
+FPDF_EXPORT size_t FPDF_CALLCONV
+FPDF_GetImageCacheLimit(FPDF_DOCUMENT document) {
+  CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document);
+  if (!pDoc)
+    return 0;
+
+  return CPDF_DocRenderData::FromDocument(pDoc)->GetImageCache()->GetMaxBytes();
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_GetImageCacheStats(FPDF_DOCUMENT document,
+                        FPDF_DOCUMENT_CACHE_STATS* stats) {
+  CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document);
+  if (!pDoc || !stats)
+    return false;
+
+  CPDF_DocImageCache::Stats cache_stats =
+      CPDF_DocRenderData::FromDocument(pDoc)->GetImageCache()->GetStats();
+  stats->hits = cache_stats.hits;
+  stats->misses = cache_stats.misses;
+  stats->evictions = cache_stats.evictions;
+  stats->bytes = cache_stats.bytes;
+  stats->entries = cache_stats.entries;
+  return true;
+}
+
+FPDF_EXPORT void FPDF_CALLCONV
+FPDF_ResetImageCacheStats(FPDF_DOCUMENT document) {
+  CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document);
+  if (!pDoc)
+    return;
+
+  CPDF_DocRenderData::FromDocument(pDoc)->GetImageCache()->ResetCounters();
+}
+
 #if defined(_SKIA_SUPPORT_)
 FPDF_EXPORT FPDF_RECORDER FPDF_CALLCONV FPDF_RenderPageSkp(FPDF_PAGE page,
                                                            int size_x,
@@ -813,8 +1018,12 @@ FPDF_EXPORT FPDF_BITMAP FPDF_CALLCONV FPDFBitmap_CreateEx(int width,
       fx_format = FXDIB_Format::kRgb32;
       break;
     case FPDFBitmap_BGRA:
+    case FPDFBitmap_BGRA_Premul:
       fx_format = FXDIB_Format::kArgb;
       break;
+    case FPDFBitmap_Mono:
+      fx_format = FXDIB_Format::k1bppRgb;
+      break;
     default:
       return nullptr;
   }
@@ -825,6 +1034,8 @@ FPDF_EXPORT FPDF_BITMAP FPDF_CALLCONV FPDFBitmap_CreateEx(int width,
   if (!pBitmap->Create(width, height, fx_format, pChecker.Get(), stride))
     return nullptr;
 
+  pBitmap->SetPremultiplied(format == FPDFBitmap_BGRA_Premul);
+
   return FPDFBitmapFromCFXDIBitmap(pBitmap.Leak());
 }
 
@@ -832,8 +1043,10 @@ FPDF_EXPORT int FPDF_CALLCONV FPDFBitmap_GetFormat(FPDF_BITMAP bitmap) {
   if (!bitmap)
     return FPDFBitmap_Unknown;
 
-  FXDIB_Format format = CFXDIBitmapFromFPDFBitmap(bitmap)->GetFormat();
-  switch (format) {
+  const CFX_DIBitmap* pBitmap = CFXDIBitmapFromFPDFBitmap(bitmap);
+  switch (pBitmap->GetFormat()) {
+    case FXDIB_Format::k1bppRgb:
+      return FPDFBitmap_Mono;
     case FXDIB_Format::k8bppRgb:
     case FXDIB_Format::k8bppMask:
       return FPDFBitmap_Gray;
@@ -842,7 +1055,8 @@ FPDF_EXPORT int FPDF_CALLCONV FPDFBitmap_GetFormat(FPDF_BITMAP bitmap) {
     case FXDIB_Format::kRgb32:
       return FPDFBitmap_BGRx;
     case FXDIB_Format::kArgb:
-      return FPDFBitmap_BGRA;
+      return pBitmap->IsPremultiplied() ? FPDFBitmap_BGRA_Premul
+                                        : FPDFBitmap_BGRA;
     default:
       return FPDFBitmap_Unknown;
   }
@@ -857,12 +1071,18 @@ FPDF_EXPORT void FPDF_CALLCONV FPDFBitmap_FillRect(FPDF_BITMAP bitmap,
   if (!bitmap)
     return;
 
+  const FX_RECT rect(left, top, left + width, top + height);
   CFX_DefaultRenderDevice device;
   RetainPtr<CFX_DIBitmap> pBitmap(CFXDIBitmapFromFPDFBitmap(bitmap));
-  device.Attach(pBitmap, false, nullptr, false);
+  device.AttachToRect(pBitmap, false, rect);
   if (!pBitmap->IsAlphaFormat())
     color |= 0xFF000000;
-  device.FillRect(FX_RECT(left, top, left + width, top + height), color);
+  if (pBitmap->GetFormat() == FXDIB_Format::k1bppRgb) {
+    const int gray = FXRGB2GRAY(FXARGB_R(color), FXARGB_G(color),
+                                FXARGB_B(color));
+    color = gray >= 128 ? 0xFFFFFFFF : 0xFF000000;
+  }
+  device.FillRect(rect, color);
 }
 
 FPDF_EXPORT void* FPDF_CALLCONV FPDFBitmap_GetBuffer(FPDF_BITMAP bitmap) {
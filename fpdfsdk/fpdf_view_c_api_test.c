@@ -298,6 +298,7 @@ int CheckPDFiumCApi() {
     CHK(FPDF_GetFormType);
     CHK(FPDF_LoadXFA);
     CHK(FPDF_RemoveFormFieldHighlight);
+    CHK(FPDF_RenderPageBitmapRects);
     CHK(FPDF_SetFormFieldHighlightAlpha);
     CHK(FPDF_SetFormFieldHighlightColor);
 
@@ -450,6 +451,12 @@ int CheckPDFiumCApi() {
 #endif
     CHK(FPDF_GetDocPermissions);
     CHK(FPDF_GetFileVersion);
+    CHK(FPDF_GetFormCacheLimit);
+    CHK(FPDF_GetFormCacheStats);
+    CHK(FPDF_GetGlyphCacheLimit);
+    CHK(FPDF_GetGlyphCacheStats);
+    CHK(FPDF_GetImageCacheLimit);
+    CHK(FPDF_GetImageCacheStats);
     CHK(FPDF_GetLastError);
     CHK(FPDF_GetNamedDest);
     CHK(FPDF_GetNamedDestByName);
@@ -485,6 +492,12 @@ int CheckPDFiumCApi() {
 #if defined(_SKIA_SUPPORT_)
     CHK(FPDF_RenderPageSkp);
 #endif
+    CHK(FPDF_ResetFormCacheStats);
+    CHK(FPDF_ResetGlyphCacheStats);
+    CHK(FPDF_ResetImageCacheStats);
+    CHK(FPDF_SetFormCacheLimit);
+    CHK(FPDF_SetGlyphCacheLimit);
+    CHK(FPDF_SetImageCacheLimit);
 #if defined(_WIN32)
     CHK(FPDF_SetPrintMode);
 #if defined(PDFIUM_PRINT_TEXT_WITH_GDI)
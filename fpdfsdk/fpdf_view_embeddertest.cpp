@@ -14,6 +14,8 @@
 #include "fpdfsdk/cpdfsdk_helpers.h"
 #include "fpdfsdk/fpdf_view_c_api_test.h"
 #include "public/cpp/fpdf_scopers.h"
+#include "public/fpdf_edit.h"
+#include "public/fpdf_progressive.h"
 #include "public/fpdfview.h"
 #include "testing/embedder_test.h"
 #include "testing/embedder_test_constants.h"
@@ -1004,6 +1006,415 @@ TEST_F(FPDFViewEmbedderTest, FPDF_RenderPageBitmapWithMatrix) {
   UnloadPage(page);
 }
 
+TEST_F(FPDFViewEmbedderTest, RenderPremultipliedAndMonoBitmaps) {
+  ASSERT_TRUE(OpenDocument("rectangles.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+  const int width = static_cast<int>(FPDF_GetPageWidth(page));
+  const int height = static_cast<int>(FPDF_GetPageHeight(page));
+
+  // Half transparent backgrounds make the premultiplication visible.
+  ScopedFPDFBitmap bgra(FPDFBitmap_CreateEx(width, height, FPDFBitmap_BGRA,
+                                            nullptr, 0));
+  ScopedFPDFBitmap premul(FPDFBitmap_CreateEx(
+      width, height, FPDFBitmap_BGRA_Premul, nullptr, 0));
+  ASSERT_TRUE(premul);
+  EXPECT_EQ(FPDFBitmap_BGRA_Premul, FPDFBitmap_GetFormat(premul.get()));
+  FPDFBitmap_FillRect(bgra.get(), 0, 0, width, height, 0x80FFFFFF);
+  FPDFBitmap_FillRect(premul.get(), 0, 0, width, height, 0x80FFFFFF);
+  FPDF_RenderPageBitmap(bgra.get(), page, 0, 0, width, height, 0, 0);
+  FPDF_RenderPageBitmap(premul.get(), page, 0, 0, width, height, 0, 0);
+  for (int row = 0; row < height; ++row) {
+    const uint8_t* expected =
+        static_cast<const uint8_t*>(FPDFBitmap_GetBuffer(bgra.get())) +
+        row * FPDFBitmap_GetStride(bgra.get());
+    const uint8_t* actual =
+        static_cast<const uint8_t*>(FPDFBitmap_GetBuffer(premul.get())) +
+        row * FPDFBitmap_GetStride(premul.get());
+    for (int i = 0; i < width * 4; i += 4) {
+      ASSERT_EQ(expected[i + 3], actual[i + 3]);
+      for (int c = 0; c < 3; ++c) {
+        ASSERT_NEAR((expected[i + c] * expected[i + 3] + 127) / 255,
+                    actual[i + c], 1);
+      }
+    }
+  }
+
+  // 1bpp output is the gray output thresholded at 50%.
+  ScopedFPDFBitmap gray(FPDFBitmap_CreateEx(width, height, FPDFBitmap_Gray,
+                                            nullptr, 0));
+  ScopedFPDFBitmap mono(FPDFBitmap_CreateEx(width, height, FPDFBitmap_Mono,
+                                            nullptr, 0));
+  ASSERT_TRUE(mono);
+  EXPECT_EQ(FPDFBitmap_Mono, FPDFBitmap_GetFormat(mono.get()));
+  EXPECT_EQ((width + 31) / 32 * 4, FPDFBitmap_GetStride(mono.get()));
+  FPDFBitmap_FillRect(gray.get(), 0, 0, width, height, 0xFFFFFFFF);
+  FPDFBitmap_FillRect(mono.get(), 0, 0, width, height, 0xFFFFFFFF);
+  FPDF_RenderPageBitmap(gray.get(), page, 0, 0, width, height, 0, 0);
+  FPDF_RenderPageBitmap(mono.get(), page, 0, 0, width, height, 0, 0);
+  for (int row = 0; row < height; ++row) {
+    const uint8_t* expected =
+        static_cast<const uint8_t*>(FPDFBitmap_GetBuffer(gray.get())) +
+        row * FPDFBitmap_GetStride(gray.get());
+    const uint8_t* actual =
+        static_cast<const uint8_t*>(FPDFBitmap_GetBuffer(mono.get())) +
+        row * FPDFBitmap_GetStride(mono.get());
+    for (int col = 0; col < width; ++col) {
+      ASSERT_EQ(expected[col] >= 128, !!(actual[col / 8] & (0x80 >> (col % 8))))
+          << row << ", " << col;
+    }
+  }
+
+  // Progressive rendering cannot draw into 1bpp bitmaps.
+  struct NeverPause : public IFSDK_PAUSE {
+    NeverPause() {
+      version = 1;
+      user = nullptr;
+      NeedToPauseNow = [](IFSDK_PAUSE* pThis) -> FPDF_BOOL { return false; };
+    }
+  } pause;
+  EXPECT_EQ(FPDF_RENDER_FAILED,
+            FPDF_RenderPageBitmap_Start(mono.get(), page, 0, 0, width, height,
+                                        0, 0, &pause));
+  FPDF_RenderPage_Close(page);
+
+  UnloadPage(page);
+}
+
+TEST_F(FPDFViewEmbedderTest, RenderPremultipliedBitmapRect) {
+  ASSERT_TRUE(OpenDocument("rectangles.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+  const int width = static_cast<int>(FPDF_GetPageWidth(page));
+  const int height = static_cast<int>(FPDF_GetPageHeight(page));
+
+  // Rendering the left half leaves the premultiplied right half as it was.
+  ScopedFPDFBitmap premul(FPDFBitmap_CreateEx(
+      width, height, FPDFBitmap_BGRA_Premul, nullptr, 0));
+  ASSERT_TRUE(premul);
+  FPDFBitmap_FillRect(premul.get(), 0, 0, width, height, 0x80FFFFFF);
+  const uint8_t* buffer =
+      static_cast<const uint8_t*>(FPDFBitmap_GetBuffer(premul.get()));
+  EXPECT_EQ(128, buffer[0]);
+  EXPECT_EQ(128, buffer[3]);
+
+  // The page is drawn into the whole bitmap, but clipped to the left half.
+  FS_RECTF clip = {0, 0, width / 2.0f, static_cast<float>(height)};
+  FPDF_RenderPageBitmapWithMatrix(premul.get(), page, nullptr, &clip, 0);
+  const int stride = FPDFBitmap_GetStride(premul.get());
+  for (int row = 0; row < height; ++row) {
+    const uint8_t* pixel = buffer + row * stride + width / 2 * 4;
+    for (int col = width / 2; col < width; ++col, pixel += 4) {
+      ASSERT_EQ(128, pixel[0]) << row << ", " << col;
+      ASSERT_EQ(128, pixel[3]) << row << ", " << col;
+    }
+  }
+
+  UnloadPage(page);
+}
+
+TEST_F(FPDFViewEmbedderTest, RenderWithDisplayList) {
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+
+  // The first render builds the display list and the second one replays it.
+  using pdfium::kHelloWorldChecksum;
+  TestRenderPageBitmapWithFlags(page, FPDF_RENDER_DISPLAY_LIST,
+                                kHelloWorldChecksum);
+  TestRenderPageBitmapWithFlags(page, FPDF_RENDER_DISPLAY_LIST,
+                                kHelloWorldChecksum);
+
+  // Replaying at other zoom levels and offsets matches a normal render.
+  for (int size : {77, 400}) {
+    for (int offset : {0, -30}) {
+      std::string hashes[2];
+      for (int i = 0; i < 2; ++i) {
+        ScopedFPDFBitmap bitmap(FPDFBitmap_Create(size, size, 0));
+        FPDFBitmap_FillRect(bitmap.get(), 0, 0, size, size, 0xFFFFFFFF);
+        FPDF_RenderPageBitmap(bitmap.get(), page, offset, offset, size, size,
+                              0, i ? FPDF_RENDER_DISPLAY_LIST : 0);
+        hashes[i] = HashBitmap(bitmap.get());
+      }
+      EXPECT_EQ(hashes[0], hashes[1]) << size << " " << offset;
+    }
+  }
+
+  // Removing an object makes the next render rebuild the list.
+  FPDF_PAGEOBJECT page_object = FPDFPage_GetObject(page, 1);
+  ASSERT_TRUE(page_object);
+  ASSERT_TRUE(FPDFPage_RemoveObject(page, page_object));
+  FPDFPageObj_Destroy(page_object);
+  TestRenderPageBitmapWithFlags(page, FPDF_RENDER_DISPLAY_LIST,
+                                pdfium::kHelloWorldRemovedChecksum);
+
+  UnloadPage(page);
+}
+
+TEST_F(FPDFViewEmbedderTest, RenderWithDisplayListAfterEdits) {
+  ScopedFPDFDocument doc(FPDF_CreateNewDocument());
+  ScopedFPDFPage page(FPDFPage_New(doc.get(), 0, 200, 200));
+  ASSERT_TRUE(page);
+  // Enough objects for the list to pause in between them.
+  for (int i = 0; i < 300; ++i) {
+    FPDF_PAGEOBJECT rect =
+        FPDFPageObj_CreateNewRect((i % 20) * 10, (i / 20) * 10, 8, 8);
+    ASSERT_TRUE(FPDFPageObj_SetFillColor(rect, i % 256, 0, 255 - i % 256, 255));
+    ASSERT_TRUE(FPDFPath_SetDrawMode(rect, FPDF_FILLMODE_WINDING, 0));
+    FPDFPage_InsertObject(page.get(), rect);
+  }
+  ASSERT_TRUE(FPDFPage_GenerateContent(page.get()));
+
+  auto render = [&page](int flags) {
+    ScopedFPDFBitmap bitmap(FPDFBitmap_Create(200, 200, 0));
+    FPDFBitmap_FillRect(bitmap.get(), 0, 0, 200, 200, 0xFFFFFFFF);
+    FPDF_RenderPageBitmap(bitmap.get(), page.get(), 0, 0, 200, 200, 0, flags);
+    return HashBitmap(bitmap.get());
+  };
+  const std::string original_hash = render(0);
+  EXPECT_EQ(original_hash, render(FPDF_RENDER_DISPLAY_LIST));
+
+  // Generating content clears the dirty flags of the edited objects, but the
+  // list still gets rebuilt.
+  FPDF_PAGEOBJECT first = FPDFPage_GetObject(page.get(), 0);
+  ASSERT_TRUE(FPDFPageObj_SetFillColor(first, 0, 255, 0, 255));
+  ASSERT_TRUE(FPDFPage_GenerateContent(page.get()));
+  const std::string edited_hash = render(0);
+  EXPECT_NE(original_hash, edited_hash);
+  EXPECT_EQ(edited_hash, render(FPDF_RENDER_DISPLAY_LIST));
+
+  // Progressive renders pause in between the ops of the list.
+  struct AlwaysPause : public IFSDK_PAUSE {
+    AlwaysPause() {
+      version = 1;
+      user = nullptr;
+      NeedToPauseNow = [](IFSDK_PAUSE* pThis) -> FPDF_BOOL { return true; };
+    }
+  } pause;
+  ScopedFPDFBitmap bitmap(FPDFBitmap_Create(200, 200, 0));
+  FPDFBitmap_FillRect(bitmap.get(), 0, 0, 200, 200, 0xFFFFFFFF);
+  int status =
+      FPDF_RenderPageBitmap_Start(bitmap.get(), page.get(), 0, 0, 200, 200, 0,
+                                  FPDF_RENDER_DISPLAY_LIST, &pause);
+  int continues = 0;
+  while (status == FPDF_RENDER_TOBECONTINUED) {
+    status = FPDF_RenderPage_Continue(page.get(), &pause);
+    ++continues;
+  }
+  EXPECT_EQ(FPDF_RENDER_DONE, status);
+  EXPECT_GE(continues, 2);
+  FPDF_RenderPage_Close(page.get());
+  EXPECT_EQ(edited_hash, HashBitmap(bitmap.get()));
+}
+
+// Skia draws glyphs with its own cache, so CFX_GlyphCache never sees them.
+#if defined(_SKIA_SUPPORT_)
+#define MAYBE_GlyphCacheLimit DISABLED_GlyphCacheLimit
+#else
+#define MAYBE_GlyphCacheLimit GlyphCacheLimit
+#endif
+TEST_F(FPDFViewEmbedderTest, MAYBE_GlyphCacheLimit) {
+  EXPECT_FALSE(FPDF_GetGlyphCacheStats(nullptr));
+  const size_t old_limit = FPDF_GetGlyphCacheLimit();
+
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+
+  // Start without any cached glyphs.
+  FPDF_SetGlyphCacheLimit(0);
+  FPDF_SetGlyphCacheLimit(old_limit);
+  FPDF_ResetGlyphCacheStats();
+  FPDF_GLYPH_CACHE_STATS stats;
+  ASSERT_TRUE(FPDF_GetGlyphCacheStats(&stats));
+  EXPECT_EQ(0u, stats.hits);
+  EXPECT_EQ(0u, stats.misses);
+  EXPECT_EQ(0u, stats.evictions);
+  EXPECT_EQ(0u, stats.bytes);
+  EXPECT_EQ(0u, stats.entries);
+
+  TestRenderPageBitmapWithFlags(page, 0, pdfium::kHelloWorldChecksum);
+  ASSERT_TRUE(FPDF_GetGlyphCacheStats(&stats));
+  const unsigned long long first_misses = stats.misses;
+  const unsigned long long first_lookups = stats.hits + stats.misses;
+  EXPECT_GT(first_misses, 0u);
+  EXPECT_GT(stats.bytes, 0u);
+  EXPECT_EQ(first_misses, stats.entries);
+
+  // Rendering again only hits the cache.
+  TestRenderPageBitmapWithFlags(page, 0, pdfium::kHelloWorldChecksum);
+  ASSERT_TRUE(FPDF_GetGlyphCacheStats(&stats));
+  EXPECT_EQ(first_misses, stats.misses);
+  EXPECT_EQ(2 * first_lookups, stats.hits + stats.misses);
+  EXPECT_EQ(0u, stats.evictions);
+
+  // Lowering the limit evicts right away, and the glyphs get rendered again
+  // the next time they are needed.
+  FPDF_SetGlyphCacheLimit(0);
+  ASSERT_TRUE(FPDF_GetGlyphCacheStats(&stats));
+  EXPECT_EQ(first_misses, stats.evictions);
+  EXPECT_EQ(0u, stats.bytes);
+  EXPECT_EQ(0u, stats.entries);
+  TestRenderPageBitmapWithFlags(page, 0, pdfium::kHelloWorldChecksum);
+  ASSERT_TRUE(FPDF_GetGlyphCacheStats(&stats));
+  EXPECT_EQ(2 * first_misses, stats.misses);
+
+  FPDF_SetGlyphCacheLimit(old_limit);
+  EXPECT_EQ(old_limit, FPDF_GetGlyphCacheLimit());
+  UnloadPage(page);
+}
+
+TEST_F(FPDFViewEmbedderTest, FormCache) {
+  EXPECT_FALSE(FPDF_SetFormCacheLimit(nullptr, 0));
+  EXPECT_EQ(0u, FPDF_GetFormCacheLimit(nullptr));
+  EXPECT_FALSE(FPDF_GetFormCacheStats(nullptr, nullptr));
+
+  ASSERT_TRUE(OpenDocument("form_object.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+
+  FPDF_DOCUMENT_CACHE_STATS stats;
+  EXPECT_FALSE(FPDF_GetFormCacheStats(document(), nullptr));
+  ASSERT_TRUE(FPDF_GetFormCacheStats(document(), &stats));
+  EXPECT_EQ(0u, stats.hits);
+  EXPECT_EQ(0u, stats.misses);
+  EXPECT_EQ(0u, stats.entries);
+
+  // Without the flag, the cache is not used.
+  ScopedFPDFBitmap bitmap = RenderLoadedPage(page);
+  const std::string normal_hash = HashBitmap(bitmap.get());
+  ASSERT_TRUE(FPDF_GetFormCacheStats(document(), &stats));
+  EXPECT_EQ(0u, stats.misses);
+
+  // The first render caches the form and the second one reuses it.
+  bitmap = RenderLoadedPageWithFlags(page, FPDF_RENDER_CACHE_FORMS);
+  const std::string cached_hash = HashBitmap(bitmap.get());
+  EXPECT_EQ(normal_hash, cached_hash);
+  ASSERT_TRUE(FPDF_GetFormCacheStats(document(), &stats));
+  EXPECT_EQ(0u, stats.hits);
+  EXPECT_EQ(1u, stats.misses);
+  EXPECT_GT(stats.bytes, 0u);
+  EXPECT_EQ(1u, stats.entries);
+
+  bitmap = RenderLoadedPageWithFlags(page, FPDF_RENDER_CACHE_FORMS);
+  EXPECT_EQ(cached_hash, HashBitmap(bitmap.get()));
+  ASSERT_TRUE(FPDF_GetFormCacheStats(document(), &stats));
+  EXPECT_EQ(1u, stats.hits);
+  EXPECT_EQ(1u, stats.misses);
+
+  FPDF_ResetFormCacheStats(document());
+  ASSERT_TRUE(FPDF_GetFormCacheStats(document(), &stats));
+  EXPECT_EQ(0u, stats.hits);
+  EXPECT_EQ(0u, stats.misses);
+  EXPECT_EQ(1u, stats.entries);
+
+  // With no room in the cache, forms are rendered directly.
+  EXPECT_TRUE(FPDF_SetFormCacheLimit(document(), 0));
+  EXPECT_EQ(0u, FPDF_GetFormCacheLimit(document()));
+  ASSERT_TRUE(FPDF_GetFormCacheStats(document(), &stats));
+  EXPECT_EQ(1u, stats.evictions);
+  EXPECT_EQ(0u, stats.bytes);
+  EXPECT_EQ(0u, stats.entries);
+  bitmap = RenderLoadedPageWithFlags(page, FPDF_RENDER_CACHE_FORMS);
+  EXPECT_EQ(normal_hash, HashBitmap(bitmap.get()));
+  ASSERT_TRUE(FPDF_GetFormCacheStats(document(), &stats));
+  EXPECT_EQ(0u, stats.entries);
+
+  // Once an object inside the form changes, a cached bitmap would be stale,
+  // so the form is rendered directly even with room in the cache.
+  EXPECT_TRUE(FPDF_SetFormCacheLimit(document(), 32 * 1024 * 1024));
+  FPDF_ResetFormCacheStats(document());
+  FPDF_PAGEOBJECT form = FPDFPage_GetObject(page, 0);
+  ASSERT_EQ(FPDF_PAGEOBJ_FORM, FPDFPageObj_GetType(form));
+  FPDFPageObj_Transform(FPDFFormObj_GetObject(form, 0), 1, 0, 0, 1, 5, -5);
+  bitmap = RenderLoadedPage(page);
+  const std::string edited_hash = HashBitmap(bitmap.get());
+  EXPECT_NE(normal_hash, edited_hash);
+  bitmap = RenderLoadedPageWithFlags(page, FPDF_RENDER_CACHE_FORMS);
+  EXPECT_EQ(edited_hash, HashBitmap(bitmap.get()));
+  ASSERT_TRUE(FPDF_GetFormCacheStats(document(), &stats));
+  EXPECT_EQ(0u, stats.hits);
+  EXPECT_EQ(0u, stats.misses);
+  EXPECT_EQ(0u, stats.entries);
+
+  UnloadPage(page);
+}
+
+TEST_F(FPDFViewEmbedderTest, ImageCache) {
+  EXPECT_FALSE(FPDF_SetImageCacheLimit(nullptr, 0));
+  EXPECT_EQ(0u, FPDF_GetImageCacheLimit(nullptr));
+  EXPECT_FALSE(FPDF_GetImageCacheStats(nullptr, nullptr));
+
+  ASSERT_TRUE(OpenDocument("embedded_images.pdf"));
+  FPDF_DOCUMENT_CACHE_STATS stats;
+  EXPECT_FALSE(FPDF_GetImageCacheStats(document(), nullptr));
+  ASSERT_TRUE(FPDF_GetImageCacheStats(document(), &stats));
+  EXPECT_EQ(0u, stats.hits);
+  EXPECT_EQ(0u, stats.misses);
+  EXPECT_EQ(0u, stats.entries);
+
+  // The cache is off by default.
+  EXPECT_EQ(0u, FPDF_GetImageCacheLimit(document()));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+  ScopedFPDFBitmap bitmap = RenderLoadedPage(page);
+  const std::string hash = HashBitmap(bitmap.get());
+  UnloadPage(page);
+  ASSERT_TRUE(FPDF_GetImageCacheStats(document(), &stats));
+  EXPECT_EQ(0u, stats.hits);
+  EXPECT_EQ(0u, stats.misses);
+  EXPECT_EQ(0u, stats.entries);
+
+  // Once enabled, the first render decodes the images.
+  EXPECT_TRUE(FPDF_SetImageCacheLimit(document(), 64 * 1024 * 1024));
+  EXPECT_EQ(64u * 1024 * 1024, FPDF_GetImageCacheLimit(document()));
+  page = LoadPage(0);
+  ASSERT_TRUE(page);
+  bitmap = RenderLoadedPage(page);
+  EXPECT_EQ(hash, HashBitmap(bitmap.get()));
+  UnloadPage(page);
+  ASSERT_TRUE(FPDF_GetImageCacheStats(document(), &stats));
+  EXPECT_EQ(0u, stats.hits);
+  EXPECT_GT(stats.misses, 0u);
+  EXPECT_EQ(stats.misses, stats.entries);
+  EXPECT_GT(stats.bytes, 0u);
+  const size_t entries = stats.entries;
+
+  // The decoded images outlive the page.
+  page = LoadPage(0);
+  ASSERT_TRUE(page);
+  bitmap = RenderLoadedPage(page);
+  EXPECT_EQ(hash, HashBitmap(bitmap.get()));
+  UnloadPage(page);
+  ASSERT_TRUE(FPDF_GetImageCacheStats(document(), &stats));
+  EXPECT_EQ(entries, stats.hits);
+  EXPECT_EQ(entries, stats.misses);
+  EXPECT_EQ(entries, stats.entries);
+
+  FPDF_ResetImageCacheStats(document());
+  ASSERT_TRUE(FPDF_GetImageCacheStats(document(), &stats));
+  EXPECT_EQ(0u, stats.hits);
+  EXPECT_EQ(0u, stats.misses);
+  EXPECT_EQ(entries, stats.entries);
+
+  EXPECT_TRUE(FPDF_SetImageCacheLimit(document(), 0));
+  EXPECT_EQ(0u, FPDF_GetImageCacheLimit(document()));
+  ASSERT_TRUE(FPDF_GetImageCacheStats(document(), &stats));
+  EXPECT_EQ(entries, stats.evictions);
+  EXPECT_EQ(0u, stats.bytes);
+  EXPECT_EQ(0u, stats.entries);
+
+  page = LoadPage(0);
+  ASSERT_TRUE(page);
+  bitmap = RenderLoadedPage(page);
+  EXPECT_EQ(hash, HashBitmap(bitmap.get()));
+  UnloadPage(page);
+  ASSERT_TRUE(FPDF_GetImageCacheStats(document(), &stats));
+  EXPECT_EQ(0u, stats.hits);
+  EXPECT_EQ(0u, stats.misses);
+  EXPECT_EQ(0u, stats.entries);
+}
+
 TEST_F(FPDFViewEmbedderTest, FPDF_GetPageSizeByIndexF) {
   ASSERT_TRUE(OpenDocument("rectangles.pdf"));
 
@@ -1870,6 +1870,7 @@ FPDF_RemoveFormFieldHighlight(FPDF_FORMHANDLE hHandle);
 *       call this function after rendering functions, such as
 *       FPDF_RenderPageBitmap() or FPDF_RenderPageBitmap_Start(), have
 *       finished rendering the page contents.
+*       FPDFBitmap_Mono bitmaps are not supported and are left untouched.
 */
 FPDF_EXPORT void FPDF_CALLCONV FPDF_FFLDraw(FPDF_FORMHANDLE hHandle,
                                             FPDF_BITMAP bitmap,
@@ -1893,6 +1894,58 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_FFLRecord(FPDF_FORMHANDLE hHandle,
                                               int flags);
 #endif
 
+/*
+ * Experimental API
+ * Function: FPDF_RenderPageBitmapRects
+ *       Re-render parts of a page, and the FormFields over them, into a
+ *       bitmap that already holds the rest of the page.
+ * Parameters:
+ *       hHandle      -   Handle to the form fill module, as returned by
+ *                        FPDFDOC_InitFormFillEnvironment(). May be NULL to
+ *                        render the page contents only.
+ *       bitmap       -   Handle to the device independent bitmap the page
+ *                        was previously rendered into.
+ *       page         -   Handle to the page, as returned by FPDF_LoadPage().
+ *       start_x      -   Left pixel position of the display area in the
+ *                        device coordinates.
+ *       start_y      -   Top pixel position of the display area in the device
+ *                        coordinates.
+ *       size_x       -   Horizontal size (in pixels) for displaying the page.
+ *       size_y       -   Vertical size (in pixels) for displaying the page.
+ *       rotate       -   Page orientation. See FPDF_RenderPageBitmap().
+ *       flags        -   0 for normal display, or combination of flags
+ *                        defined above.
+ *       rects        -   Array of |rect_count| dirty rectangles in PDF page
+ *                        coordinates, such as those passed to
+ *                        FFI_Invalidate().
+ *       rect_count   -   Number of rectangles in |rects|.
+ *       fill_color   -   Background color the bitmap was filled with before
+ *                        the page was rendered, in 0xAARRGGBB format.
+ * Return Value:
+ *       TRUE on success, FALSE on bad inputs. FPDFBitmap_Mono bitmaps are not
+ *       supported.
+ * Comments:
+ *       The arguments other than |rects|, |rect_count| and |fill_color| must
+ *       be the same as for the FPDF_RenderPageBitmap() and FPDF_FFLDraw()
+ *       calls that rendered |bitmap|. Each rectangle is filled with
+ *       |fill_color| and rendered again, clipped to its device pixels, so the
+ *       result matches rendering the whole page again. Page objects and
+ *       annotations outside all of the rectangles are skipped.
+ */
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_RenderPageBitmapRects(FPDF_FORMHANDLE hHandle,
+                           FPDF_BITMAP bitmap,
+                           FPDF_PAGE page,
+                           int start_x,
+                           int start_y,
+                           int size_x,
+                           int size_y,
+                           int rotate,
+                           int flags,
+                           const FS_RECTF* rects,
+                           size_t rect_count,
+                           FPDF_DWORD fill_color);
+
 /*
  * Experimental API
  * Function: FPDF_GetFormType
@@ -78,7 +78,7 @@ typedef struct _IFSDK_PAUSE {
 //                           allowing the page rendering process.
 // Return value:
 //          Rendering Status. See flags for progressive process status for the
-//          details.
+//          details. FPDFBitmap_Mono bitmaps are not supported and fail.
 FPDF_EXPORT int FPDF_CALLCONV
 FPDF_RenderPageBitmapWithColorScheme_Start(FPDF_BITMAP bitmap,
                                            FPDF_PAGE page,
@@ -117,7 +117,7 @@ FPDF_RenderPageBitmapWithColorScheme_Start(FPDF_BITMAP bitmap,
 //                          allowing the page rendering process
 // Return value:
 //          Rendering Status. See flags for progressive process status for the
-//          details.
+//          details. FPDFBitmap_Mono bitmaps are not supported and fail.
 FPDF_EXPORT int FPDF_CALLCONV FPDF_RenderPageBitmap_Start(FPDF_BITMAP bitmap,
                                                           FPDF_PAGE page,
                                                           int start_x,
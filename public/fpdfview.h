@@ -290,6 +290,63 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_DestroyLibrary();
 FPDF_EXPORT void FPDF_CALLCONV FPDF_SetSandBoxPolicy(FPDF_DWORD policy,
                                                      FPDF_BOOL enable);
 
+// Experimental API.
+// Counters of the process-wide glyph bitmap cache.
+typedef struct FPDF_GLYPH_CACHE_STATS_ {
+  // Glyph bitmap lookups that were served from the cache.
+  unsigned long long hits;
+  // Glyph bitmap lookups that had to render the glyph.
+  unsigned long long misses;
+  // Glyph bitmaps evicted to stay within the cache limit.
+  unsigned long long evictions;
+  // Approximate memory held by cached glyph bitmaps, in bytes.
+  size_t bytes;
+  // Number of cached glyph bitmaps.
+  size_t entries;
+} FPDF_GLYPH_CACHE_STATS;
+
+// Experimental API.
+// Function: FPDF_SetGlyphCacheLimit
+//          Set how much memory the glyph bitmaps cached for all fonts may use.
+// Parameters:
+//          max_bytes -   The limit in bytes. The default is 64 MB.
+// Return value:
+//          None.
+// Comments:
+//          Once the limit is exceeded, the least recently used glyph bitmaps
+//          are evicted before the next text is drawn. Lowering the limit
+//          evicts immediately.
+FPDF_EXPORT void FPDF_CALLCONV FPDF_SetGlyphCacheLimit(size_t max_bytes);
+
+// Experimental API.
+// Function: FPDF_GetGlyphCacheLimit
+//          Get the limit set by FPDF_SetGlyphCacheLimit().
+// Parameters:
+//          None.
+// Return value:
+//          The limit in bytes.
+FPDF_EXPORT size_t FPDF_CALLCONV FPDF_GetGlyphCacheLimit();
+
+// Experimental API.
+// Function: FPDF_GetGlyphCacheStats
+//          Get the counters of the glyph bitmap cache.
+// Parameters:
+//          stats -   Receives the counters.
+// Return value:
+//          True if successful, false if |stats| is NULL.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_GetGlyphCacheStats(FPDF_GLYPH_CACHE_STATS* stats);
+
+// Experimental API.
+// Function: FPDF_ResetGlyphCacheStats
+//          Reset the hits, misses and evictions counters of the glyph bitmap
+//          cache to zero.
+// Parameters:
+//          None.
+// Return value:
+//          None.
+FPDF_EXPORT void FPDF_CALLCONV FPDF_ResetGlyphCacheStats();
+
 #if defined(_WIN32)
 #if defined(PDFIUM_PRINT_TEXT_WITH_GDI)
 // Pointer to a helper function to make |font| with |text| of |text_length|
@@ -796,6 +853,26 @@ FPDF_EXPORT int FPDF_CALLCONV FPDF_GetPageSizeByIndex(FPDF_DOCUMENT document,
 // FPDF_COLORSCHEME is passed in, since with a single fill color for paths the
 // boundaries of adjacent fill paths are less visible.
 #define FPDF_CONVERT_FILL_TO_STROKE 0x20
+// Experimental. Set to compile the page contents into a display list on the
+// first render and replay it on later renders of the same page with the same
+// flags, e.g. at other zoom levels or scroll offsets. The list is rebuilt
+// after page objects are added, removed or changed through the edit APIs,
+// whether or not FPDFPage_GenerateContent() was called since. Progressive
+// renders can pause while replaying it. Ignored when FPDF_COLORSCHEME is
+// passed in.
+#define FPDF_RENDER_DISPLAY_LIST 0x8000
+// Experimental. Set to keep rendered Form XObjects in a cache shared by all
+// pages of the document, so forms repeated on many pages, such as letterheads
+// and logos, are rasterized once per scale. Forms that blend with the content
+// below them or contain optional content are always rendered directly. See
+// FPDF_SetFormCacheLimit().
+#define FPDF_RENDER_CACHE_FORMS 0x10000
+// Experimental. Set to render quick, low fidelity thumbnails. An embedded page
+// thumbnail (/Thumb) is drawn instead of the page when it is at least half the
+// output size and the page is displayed upright. Otherwise, JPEG images are
+// decoded at reduced resolution, text smaller than a few pixels is drawn as
+// bars, and shadings and patterns covering only a few pixels are skipped.
+#define FPDF_RENDER_THUMBNAIL 0x20000
 
 // Struct for color scheme.
 // Each should be a 32-bit value specifying the color, in 8888 ARGB format.
@@ -898,6 +975,124 @@ FPDF_RenderPageBitmapWithMatrix(FPDF_BITMAP bitmap,
                                 const FS_RECTF* clipping,
                                 int flags);
 
+// Experimental API.
+// Counters of a cache shared by the pages of a document.
+typedef struct FPDF_DOCUMENT_CACHE_STATS_ {
+  // Lookups that were served from the cache.
+  unsigned long long hits;
+  // Lookups that had to render or decode the cached item.
+  unsigned long long misses;
+  // Items evicted to stay within the cache limit.
+  unsigned long long evictions;
+  // Approximate memory held by cached items, in bytes.
+  size_t bytes;
+  // Number of cached items.
+  size_t entries;
+} FPDF_DOCUMENT_CACHE_STATS;
+
+// Experimental API.
+// Function: FPDF_SetFormCacheLimit
+//          Set how much memory the forms cached for |document| with the
+//          FPDF_RENDER_CACHE_FORMS flag may use.
+// Parameters:
+//          document    -   Handle to the document.
+//          max_bytes   -   The limit in bytes. The default is 32 MB. A form
+//                          larger than a quarter of the limit is not cached.
+// Return value:
+//          True if successful, false if |document| is NULL.
+// Comments:
+//          Once the limit is exceeded, the least recently used forms are
+//          evicted. Lowering the limit evicts immediately, so 0 releases the
+//          whole cache.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_SetFormCacheLimit(FPDF_DOCUMENT document, size_t max_bytes);
+
+// Experimental API.
+// Function: FPDF_GetFormCacheLimit
+//          Get the limit set by FPDF_SetFormCacheLimit().
+// Parameters:
+//          document    -   Handle to the document.
+// Return value:
+//          The limit in bytes, or 0 if |document| is NULL.
+FPDF_EXPORT size_t FPDF_CALLCONV
+FPDF_GetFormCacheLimit(FPDF_DOCUMENT document);
+
+// Experimental API.
+// Function: FPDF_GetFormCacheStats
+//          Get the counters of the form cache of |document|.
+// Parameters:
+//          document    -   Handle to the document.
+//          stats       -   Receives the counters.
+// Return value:
+//          True if successful, false if either parameter is NULL.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_GetFormCacheStats(FPDF_DOCUMENT document,
+                       FPDF_DOCUMENT_CACHE_STATS* stats);
+
+// Experimental API.
+// Function: FPDF_ResetFormCacheStats
+//          Reset the hits, misses and evictions counters of the form cache of
+//          |document| to zero.
+// Parameters:
+//          document    -   Handle to the document.
+// Return value:
+//          None.
+FPDF_EXPORT void FPDF_CALLCONV
+FPDF_ResetFormCacheStats(FPDF_DOCUMENT document);
+
+// Experimental API.
+// Function: FPDF_SetImageCacheLimit
+//          Set how much memory the decoded images cached for |document| may
+//          use. Unlike the per-page image cache, this cache outlives the
+//          pages, so images shared by several pages are only decoded once.
+// Parameters:
+//          document    -   Handle to the document.
+//          max_bytes   -   The limit in bytes. The default is 0, which
+//                          turns the cache off.
+// Return value:
+//          True if successful, false if |document| is NULL.
+// Comments:
+//          Once the limit is exceeded, the least recently used images are
+//          evicted. Lowering the limit evicts immediately, so 0 releases the
+//          whole cache. Each document has its own cache, so embedders that
+//          keep several documents open should split their budget between
+//          them.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_SetImageCacheLimit(FPDF_DOCUMENT document, size_t max_bytes);
+
+// Experimental API.
+// Function: FPDF_GetImageCacheLimit
+//          Get the limit set by FPDF_SetImageCacheLimit().
+// Parameters:
+//          document    -   Handle to the document.
+// Return value:
+//          The limit in bytes, or 0 if |document| is NULL.
+FPDF_EXPORT size_t FPDF_CALLCONV
+FPDF_GetImageCacheLimit(FPDF_DOCUMENT document);
+
+// Experimental API.
+// Function: FPDF_GetImageCacheStats
+//          Get the counters of the image cache of |document|.
+// Parameters:
+//          document    -   Handle to the document.
+//          stats       -   Receives the counters.
+// Return value:
+//          True if successful, false if either parameter is NULL.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_GetImageCacheStats(FPDF_DOCUMENT document,
+                        FPDF_DOCUMENT_CACHE_STATS* stats);
+
+// Experimental API.
+// Function: FPDF_ResetImageCacheStats
+//          Reset the hits, misses and evictions counters of the image cache
+//          of |document| to zero.
+// Parameters:
+//          document    -   Handle to the document.
+// Return value:
+//          None.
+FPDF_EXPORT void FPDF_CALLCONV
+FPDF_ResetImageCacheStats(FPDF_DOCUMENT document);
+
 #if defined(_SKIA_SUPPORT_)
 FPDF_EXPORT FPDF_RECORDER FPDF_CALLCONV FPDF_RenderPageSkp(FPDF_PAGE page,
                                                            int size_x,
@@ -1054,6 +1249,16 @@ FPDF_EXPORT FPDF_BITMAP FPDF_CALLCONV FPDFBitmap_Create(int width,
 #define FPDFBitmap_BGRx 3
 // 4 bytes per pixel, byte order: blue, green, red, alpha.
 #define FPDFBitmap_BGRA 4
+// 4 bytes per pixel, byte order: blue, green, red, alpha, with the colors
+// premultiplied by alpha. Rendering with FPDF_REVERSE_BYTE_ORDER makes the
+// byte order red, green, blue, alpha.
+#define FPDFBitmap_BGRA_Premul 5
+// 1 bit per pixel, most significant bit first. 0 is black and 1 is white.
+// Pages are rendered in gray and thresholded at 50%. Only
+// FPDF_RenderPageBitmap(), FPDF_RenderPageBitmapWithMatrix() and
+// FPDFBitmap_FillRect() support it; progressive rendering and FPDF_FFLDraw()
+// do not.
+#define FPDFBitmap_Mono 6
 
 // Function: FPDFBitmap_CreateEx
 //          Create a device independent bitmap (FXDIB)
@@ -1080,6 +1285,11 @@ FPDF_EXPORT FPDF_BITMAP FPDF_CALLCONV FPDFBitmap_Create(int width,
 //          If an external buffer is used, then the application should destroy
 //          the buffer by itself. FPDFBitmap_Destroy function will not destroy
 //          the buffer.
+//
+//          Rendering into a FPDFBitmap_BGRA_Premul bitmap converts the
+//          rendered area to straight alpha and back. While a progressive render
+//          is in progress, that area is not premultiplied. It is again once
+//          FPDF_RenderPage_Close() is called.
 FPDF_EXPORT FPDF_BITMAP FPDF_CALLCONV FPDFBitmap_CreateEx(int width,
                                                           int height,
                                                           int format,